@@ -187,7 +187,7 @@ void MultihopD2D::sendPacket()
     EV << "MultihopD2D::sendPacket - Sending msg (ID: "<< mhop->getMsgid() << " src: " << lteNodeId_ << " size: " << msgSize_ << ")" <<  endl;
     socket.sendTo(packet, destAddress_, destPort_);
 
-    std::set<MacNodeId> targetSet;
+    UeSet targetSet;
     eventGen_->computeTargetNodeSet(targetSet, lteNodeId_, maxBroadcastRadius_);
     stat_->recordNewBroadcast(msgId,targetSet);
     stat_->recordReception(lteNodeId_,msgId, 0.0, 0);
@@ -370,30 +370,55 @@ void MultihopD2D::relayPacket(cMessage* msg)
 
 void MultihopD2D::markAsReceived(uint32_t msgId)
 {
-    std::pair<uint32_t,bool> p(msgId,false);
-    relayedMsgMap_.insert(p);
+    uint16_t eventId = msgId & 0xFFFF;
+    uint16_t sender = msgId >> 16;
+    if (!receivedMsgs_.test(eventId))
+    {
+        receivedMsgs_.set(eventId);
+        if (eventId >= msgSender_.size())
+            msgSender_.resize(eventId + 1);
+        msgSender_[eventId] = sender;
+    }
+    else if (msgSender_[eventId] != sender)
+    {
+        std::pair<uint32_t,bool> p(msgId,false);
+        relayedMsgMap_.insert(p);
+    }
 }
 
 bool MultihopD2D::isAlreadyReceived(uint32_t msgId)
 {
-    if (relayedMsgMap_.find(msgId) == relayedMsgMap_.end())
+    uint16_t eventId = msgId & 0xFFFF;
+    if (!receivedMsgs_.test(eventId))
         return false;
-    return true;
+    if (msgSender_[eventId] == (msgId >> 16))
+        return true;
+    return relayedMsgMap_.find(msgId) != relayedMsgMap_.end();
 }
 
 void MultihopD2D::markAsRelayed(uint32_t msgId)
 {
-    relayedMsgMap_[msgId] = true;
+    markAsReceived(msgId);
+
+    uint16_t eventId = msgId & 0xFFFF;
+    if (msgSender_[eventId] == (msgId >> 16))
+        relayedMsgs_.set(eventId);
+    else
+        relayedMsgMap_[msgId] = true;
 }
 
 bool MultihopD2D::isAlreadyRelayed(uint32_t msgId)
 {
-    if (relayedMsgMap_.find(msgId) == relayedMsgMap_.end()) // the message has not been received
-        return false;
-    if (!relayedMsgMap_[msgId])    // the message has been received but not relayed yet
+    uint16_t eventId = msgId & 0xFFFF;
+    if (!receivedMsgs_.test(eventId)) // the message has not been received
         return false;
+    if (msgSender_[eventId] == (msgId >> 16))
+        return relayedMsgs_.test(eventId);
 
-    return true;
+    std::map<uint32_t,bool>::iterator it = relayedMsgMap_.find(msgId);
+    if (it == relayedMsgMap_.end())    // the message has not been received
+        return false;
+    return it->second;    // false if the message has been received but not relayed yet
 }
 
 bool MultihopD2D::isWithinBroadcastArea(Coord srcCoord, double maxRadius)
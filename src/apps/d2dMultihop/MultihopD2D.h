@@ -15,6 +15,7 @@
 #include <inet/transportlayer/contract/udp/UdpSocket.h>
 #include <inet/networklayer/common/L3AddressResolver.h>
 #include "common/LteCommon.h"
+#include "common/Bitset.h"
 #include "apps/d2dMultihop/MultihopD2DPacket_m.h"
 #include "apps/d2dMultihop/statistics/MultihopD2DStatistics.h"
 #include "apps/d2dMultihop/eventGenerator/EventGenerator.h"
@@ -47,6 +48,13 @@ protected:
     std::map<unsigned int, unsigned int> counter_;
     /***************************************************/
 
+    // reception state of the messages. The message id is (senderAppId << 16 | eventId) and
+    // there is normally one message per event, so the state is indexed by event id: the
+    // bitsets store whether the message of the event has been received/relayed and msgSender_
+    // its sender. Further messages of the same event (from a second originator) go in relayedMsgMap_
+    Bitset receivedMsgs_;
+    Bitset relayedMsgs_;
+    std::vector<uint16_t> msgSender_;
     std::map<uint32_t,bool> relayedMsgMap_;  // indicates if a received message has been relayed before
 
     int localPort_;
@@ -7,6 +7,7 @@
 // and cannot be removed from it.
 //
 
+#include <cmath>
 #include "apps/d2dMultihop/eventGenerator/EventGenerator.h"
 #include "common/LteCommon.h"
 #include "stack/phy/layer/LtePhyBase.h"
@@ -19,6 +20,7 @@ EventGenerator::EventGenerator()
 {
     selfMessage_ = nullptr;
     eventId_ = 0;
+    gridValid_ = false;
 }
 
 EventGenerator::~EventGenerator()
@@ -33,6 +35,10 @@ void EventGenerator::initialize()
     selfMessage_ = new cMessage("selfMessage");
     binder_ = getBinder();
     singleEventSource_ = par("singleEventSource").boolValue();
+    gridCellSize_ = par("gridCellSize").doubleValue();
+    if (gridCellSize_ <= 0)
+        throw cRuntimeError("EventGenerator::initialize - gridCellSize must be positive");
+    positionUpdateInterval_ = par("positionUpdateInterval");
 
     simtime_t startTime = par("startTime");
     if (startTime >= 0)
@@ -66,27 +72,17 @@ void EventGenerator::notifyEvent()
     {
         // select a second originator, close to the first one
 
-        LtePhyBase* uePhy = lteNodePhy_[r+UE_MIN_ID];
-        inet::Coord uePos = uePhy->getCoord();
-
-        // get references to all UEs in the cell
-        // they are useful later to retrieve UE positions
+        updateGrid();
+        inet::Coord uePos = uePos_[r];
 
         // find all UEs within a 20m-radius
+        neighbors_.clear();
+        collectUesInRange(uePos, 20.0, neighbors_);
+        neighbors_.reset(r);
+
         std::vector<MacNodeId> tmp;
-        std::set<MacNodeId>::iterator it = lteNodeIdSet_.begin();
-        for (; it != lteNodeIdSet_.end(); ++it)
-        {
-            MacNodeId nodeId = *it;
-            if (r + UE_MIN_ID != nodeId)
-            {
-                LtePhyBase* phy = lteNodePhy_[nodeId];
-                inet::Coord pos = phy->getCoord();
-                double d = uePos.distance(pos);
-                if (d < 20.0)
-                    tmp.push_back(nodeId);
-            }
-        }
+        for (int i = neighbors_.next(0); i >= 0; i = neighbors_.next(i + 1))
+            tmp.push_back(i + UE_MIN_ID);
 
         // select one neighbor randomly
         if (!tmp.empty())
@@ -105,7 +101,52 @@ void EventGenerator::notifyEvent()
     eventId_++;
 }
 
-void EventGenerator::computeTargetNodeSet(std::set<MacNodeId>& targetSet, MacNodeId sourceId, double maxBroadcastRadius)
+void EventGenerator::updateGrid()
+{
+    if (gridValid_ && (simTime() == lastGridUpdate_ || simTime() < lastGridUpdate_ + positionUpdateInterval_))
+        return;
+
+    UeGrid::iterator git = ueGrid_.begin();
+    for (; git != ueGrid_.end(); ++git)
+        git->second.clear();
+
+    uePos_.resize(lteNodePhy_.size());
+    for (int i = lteNodeIdSet_.next(0); i >= 0; i = lteNodeIdSet_.next(i + 1))
+    {
+        uePos_[i] = lteNodePhy_[i]->getCoord();
+        std::pair<int, int> cell((int)floor(uePos_[i].x / gridCellSize_), (int)floor(uePos_[i].y / gridCellSize_));
+        ueGrid_[cell].push_back(i);
+    }
+
+    lastGridUpdate_ = simTime();
+    gridValid_ = true;
+}
+
+void EventGenerator::collectUesInRange(const inet::Coord& center, double radius, Bitset& ueSet)
+{
+    int minX = (int)floor((center.x - radius) / gridCellSize_);
+    int maxX = (int)floor((center.x + radius) / gridCellSize_);
+    int minY = (int)floor((center.y - radius) / gridCellSize_);
+    int maxY = (int)floor((center.y + radius) / gridCellSize_);
+    for (int x = minX; x <= maxX; x++)
+    {
+        for (int y = minY; y <= maxY; y++)
+        {
+            UeGrid::iterator git = ueGrid_.find(std::make_pair(x, y));
+            if (git == ueGrid_.end())
+                continue;
+
+            std::vector<unsigned int>::iterator it = git->second.begin();
+            for (; it != git->second.end(); ++it)
+            {
+                if (uePos_[*it].distance(center) < radius)
+                    ueSet.set(*it);
+            }
+        }
+    }
+}
+
+void EventGenerator::computeTargetNodeSet(Bitset& targetSet, MacNodeId sourceId, double maxBroadcastRadius)
 {
     if (maxBroadcastRadius < 0.0)
     {
@@ -115,39 +156,25 @@ void EventGenerator::computeTargetNodeSet(std::set<MacNodeId>& targetSet, MacNod
     else
     {
         // send the message to all UEs within the area defined by the maxBroadcastRadius parameter
-
-        // get references to all UEs in the cell
-        // they are useful later to retrieve UE positions
-        std::map<MacNodeId, inet::Coord> uePos;
-        std::set<MacNodeId>::iterator it = lteNodeIdSet_.begin();
-        for (; it != lteNodeIdSet_.end(); ++it)
-        {
-            MacNodeId nodeId = *it;
-            LtePhyBase* uePhy = lteNodePhy_[nodeId];
-            uePos[nodeId] = uePhy->getCoord();
-        }
+        updateGrid();
 
         // get the coordinates of the source node
-        inet::Coord srcCoord = uePos[sourceId];
+        unsigned int srcIndex = sourceId - UE_MIN_ID;
+        inet::Coord srcCoord = (srcIndex < uePos_.size()) ? uePos_[srcIndex] : inet::Coord();
 
-        // compute the distance for each UE
-        std::map<MacNodeId, inet::Coord>::iterator mit = uePos.begin();
-        for (; mit != uePos.end(); ++mit)
-        {
-            if (mit->second.distance(srcCoord) < maxBroadcastRadius)
-            {
-                EV << " - " << mit->first << endl;
-                targetSet.insert(mit->first);
-            }
-        }
+        collectUesInRange(srcCoord, maxBroadcastRadius, targetSet);
     }
 }
 
 void EventGenerator::registerNode(MultihopD2D* app, MacNodeId lteNodeId)
 {
+    unsigned int ueIndex = lteNodeId - UE_MIN_ID;
     appVector_.push_back(app);
-    lteNodeIdSet_.insert(lteNodeId);
-    lteNodePhy_[lteNodeId] = check_and_cast<LtePhyBase*>((getSimulation()->getModule(binder_->getOmnetId(lteNodeId)))->getSubmodule("lteNic")->getSubmodule("phy") );
+    lteNodeIdSet_.set(ueIndex);
+    if (ueIndex >= lteNodePhy_.size())
+        lteNodePhy_.resize(ueIndex + 1, nullptr);
+    lteNodePhy_[ueIndex] = check_and_cast<LtePhyBase*>((getSimulation()->getModule(binder_->getOmnetId(lteNodeId)))->getSubmodule("lteNic")->getSubmodule("phy") );
+    gridValid_ = false;
 }
 
 void EventGenerator::unregisterNode(MultihopD2D* app, MacNodeId lteNodeId)
@@ -162,7 +189,6 @@ void EventGenerator::unregisterNode(MultihopD2D* app, MacNodeId lteNodeId)
         }
     }
 
-    std::set<MacNodeId>::iterator sit = lteNodeIdSet_.find(lteNodeId);
-    if (sit != lteNodeIdSet_.end())
-        lteNodeIdSet_.erase(sit);
+    lteNodeIdSet_.reset(lteNodeId - UE_MIN_ID);
+    gridValid_ = false;
 }
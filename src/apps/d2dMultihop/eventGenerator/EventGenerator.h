@@ -13,6 +13,7 @@
 #include <string.h>
 #include <omnetpp.h>
 #include "common/LteCommon.h"
+#include "common/Bitset.h"
 #include "apps/d2dMultihop/MultihopD2D.h"
 #include "corenetwork/binder/LteBinder.h"
 #include "stack/phy/layer/LtePhyBase.h"
@@ -31,12 +32,32 @@ class SIMULTE_API EventGenerator : public omnetpp::cSimpleModule
     // store references to the app modules
     std::vector<MultihopD2D*> appVector_;
 
-    // store LTE IDs of the nodes
-    std::set<MacNodeId> lteNodeIdSet_;
+    // store LTE IDs of the nodes (as UE indices, i.e. MacNodeId - UE_MIN_ID)
+    Bitset lteNodeIdSet_;
 
-    // store references to the PHY modules
+    // store references to the PHY modules, indexed by UE index
     // (to speed up position retrieval)
-    std::map<MacNodeId, LtePhyBase*> lteNodePhy_;
+    std::vector<LtePhyBase*> lteNodePhy_;
+
+    /*
+     * Spatial index of UE positions
+     */
+    typedef std::map<std::pair<int, int>, std::vector<unsigned int> > UeGrid;
+    // UE indices per grid cell
+    UeGrid ueGrid_;
+    // positions of the UEs at the last refresh, indexed by UE index
+    std::vector<inet::Coord> uePos_;
+    double gridCellSize_;
+    omnetpp::simtime_t positionUpdateInterval_;
+    omnetpp::simtime_t lastGridUpdate_;
+    bool gridValid_;
+    // UEs close to the first originator (reused buffer)
+    Bitset neighbors_;
+
+    // refresh the grid, if positions are older than positionUpdateInterval_
+    void updateGrid();
+    // insert into ueSet the UEs whose distance from center is lower than radius
+    void collectUesInRange(const inet::Coord& center, double radius, Bitset& ueSet);
 
     // notify a node to start an event dissemination
     void notifyEvent();
@@ -50,7 +71,8 @@ protected:
     EventGenerator();
     ~EventGenerator();
 
-    void computeTargetNodeSet(std::set<MacNodeId>& targetSet, MacNodeId sourceId, double maxBroadcastRadius = -1.0);
+    // targetSet is filled with the UE indices (MacNodeId - UE_MIN_ID) of the target nodes
+    void computeTargetNodeSet(Bitset& targetSet, MacNodeId sourceId, double maxBroadcastRadius = -1.0);
     void registerNode(MultihopD2D* app, MacNodeId lteNodeId);
     void unregisterNode(MultihopD2D* app, MacNodeId lteNodeId);
 };
@@ -28,39 +28,20 @@ void MultihopD2DStatistics::initialize()
 }
 
 
-void MultihopD2DStatistics::recordNewBroadcast(unsigned int msgId, UeSet& destinations)
+void MultihopD2DStatistics::recordNewBroadcast(unsigned int msgId, const UeSet& destinations)
 {
     // consider the least-significant 16 bits
     unsigned short eventId = (unsigned short)msgId;
-    if (eventDeliveryInfo_.find(eventId) == eventDeliveryInfo_.end())
+
+    // initialize (or extend) the record for this message
+    DeliveryStatus& entry = eventDeliveryInfo_[eventId];
+    entry.targets_ |= destinations;
+    if (entry.status_.size() < entry.targets_.capacity())
     {
-        // initialize record for this message
-        DeliveryStatus tmp;
-        UeSet::iterator it = destinations.begin();
-        for (; it != destinations.end(); ++it) {
-            ReceptionStatus status;
-            status.delay_ = -1.0;
-            status.hops_ = -1;
-            tmp.insert(std::pair<MacNodeId, ReceptionStatus>(*it,status));
-        }
-        std::pair<unsigned short, DeliveryStatus> p(eventId, tmp);
-        eventDeliveryInfo_.insert(p);
-    }
-    else
-    {
-        DeliveryStatus entry = eventDeliveryInfo_.at(eventId);
-        UeSet::iterator it = destinations.begin();
-        for (; it != destinations.end(); ++it)
-        {
-            if (eventDeliveryInfo_[eventId].find(*it) == eventDeliveryInfo_[eventId].end())
-            {
-                // the UE is not in the map
-                ReceptionStatus status;
-                status.delay_ = -1.0;
-                status.hops_ = -1;
-                eventDeliveryInfo_[eventId].insert(std::pair<MacNodeId, ReceptionStatus>(*it,status));
-            }
-        }
+        ReceptionStatus status;
+        status.delay_ = -1.0;
+        status.hops_ = -1;
+        entry.status_.resize(entry.targets_.capacity(), status);
     }
 
     if (eventTransmissionInfo_.find(eventId) == eventTransmissionInfo_.end())
@@ -80,14 +61,18 @@ void MultihopD2DStatistics::recordReception(MacNodeId nodeId, unsigned int msgId
     // consider the least-significant 16 bits
     unsigned short eventId = (unsigned short)msgId;
 
-    if (eventDeliveryInfo_.find(eventId) == eventDeliveryInfo_.end())
+    std::map<unsigned short, DeliveryStatus>::iterator it = eventDeliveryInfo_.find(eventId);
+    if (it == eventDeliveryInfo_.end())
             throw cRuntimeError("d2dMultihopStatistics::recordReception - Event with ID %d does not exist.", eventId);
-    if (eventDeliveryInfo_[eventId].find(nodeId) != eventDeliveryInfo_[eventId].end())
+
+    unsigned int ueIndex = nodeId - UE_MIN_ID;
+    if (it->second.targets_.test(ueIndex))
     {
-        if (eventDeliveryInfo_[eventId][nodeId].delay_ < 0)   // store only the minimum
+        ReceptionStatus& status = it->second.status_[ueIndex];
+        if (status.delay_ < 0)   // store only the minimum
         {
-            eventDeliveryInfo_[eventId][nodeId].delay_ = delay;
-            eventDeliveryInfo_[eventId][nodeId].hops_ = hops;
+            status.delay_ = delay;
+            status.hops_ = hops;
         }
     }
 }
@@ -130,19 +115,20 @@ void MultihopD2DStatistics::finish()
 
         unsigned int deliveredMsgCounter = 0;
         simtime_t maxDelay = 0.0;
-        DeliveryStatus::iterator jt = eit->second.begin();
-        for (; jt != eit->second.end(); ++jt)
+        const UeSet& targets = eit->second.targets_;
+        for (int i = targets.next(0); i >= 0; i = targets.next(i + 1))
         {
             // for each message, insert all delays in this vector
-            if (jt->second.hops_ >= 0)
+            const ReceptionStatus& status = eit->second.status_[i];
+            if (status.hops_ >= 0)
             {
-                if (jt->second.hops_ >= 1)
+                if (status.hops_ >= 1)
                 {
-                    sortedDelays.push_back(jt->second.delay_);
-                    emit(d2dMultihopEventDelay_, jt->second.delay_);
+                    sortedDelays.push_back(status.delay_);
+                    emit(d2dMultihopEventDelay_, status.delay_);
 
-                    if (jt->second.delay_ > maxDelay)
-                        maxDelay = jt->second.delay_;
+                    if (status.delay_ > maxDelay)
+                        maxDelay = status.delay_;
                 }
                 deliveredMsgCounter++;
             }
@@ -151,7 +137,7 @@ void MultihopD2DStatistics::finish()
         if (sortedDelays.empty())
             continue;
 
-        double deliveryRatio = (double)deliveredMsgCounter / eit->second.size();
+        double deliveryRatio = (double)deliveredMsgCounter / targets.count();
         emit(d2dMultihopEventDeliveryRatio_, deliveryRatio);
 
         // sort the delays and get the percentile you desire
@@ -11,9 +11,11 @@
 #define MULTIHOPD2DSTATISTICS_H_
 
 #include "common/LteCommon.h"
+#include "common/Bitset.h"
 #include "corenetwork/binder/LteBinder.h"
 
-typedef std::set<MacNodeId> UeSet;
+// set of UEs, the element of a UE is its index (MacNodeId - UE_MIN_ID)
+typedef Bitset UeSet;
 
 //
 // MultihopD2DStatistics module
@@ -42,7 +44,13 @@ class SIMULTE_API MultihopD2DStatistics : public omnetpp::cSimpleModule
         omnetpp::simtime_t delay_;
         int hops_;
     } ReceptionStatus;
-    typedef std::map<MacNodeId, ReceptionStatus> DeliveryStatus;
+    struct DeliveryStatus
+    {
+        // UEs within the target area
+        UeSet targets_;
+        // reception status, indexed by UE index (meaningful for targets only)
+        std::vector<ReceptionStatus> status_;
+    };
 
     // for each event, store the current delivery status
     std::map<unsigned short, DeliveryStatus> eventDeliveryInfo_;
@@ -72,7 +80,7 @@ protected:
     virtual void finish();
 
 public:
-    void recordNewBroadcast(unsigned int msgId, UeSet& destinations);
+    void recordNewBroadcast(unsigned int msgId, const UeSet& destinations);
     void recordReception(MacNodeId nodeId, unsigned int msgId, omnetpp::simtime_t delay, int hops);
     void recordSentMessage(unsigned int msgId);
     void recordSuppressedMessage(unsigned int msgId);
@@ -0,0 +1,91 @@
+//
+//                           SimuLTE
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". This license can be also found at http://www.ltesimulator.com/
+// The above file and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#ifndef _LTE_BITSET_H_
+#define _LTE_BITSET_H_
+
+#include <vector>
+#include <stdint.h>
+
+//! Growable set of small non-negative integers, one bit per element.
+class Bitset
+{
+    //! Bits, 64 per word.
+    std::vector<uint64_t> words_;
+
+  public:
+    //! Insert i, growing the set if needed.
+    void set(unsigned int i)
+    {
+        unsigned int w = i >> 6;
+        if (w >= words_.size())
+            words_.resize(w + 1, 0);
+        words_[w] |= (uint64_t)1 << (i & 63);
+    }
+    //! Remove i.
+    void reset(unsigned int i)
+    {
+        unsigned int w = i >> 6;
+        if (w < words_.size())
+            words_[w] &= ~((uint64_t)1 << (i & 63));
+    }
+    //! True if i is in the set.
+    bool test(unsigned int i) const
+    {
+        unsigned int w = i >> 6;
+        return w < words_.size() && (words_[w] >> (i & 63)) & 1;
+    }
+    //! Remove all the elements, keeping the allocated words.
+    void clear()
+    {
+        for (unsigned int w = 0; w < words_.size(); w++)
+            words_[w] = 0;
+    }
+    //! Insert all the elements of another set.
+    Bitset& operator|=(const Bitset& other)
+    {
+        if (other.words_.size() > words_.size())
+            words_.resize(other.words_.size(), 0);
+        for (unsigned int w = 0; w < other.words_.size(); w++)
+            words_[w] |= other.words_[w];
+        return *this;
+    }
+    //! Number of elements.
+    unsigned int count() const
+    {
+        unsigned int n = 0;
+        for (unsigned int w = 0; w < words_.size(); w++)
+            n += __builtin_popcountll(words_[w]);
+        return n;
+    }
+    //! Upper bound (exclusive) of the elements that can be stored without growing.
+    unsigned int capacity() const
+    {
+        return words_.size() * 64;
+    }
+    //! Smallest element not lower than i, -1 if there is none.
+    //! Elements are visited in ascending order with
+    //!   for (int i = s.next(0); i >= 0; i = s.next(i + 1))
+    int next(unsigned int i) const
+    {
+        unsigned int w = i >> 6;
+        if (w >= words_.size())
+            return -1;
+        uint64_t bits = words_[w] & (~(uint64_t)0 << (i & 63));
+        while (bits == 0)
+        {
+            if (++w == words_.size())
+                return -1;
+            bits = words_[w];
+        }
+        return (w << 6) + __builtin_ctzll(bits);
+    }
+};
+
+#endif
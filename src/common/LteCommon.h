@@ -33,6 +33,7 @@
 #include "inet/common/packet/Packet.h"
 #include "inet/common/Protocol.h"
 #include "common/features.h"
+#include "common/LteTrace.h"
 #include "common/LteCommonEnum_m.h"
 
 #if defined(SIMULTE_EXPORT)
@@ -0,0 +1,152 @@
+//
+//                           SimuLTE
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". This license can be also found at http://www.ltesimulator.com/
+// The above file and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#include "common/LteProfiler.h"
+
+#ifdef LTE_PROFILING
+
+#include <cstring>
+#include <map>
+#include <string>
+#include <unordered_map>
+
+using namespace omnetpp;
+
+uint64_t LteProfiler::allocs = 0;
+uint64_t LteProfiler::allocBytes = 0;
+LteProfileScope* LteProfiler::current = nullptr;
+
+namespace {
+
+struct StatsKeyHash
+{
+    size_t operator()(const std::pair<const char*, const char*>& key) const
+    {
+        return std::hash<const char*>()(key.first) * 31 + std::hash<const char*>()(key.second);
+    }
+};
+
+// statistics by (type name, section) pointers; the same type and section may
+// have more entries (e.g. section literals of different translation units),
+// they are merged when recorded
+typedef std::unordered_map<std::pair<const char*, const char*>, LteProfileStats*, StatsKeyHash> StatsMap;
+
+StatsMap& statsMap()
+{
+    static StatsMap map;
+    return map;
+}
+
+} // namespace
+
+LteProfileStats* LteProfiler::getStats(const char* type, const char* section)
+{
+    StatsMap& map = statsMap();
+    std::pair<const char*, const char*> key(type, section);
+    StatsMap::iterator it = map.find(key);
+    if (it != map.end())
+        return it->second;
+    LteProfileStats* stats = new LteProfileStats();
+    map[key] = stats;
+    return stats;
+}
+
+bool LteProfiler::countsAllocs()
+{
+    // the operator new of this library is not the one called by the process
+    // if the library was loaded at run time; call it directly, as new
+    // expressions may be elided
+    static const bool counting = []() {
+        uint64_t before = LteProfiler::allocs;
+        void* p = ::operator new(1);
+        ::operator delete(p);
+        return LteProfiler::allocs != before;
+    }();
+    return counting;
+}
+
+void LteProfiler::recordScalars(cComponent* component)
+{
+    // merge the entries with the same names, sorted for a stable output
+    std::map<std::string, LteProfileStats> merged;
+    StatsMap& map = statsMap();
+    for (StatsMap::iterator it = map.begin(); it != map.end(); ++it)
+    {
+        LteProfileStats& total = merged[std::string(it->first.first) + "." + it->first.second];
+        total.calls += it->second->calls;
+        total.time += it->second->time;
+        total.selfTime += it->second->selfTime;
+        total.allocs += it->second->allocs;
+        total.allocBytes += it->second->allocBytes;
+    }
+
+    bool allocs = countsAllocs();
+    if (!allocs)
+        EV_WARN << "LteProfiler: allocations are not counted (the replaced operator new is in effect only when linked into the executable), allocs and allocBytes are not recorded" << endl;
+
+    for (std::map<std::string, LteProfileStats>::iterator it = merged.begin(); it != merged.end(); ++it)
+    {
+        std::string name = "profile." + it->first;
+        component->recordScalar((name + ".calls").c_str(), it->second.calls);
+        component->recordScalar((name + ".time").c_str(), it->second.time * 1e-9, "s");
+        component->recordScalar((name + ".selfTime").c_str(), it->second.selfTime * 1e-9, "s");
+        if (allocs)
+        {
+            component->recordScalar((name + ".allocs").c_str(), it->second.allocs);
+            component->recordScalar((name + ".allocBytes").c_str(), it->second.allocBytes, "B");
+        }
+    }
+    reset();
+}
+
+void LteProfiler::reset()
+{
+    // scopes hold pointers to the statistics: only clear them
+    StatsMap& map = statsMap();
+    for (StatsMap::iterator it = map.begin(); it != map.end(); ++it)
+        *it->second = LteProfileStats();
+}
+
+LteProfileScope::LteProfileScope(const cComponent* component, const char* section) :
+    component_(component), section_(section), stats_(nullptr), parent_(LteProfiler::current)
+{
+    // ignore a scope nested in one of the same component and section (only
+    // measured scopes are linked in the chain)
+    for (LteProfileScope* s = parent_; s != nullptr; s = s->parent_)
+    {
+        if (s->component_ == component && strcmp(s->section_, section) == 0)
+            return;
+    }
+
+    stats_ = LteProfiler::getStats(component->getComponentType()->getName(), section);
+    LteProfiler::current = this;
+    childTime_ = 0;
+    allocs_ = LteProfiler::allocs;
+    allocBytes_ = LteProfiler::allocBytes;
+    start_ = std::chrono::steady_clock::now();
+}
+
+LteProfileScope::~LteProfileScope()
+{
+    if (stats_ == nullptr)
+        return;
+
+    int64_t elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_).count();
+    stats_->calls++;
+    stats_->time += elapsed;
+    stats_->selfTime += elapsed - childTime_;
+    stats_->allocs += LteProfiler::allocs - allocs_;
+    stats_->allocBytes += LteProfiler::allocBytes - allocBytes_;
+
+    LteProfiler::current = parent_;
+    if (parent_ != nullptr)
+        parent_->childTime_ += elapsed;
+}
+
+#endif
@@ -0,0 +1,117 @@
+//
+//                           SimuLTE
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". This license can be also found at http://www.ltesimulator.com/
+// The above file and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+//
+//  Description:
+//  Built-in profiler of the LTE modules, compiled in only with LTE_PROFILING.
+//
+//  LTE_PROFILE_SCOPE(component, "section") measures the wall-clock time and
+//  the heap allocations (all the operator new calls of the process) from the
+//  statement to the end of the enclosing block. Samples are aggregated per
+//  module type (the NED type of the component) and section, and recorded by
+//  the binder at finish as scalars named
+//    profile.<type>.<section>.{calls,time,selfTime,allocs,allocBytes}
+//  time and allocations are inclusive of nested scopes, selfTime is not. A
+//  scope nested in a scope of the same component and section (e.g. an
+//  overridden handleMessage() calling the one of the base class) is ignored.
+//
+//  Allocations are counted by replacing the global operator new
+//  (LteProfilerAlloc.cc), which takes effect only when it is linked into the
+//  executable, i.e. when the model is built as an executable rather than as
+//  the shared library loaded by opp_run -l (the default build): symbol lookup
+//  then finds the operator new of libstdc++ first. When the replacement is
+//  not in effect, allocs and allocBytes are not recorded and a warning is
+//  logged at finish.
+//
+//  Without LTE_PROFILING the macros expand to nothing. From the command line:
+//    make MODE=release LTE_PROFILING=1
+//
+
+#ifndef _LTE_LTEPROFILER_H_
+#define _LTE_LTEPROFILER_H_
+
+#include <omnetpp.h>
+
+#ifdef LTE_PROFILING
+
+#include <chrono>
+#include <stdint.h>
+#include "common/LteCommon.h"
+
+/**
+ * Aggregated samples of a (module type, section) pair
+ */
+struct LteProfileStats
+{
+    uint64_t calls;
+    int64_t time;       // ns
+    int64_t selfTime;   // ns
+    uint64_t allocs;
+    uint64_t allocBytes;
+
+    LteProfileStats() : calls(0), time(0), selfTime(0), allocs(0), allocBytes(0) {}
+};
+
+class LteProfileScope;
+
+/**
+ * Registry of the profiling samples of the current run
+ */
+class SIMULTE_API LteProfiler
+{
+  public:
+    //! Heap allocations of the process so far, updated by the replaced operator new
+    static uint64_t allocs;
+    static uint64_t allocBytes;
+    //! Innermost active scope
+    static LteProfileScope* current;
+
+    //! Return the statistics of a (module type, section) pair, creating them if needed
+    static LteProfileStats* getStats(const char* type, const char* section);
+    //! Record all the statistics as scalars of the given module, and clear them
+    static void recordScalars(omnetpp::cComponent* component);
+    //! Clear all the statistics
+    static void reset();
+    //! Return true if the replaced operator new is in effect, i.e. allocations are counted
+    static bool countsAllocs();
+};
+
+/**
+ * Measures the enclosing block, see LTE_PROFILE_SCOPE
+ */
+class LteProfileScope
+{
+  private:
+    const omnetpp::cComponent* component_;
+    const char* section_;
+    LteProfileStats* stats_;
+    LteProfileScope* parent_;
+    std::chrono::steady_clock::time_point start_;
+    int64_t childTime_;
+    uint64_t allocs_;
+    uint64_t allocBytes_;
+
+  public:
+    LteProfileScope(const omnetpp::cComponent* component, const char* section);
+    ~LteProfileScope();
+};
+
+#define LTE_PROFILE_SCOPE(component, section)    LteProfileScope lteProfileScope_(component, section)
+#define LTE_PROFILE_RECORD(component)            LteProfiler::recordScalars(component)
+#define LTE_PROFILE_RESET()                      LteProfiler::reset()
+
+#else
+
+#define LTE_PROFILE_SCOPE(component, section)
+#define LTE_PROFILE_RECORD(component)
+#define LTE_PROFILE_RESET()
+
+#endif
+
+#endif
@@ -0,0 +1,81 @@
+//
+//                           SimuLTE
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". This license can be also found at http://www.ltesimulator.com/
+// The above file and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+// Replacements of the global allocation functions counting the allocations
+// for the profiler (see LteProfiler.h), in a translation unit of their own so
+// that the compiler does not inline them into the standard containers.
+// They are used only if linked into the executable: in a shared library
+// loaded at run time (opp_run -l) the ones of libstdc++ take precedence,
+// see LteProfiler::countsAllocs().
+
+#include "common/LteProfiler.h"
+
+#ifdef LTE_PROFILING
+
+#include <cstdlib>
+#include <new>
+
+void* operator new(size_t size)
+{
+    LteProfiler::allocs++;
+    LteProfiler::allocBytes += size;
+    void* p = malloc(size ? size : 1);
+    if (p == nullptr)
+        throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    LteProfiler::allocs++;
+    LteProfiler::allocBytes += size;
+    return malloc(size ? size : 1);
+}
+
+void* operator new[](size_t size, const std::nothrow_t& tag) noexcept
+{
+    return operator new(size, tag);
+}
+
+void operator delete(void* p) noexcept
+{
+    free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+    free(p);
+}
+
+void operator delete[](void* p, size_t) noexcept
+{
+    free(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept
+{
+    free(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept
+{
+    free(p);
+}
+
+#endif
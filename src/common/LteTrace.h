@@ -0,0 +1,65 @@
+//
+//                           SimuLTE
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". This license can be also found at http://www.ltesimulator.com/
+// The above file and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+//
+//  Description:
+//  Compile-time gated tracing for the PHY, MAC and resource allocation kernels.
+//
+//  EV_PHY, EV_MAC and EV_RES are drop-in replacements for EV (info level).
+//  When the subsystem's compile-time level is above info, the statement
+//  becomes "if (false) ; else EV << ...", so the compiler removes the whole
+//  statement, including the evaluation of its arguments (dirToA(), distance()
+//  and the like). Loops that only produce log output should additionally be
+//  guarded by LTE_TRACE_ENABLED(subsystem).
+//
+//  Levels are omnetpp::LogLevel values and can be set per subsystem:
+//    LTE_TRACE_LEVEL       default for all subsystems
+//    LTE_TRACE_LEVEL_PHY   channel model, PHY layers
+//    LTE_TRACE_LEVEL_MAC   MAC layers, schedulers, AMC, sidelink configuration
+//    LTE_TRACE_LEVEL_RES   sidelink resource allocation
+//
+//  Release builds (NDEBUG) default to LOGLEVEL_WARN, i.e. tracing stripped;
+//  debug builds default to LOGLEVEL_TRACE. From the command line:
+//    make MODE=release LTE_TRACE_LEVEL=INFO        (keep tracing everywhere)
+//    make MODE=debug LTE_TRACE_LEVEL_PHY=OFF       (strip PHY tracing only)
+//
+
+#ifndef _LTE_LTETRACE_H_
+#define _LTE_LTETRACE_H_
+
+#include <omnetpp.h>
+
+#ifndef LTE_TRACE_LEVEL
+#  ifdef NDEBUG
+#    define LTE_TRACE_LEVEL omnetpp::LOGLEVEL_WARN
+#  else
+#    define LTE_TRACE_LEVEL omnetpp::LOGLEVEL_TRACE
+#  endif
+#endif
+
+#ifndef LTE_TRACE_LEVEL_PHY
+#  define LTE_TRACE_LEVEL_PHY LTE_TRACE_LEVEL
+#endif
+#ifndef LTE_TRACE_LEVEL_MAC
+#  define LTE_TRACE_LEVEL_MAC LTE_TRACE_LEVEL
+#endif
+#ifndef LTE_TRACE_LEVEL_RES
+#  define LTE_TRACE_LEVEL_RES LTE_TRACE_LEVEL
+#endif
+
+//! True if info-level tracing of the given subsystem (PHY, MAC, RES) is compiled in
+#define LTE_TRACE_ENABLED(subsystem)    (omnetpp::LOGLEVEL_INFO >= LTE_TRACE_LEVEL_##subsystem)
+
+#define LTE_EV(subsystem)    if (!LTE_TRACE_ENABLED(subsystem)) ; else EV
+
+#define EV_PHY    LTE_EV(PHY)
+#define EV_MAC    LTE_EV(MAC)
+#define EV_RES    LTE_EV(RES)
+
+#endif
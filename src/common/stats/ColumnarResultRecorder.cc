@@ -0,0 +1,276 @@
+//
+//                           SimuLTE
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". This license can be also found at http://www.ltesimulator.com/
+// The above file and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#include "common/stats/ColumnarResultRecorder.h"
+#include <cmath>
+#include <sys/stat.h>
+#ifdef _WIN32
+#include <direct.h>
+#endif
+
+using namespace omnetpp;
+
+Register_PerRunConfigOption(CFGID_COLUMNAR_OUTPUT_FILE, "columnar-output-file", CFG_FILENAME, "${resultdir}/${configname}-${iterationvarsf}#${repetition}.col", "Name of the binary columnar result file written by the \"columnar\" result recorder.");
+Register_PerRunConfigOption(CFGID_COLUMNAR_BUFFER_SIZE, "columnar-buffer-size", CFG_INT, "65536", "Number of samples each \"columnar\" result recorder buffers before appending them to the columnar result file.");
+
+Register_ResultRecorder("columnar", ColumnarRecorder);
+Register_ResultRecorder("quantiles", QuantileRecorder);
+
+static const char COLUMNAR_MAGIC[8] = { 'L', 'T', 'E', 'C', 'O', 'L', '0', '1' };
+
+// create all the directories leading to the given file name
+static void makeParentDirs(const std::string& fileName)
+{
+    for (size_t pos = fileName.find_first_of("/\\", 1); pos != std::string::npos; pos = fileName.find_first_of("/\\", pos + 1))
+    {
+        std::string dir = fileName.substr(0, pos);
+#ifdef _WIN32
+        _mkdir(dir.c_str());
+#else
+        mkdir(dir.c_str(), 0755);
+#endif
+    }
+}
+
+/*
+ * ColumnarSink
+ */
+
+ColumnarSink* ColumnarSink::instance_ = nullptr;
+
+ColumnarSink::ColumnarSink()
+{
+    nextColumnId_ = 0;
+    refCount_ = 0;
+}
+
+ColumnarSink* ColumnarSink::acquire()
+{
+    if (instance_ == nullptr)
+        instance_ = new ColumnarSink();
+    instance_->refCount_++;
+    return instance_;
+}
+
+void ColumnarSink::release()
+{
+    if (instance_ == nullptr)
+        return;
+    if (--instance_->refCount_ == 0)
+    {
+        if (instance_->out_.is_open())
+            instance_->out_.close();
+        delete instance_;
+        instance_ = nullptr;
+    }
+}
+
+size_t ColumnarSink::getBufferSize()
+{
+    long size = getEnvir()->getConfig()->getAsInt(CFGID_COLUMNAR_BUFFER_SIZE);
+    return size > 0 ? (size_t)size : 1;
+}
+
+void ColumnarSink::open()
+{
+    fileName_ = getEnvir()->getConfig()->getAsFilename(CFGID_COLUMNAR_OUTPUT_FILE);
+    makeParentDirs(fileName_);
+    out_.open(fileName_.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!out_.is_open())
+        throw cRuntimeError("ColumnarSink: cannot open columnar result file \"%s\"", fileName_.c_str());
+
+    int32_t scaleExp = SimTime::getScaleExp();
+    out_.write(COLUMNAR_MAGIC, sizeof(COLUMNAR_MAGIC));
+    out_.write((const char*)&scaleExp, sizeof(scaleExp));
+}
+
+unsigned int ColumnarSink::declareColumn(const std::string& modulePath, const std::string& name)
+{
+    if (!out_.is_open())
+        open();
+
+    uint32_t columnId = nextColumnId_++;
+    uint32_t pathLen = modulePath.size();
+    uint32_t nameLen = name.size();
+
+    out_.put('D');
+    out_.write((const char*)&columnId, sizeof(columnId));
+    out_.write((const char*)&pathLen, sizeof(pathLen));
+    out_.write(modulePath.data(), pathLen);
+    out_.write((const char*)&nameLen, sizeof(nameLen));
+    out_.write(name.data(), nameLen);
+    return columnId;
+}
+
+void ColumnarSink::writeBlock(unsigned int columnId, const std::vector<int64_t>& times, const std::vector<double>& values)
+{
+    ASSERT(times.size() == values.size());
+    if (times.empty())
+        return;
+    if (!out_.is_open())
+        open();
+
+    uint32_t id = columnId;
+    uint32_t n = times.size();
+    out_.put('B');
+    out_.write((const char*)&id, sizeof(id));
+    out_.write((const char*)&n, sizeof(n));
+    out_.write((const char*)times.data(), n * sizeof(int64_t));
+    out_.write((const char*)values.data(), n * sizeof(double));
+    if (out_.fail())
+        throw cRuntimeError("ColumnarSink: cannot write columnar result file \"%s\"", fileName_.c_str());
+}
+
+/*
+ * ColumnarRecorder
+ */
+
+ColumnarRecorder::ColumnarRecorder()
+{
+    sink_ = ColumnarSink::acquire();
+    columnId_ = -1;
+    capacity_ = ColumnarSink::getBufferSize();
+    times_.reserve(capacity_);
+    values_.reserve(capacity_);
+}
+
+ColumnarRecorder::~ColumnarRecorder()
+{
+    ColumnarSink::release();
+}
+
+void ColumnarRecorder::collect(simtime_t_cref t, double value, cObject *details)
+{
+    times_.push_back(t.raw());
+    values_.push_back(value);
+    if (times_.size() >= capacity_)
+        flush();
+}
+
+void ColumnarRecorder::flush()
+{
+    if (times_.empty())
+        return;
+    if (columnId_ < 0)
+        columnId_ = sink_->declareColumn(getComponent()->getFullPath(), getStatisticName());
+    sink_->writeBlock(columnId_, times_, values_);
+    times_.clear();
+    values_.clear();
+}
+
+void ColumnarRecorder::finish(cResultFilter *prev)
+{
+    flush();
+}
+
+/*
+ * QuantileRecorder
+ */
+
+QuantileRecorder::QuantileRecorder()
+{
+    zeros_ = 0;
+    count_ = 0;
+    sum_ = 0.0;
+    min_ = 0.0;
+    max_ = 0.0;
+    logBase_ = log(1.0 + QUANTILE_REL_ERROR);
+}
+
+int QuantileRecorder::binIndex(double absValue) const
+{
+    return (int)floor(log(absValue / QUANTILE_MIN_ABS) / logBase_);
+}
+
+double QuantileRecorder::binValue(int index) const
+{
+    return QUANTILE_MIN_ABS * exp((index + 0.5) * logBase_);
+}
+
+void QuantileRecorder::collect(simtime_t_cref t, double value, cObject *details)
+{
+    if (std::isnan(value))
+        return;
+
+    if (count_ == 0)
+        min_ = max_ = value;
+    else if (value < min_)
+        min_ = value;
+    else if (value > max_)
+        max_ = value;
+    count_++;
+    sum_ += value;
+
+    double absValue = fabs(value);
+    if (absValue < QUANTILE_MIN_ABS)
+    {
+        zeros_++;
+        return;
+    }
+    std::vector<uint64_t>& bins = (value > 0) ? positive_ : negative_;
+    unsigned int index = binIndex(absValue);
+    if (index >= bins.size())
+        bins.resize(index + 1, 0);
+    bins[index]++;
+}
+
+double QuantileRecorder::quantile(double q) const
+{
+    uint64_t rank = (uint64_t)floor(q * (count_ - 1));
+    uint64_t seen = 0;
+    double value = max_;
+
+    // walk from the most negative value to the most positive one
+    bool found = false;
+    for (int i = (int)negative_.size() - 1; i >= 0 && !found; i--)
+    {
+        seen += negative_[i];
+        if (seen > rank)
+        {
+            value = -binValue(i);
+            found = true;
+        }
+    }
+    if (!found)
+    {
+        seen += zeros_;
+        if (seen > rank)
+        {
+            value = 0.0;
+            found = true;
+        }
+    }
+    for (unsigned int i = 0; i < positive_.size() && !found; i++)
+    {
+        seen += positive_[i];
+        if (seen > rank)
+        {
+            value = binValue(i);
+            found = true;
+        }
+    }
+    return std::min(std::max(value, min_), max_);
+}
+
+void QuantileRecorder::finish(cResultFilter *prev)
+{
+    opp_string_map attributes = getStatisticAttributes();
+    std::string name = getStatisticName();
+    cComponent* component = getComponent();
+
+    getEnvir()->recordScalar(component, (name + ":count").c_str(), count_, &attributes);
+    if (count_ == 0)
+        return;
+    getEnvir()->recordScalar(component, (name + ":min").c_str(), min_, &attributes);
+    getEnvir()->recordScalar(component, (name + ":max").c_str(), max_, &attributes);
+    getEnvir()->recordScalar(component, (name + ":mean").c_str(), sum_ / count_, &attributes);
+    getEnvir()->recordScalar(component, (name + ":p50").c_str(), quantile(0.50), &attributes);
+    getEnvir()->recordScalar(component, (name + ":p90").c_str(), quantile(0.90), &attributes);
+    getEnvir()->recordScalar(component, (name + ":p99").c_str(), quantile(0.99), &attributes);
+}
@@ -0,0 +1,131 @@
+//
+//                           SimuLTE
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". This license can be also found at http://www.ltesimulator.com/
+// The above file and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#ifndef _LTE_COLUMNARRESULTRECORDER_H_
+#define _LTE_COLUMNARRESULTRECORDER_H_
+
+#include <omnetpp.h>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "common/LteCommon.h"
+
+/**
+ * Binary, column-oriented sink shared by all ColumnarRecorder instances of a run.
+ *
+ * Each recorded statistic owns a column (one int64 column with raw simtimes and
+ * one double column with values). Columns are buffered by their recorders and
+ * appended to the file as blocks, so the per-sample cost is a store into a
+ * preallocated array instead of a formatted write into the .vec file.
+ *
+ * File layout (little endian, as produced by the host):
+ *   header : "LTECOL01" | int32 simtime scale exponent
+ *   records: uint8 type followed by
+ *     type 'D' (column declaration): uint32 columnId | uint32 len | module path
+ *                                    | uint32 len | statistic name
+ *     type 'B' (data block)        : uint32 columnId | uint32 n
+ *                                    | int64 rawTime[n] | double value[n]
+ *
+ * Use src/common/stats/colrec2csv.py to convert the file to CSV or Parquet.
+ * The file is opened on the first flush and closed when the last recorder of
+ * the run is deleted, i.e. at network teardown.
+ */
+class SIMULTE_API ColumnarSink
+{
+  private:
+    static ColumnarSink* instance_;
+
+    std::ofstream out_;
+    std::string fileName_;
+    unsigned int nextColumnId_;
+    unsigned int refCount_;
+
+    ColumnarSink();
+    void open();
+
+  public:
+    //! Return the sink of the current run, creating it if needed, and take a reference
+    static ColumnarSink* acquire();
+    //! Drop a reference; the file is closed and the sink destroyed with the last one
+    static void release();
+
+    //! Number of samples a recorder buffers before flushing (columnar-buffer-size)
+    static size_t getBufferSize();
+
+    //! Declare a new column and return its identifier
+    unsigned int declareColumn(const std::string& modulePath, const std::string& name);
+    //! Append a block of samples to the given column
+    void writeBlock(unsigned int columnId, const std::vector<int64_t>& times, const std::vector<double>& values);
+};
+
+/**
+ * Result recorder "columnar": stores every sample of the statistic into the
+ * binary columnar file of the run instead of an output vector.
+ *
+ * Select it per statistic in omnetpp.ini, e.g.
+ *   **.rcvdSinr.result-recording-modes = -vector,+columnar
+ */
+class SIMULTE_API ColumnarRecorder : public omnetpp::cNumericResultRecorder
+{
+  protected:
+    ColumnarSink* sink_;
+    int columnId_;
+    size_t capacity_;
+    std::vector<int64_t> times_;
+    std::vector<double> values_;
+
+    void flush();
+
+  protected:
+    virtual void collect(omnetpp::simtime_t_cref t, double value, omnetpp::cObject *details) override;
+    virtual void finish(omnetpp::cResultFilter *prev) override;
+
+  public:
+    ColumnarRecorder();
+    virtual ~ColumnarRecorder();
+};
+
+/**
+ * Result recorder "quantiles": in-simulation aggregation of the statistic into a
+ * fixed-size logarithmic histogram. At finish it records count, min, max, mean
+ * and the 50th/90th/99th percentiles as scalars, so that distributions of
+ * per-packet signals are available without writing the samples at all.
+ *
+ * Bins are spaced by a factor of (1 + QUANTILE_REL_ERROR) on |value|, so the
+ * reported percentiles carry a relative error of at most QUANTILE_REL_ERROR/2.
+ */
+class SIMULTE_API QuantileRecorder : public omnetpp::cNumericResultRecorder
+{
+  protected:
+    static constexpr double QUANTILE_REL_ERROR = 0.01;
+    static constexpr double QUANTILE_MIN_ABS = 1e-9;
+
+    // one histogram for positive, one for negative values, plus a zero bucket
+    std::vector<uint64_t> positive_;
+    std::vector<uint64_t> negative_;
+    uint64_t zeros_;
+    uint64_t count_;
+    double sum_;
+    double min_;
+    double max_;
+    double logBase_;
+
+    int binIndex(double absValue) const;
+    double binValue(int index) const;
+    double quantile(double q) const;
+
+  protected:
+    virtual void collect(omnetpp::simtime_t_cref t, double value, omnetpp::cObject *details) override;
+    virtual void finish(omnetpp::cResultFilter *prev) override;
+
+  public:
+    QuantileRecorder();
+};
+
+#endif
@@ -0,0 +1,110 @@
+#!/usr/bin/env python3
+#
+#                           SimuLTE
+#
+# This file is part of a software released under the license included in file
+# "license.pdf". This license can be also found at http://www.ltesimulator.com/
+# The above file and the present reference are part of the software itself,
+# and cannot be removed from it.
+#
+# Converts the binary files written by the "columnar" result recorder
+# (see ColumnarResultRecorder.h) into CSV or Parquet.
+#
+# usage: colrec2csv.py [-o OUT] [--split] [--parquet] file.col
+#
+#   default     one long-format CSV: module,name,time,value
+#   --split     one CSV per column in the directory OUT
+#   --parquet   one Parquet file with columns module,name,time,value
+#               (requires pyarrow)
+#
+
+import argparse
+import csv
+import os
+import struct
+import sys
+from array import array
+
+MAGIC = b"LTECOL01"
+
+
+def read_columns(path):
+    """Return (scaleExp, {columnId: [module, name, times, values]})."""
+    columns = {}
+    with open(path, "rb") as f:
+        if f.read(len(MAGIC)) != MAGIC:
+            raise ValueError("%s: not a columnar result file" % path)
+        (scale_exp,) = struct.unpack("<i", f.read(4))
+        while True:
+            kind = f.read(1)
+            if not kind:
+                break
+            if kind == b"D":
+                col_id, plen = struct.unpack("<II", f.read(8))
+                module = f.read(plen).decode()
+                (nlen,) = struct.unpack("<I", f.read(4))
+                name = f.read(nlen).decode()
+                columns[col_id] = [module, name, array("q"), array("d")]
+            elif kind == b"B":
+                col_id, n = struct.unpack("<II", f.read(8))
+                times = array("q")
+                times.frombytes(f.read(8 * n))
+                values = array("d")
+                values.frombytes(f.read(8 * n))
+                if sys.byteorder != "little":
+                    times.byteswap()
+                    values.byteswap()
+                columns[col_id][2].extend(times)
+                columns[col_id][3].extend(values)
+            else:
+                raise ValueError("%s: corrupted record at offset %d" % (path, f.tell() - 1))
+    return scale_exp, columns
+
+
+def rows(scale_exp, columns):
+    scale = 10.0 ** scale_exp
+    for col_id in sorted(columns):
+        module, name, times, values = columns[col_id]
+        for t, v in zip(times, values):
+            yield module, name, t * scale, v
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert columnar result files to CSV/Parquet")
+    parser.add_argument("input")
+    parser.add_argument("-o", "--output", help="output file (or directory with --split)")
+    parser.add_argument("--split", action="store_true", help="write one CSV per column")
+    parser.add_argument("--parquet", action="store_true", help="write Parquet instead of CSV")
+    args = parser.parse_args()
+
+    scale_exp, columns = read_columns(args.input)
+    base = os.path.splitext(args.input)[0]
+
+    if args.parquet:
+        import pyarrow as pa
+        import pyarrow.parquet as pq
+        module, name, time, value = zip(*rows(scale_exp, columns)) if columns else ((), (), (), ())
+        table = pa.table({"module": pa.array(module).dictionary_encode(),
+                          "name": pa.array(name).dictionary_encode(),
+                          "time": pa.array(time, pa.float64()),
+                          "value": pa.array(value, pa.float64())})
+        pq.write_table(table, args.output or base + ".parquet")
+    elif args.split:
+        outdir = args.output or base
+        os.makedirs(outdir, exist_ok=True)
+        scale = 10.0 ** scale_exp
+        for col_id, (module, name, times, values) in sorted(columns.items()):
+            fname = "%s.%s.csv" % (module, name.replace(":", "_"))
+            with open(os.path.join(outdir, fname), "w", newline="") as out:
+                writer = csv.writer(out)
+                writer.writerow(["time", "value"])
+                writer.writerows((t * scale, v) for t, v in zip(times, values))
+    else:
+        with open(args.output or base + ".csv", "w", newline="") as out:
+            writer = csv.writer(out)
+            writer.writerow(["module", "name", "time", "value"])
+            writer.writerows(rows(scale_exp, columns))
+
+
+if __name__ == "__main__":
+    main()
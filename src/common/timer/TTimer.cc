@@ -18,6 +18,7 @@ void TTimer::start(simtime_t t)
     intr_ = new TTimerMsg("timer");
     intr_->setType(TTSIMPLE);
     intr_->setTimerId(timerId_);
+    intr_->setContextPointer(contextPointer_);
     module_->scheduleAt(t + NOW, intr_);
     busy_ = true;
     start_ = NOW;
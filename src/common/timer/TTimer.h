@@ -32,6 +32,7 @@ class SIMULTE_API TTimer : public omnetpp::cObject
         start_ = 0;
         expire_ = 0;
         timerId_ = 0;
+        contextPointer_ = nullptr;
     }
 
     /*! Do nothing.
@@ -78,11 +79,33 @@ class SIMULTE_API TTimer : public omnetpp::cObject
         this->timerId_ = timerId_;
     }
 
+    /*!
+     * Sets the connected module, on which the timer messages are scheduled.
+     * It must not be changed while the timer is busy.
+     *
+     * @param module The connected module
+     */
+    void setModule(omnetpp::cSimpleModule* module)
+    {
+        module_ = module;
+    }
+
+    /*!
+     * Sets the context pointer of the timer messages, which lets the
+     * connected module dispatch them to the object that started the timer
+     *
+     * @param ptr The context pointer
+     */
+    void setContextPointer(void* ptr)
+    {
+        contextPointer_ = ptr;
+    }
+
     /*! Return true if the timer is busy.
      *
      * @return whether the timer is busy or not
      */
-    bool busy()
+    bool busy() const
     {
         return busy_;
     }
@@ -91,7 +114,7 @@ class SIMULTE_API TTimer : public omnetpp::cObject
      *
      * @return whether the timer is idle or not
      */
-    bool idle()
+    bool idle() const
     {
         return !busy_;
     }
@@ -132,6 +155,8 @@ class SIMULTE_API TTimer : public omnetpp::cObject
 
     //! Expire time.
     omnetpp::simtime_t expire_;
+    //! Context pointer of the timer messages
+    void* contextPointer_;
 };
 
 /*!
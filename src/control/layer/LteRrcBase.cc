@@ -16,6 +16,7 @@
 #include "LteRrcBase.h"
 #include <omnetpp.h>
 #include "corenetwork/lteip/IP2lte.h"
+#include "common/LteProfiler.h"
 
 
 void LteRrcBase::initialize(int stage)
@@ -73,6 +74,7 @@ void LteRrcBase::initialize(int stage)
 
 void LteRrcBase::handleMessage(cMessage *msg)
 {
+    LTE_PROFILE_SCOPE(this, "handleMessage");
     EV<<"LteRrcBase::handleMessage"<< msg->getName()<<endl;
     if (msg->isSelfMessage())
     {
@@ -14,6 +14,7 @@
 // 
 
 #include "LteRrcEnb.h"
+#include "common/LteProfiler.h"
 
 using namespace omnetpp;
 
@@ -34,6 +35,7 @@ void LteRrcEnb::initialize(int stage)
 
 void LteRrcEnb::handleMessage(cMessage *msg)
 {
+    LTE_PROFILE_SCOPE(this, "handleMessage");
     EV <<"LteRrcEnb::handleSelfMessage Scanning for cellular coverage"<< endl;
 
     if (msg->isSelfMessage())
@@ -9,6 +9,7 @@
 
 #include "LteRrcRsuEnb.h"
 #include "common/LteCommon.h"
+#include "common/LteProfiler.h"
 
 Define_Module(LteRrcRsuEnb);
 
@@ -27,6 +28,7 @@ void LteRrcRsuEnb::initialize(int stage)
 
 void LteRrcRsuEnb::handleMessage(cMessage *msg)
 {
+   LTE_PROFILE_SCOPE(this, "handleMessage");
    EV <<"LteRrcRsuEnb::handleSelfMessage Scanning for cellular coverage"<< endl;
 
     if (msg->isSelfMessage())
@@ -18,6 +18,7 @@
 #include <omnetpp.h>
 #include "common/LteCommon.h"
 #include "control/packet/RRCStateChange_m.h"
+#include "common/LteProfiler.h"
 
 
 
@@ -52,6 +53,7 @@ void LteRrcUe::initialize(int stage)
 }
 void LteRrcUe::handleMessage(cMessage *msg)
 {
+    LTE_PROFILE_SCOPE(this, "handleMessage");
     // TODO - Generated method body
     if (msg->isSelfMessage())
     {
@@ -13,6 +13,8 @@
 
 #include "../lteCellInfo/LteCellInfo.h"
 #include "corenetwork/nodes/InternetMux.h"
+#include "stack/phy/layer/LtePhyBase.h"
+#include "common/LteProfiler.h"
 
 using namespace std;
 
@@ -25,6 +27,13 @@ void LteBinder::unregisterNode(MacNodeId id)
 	if(nodeIds_.erase(id) != 1){
 		EV_ERROR << "Cannot unregister node - node id \"" << id << "\" - not found";
 	}
+	std::map<MacNodeId, inet::Coord>::iterator pit = nodePositions_.find(id);
+	if (pit != nodePositions_.end())
+	{
+		if (nodeGridCellSize_ > 0)
+			nodeGrid_[getNodeGridCell(pit->second)].erase(id);
+		nodePositions_.erase(pit);
+	}
 	//IP-Based
 	std::map<Ipv4Address, MacNodeId>::iterator it;
 	for(it = macNodeIdToIPAddress_.begin(); it != macNodeIdToIPAddress_.end(); )
@@ -161,6 +170,7 @@ void LteBinder::initialize(int stage)
 	if (stage == inet::INITSTAGE_LOCAL)
 	{
 		numBands_ = par("numBands");
+		LTE_PROFILE_RESET();
 	}
 
 	const char * stringa;
@@ -184,6 +194,12 @@ void LteBinder::initialize(int stage)
 	}
 }
 
+void LteBinder::finish()
+{
+	// summary of the built-in profiler, if compiled in
+	LTE_PROFILE_RECORD(this);
+}
+
 //QCI
 int LteBinder::getQCIPriority(int QCI)
 {
@@ -520,6 +536,130 @@ void LteBinder::updateUeInfoCellId(MacNodeId id, MacCellId newCellId)
 	}
 }
 
+void LteBinder::buildEnbGrid(double cellSize)
+{
+	enbGrid_.clear();
+	enbGridCellSize_ = cellSize;
+	enbGridSize_ = enbList_.size();
+
+	std::vector<EnbInfo*>::iterator it = enbList_.begin();
+	for (; it != enbList_.end(); ++it)
+	{
+		LtePhyBase* phy = check_and_cast<LtePhyBase*>((*it)->eNodeB->getSubmodule("lteNic")->getSubmodule("phy"));
+		inet::Coord pos = phy->getCoord();
+		std::pair<int, int> key((int)floor(pos.x / cellSize), (int)floor(pos.y / cellSize));
+		enbGrid_[key].push_back(std::make_pair(*it, pos));
+	}
+}
+
+void LteBinder::getEnbsInRange(const inet::Coord& pos, double range, std::vector<EnbInfo*>& cells)
+{
+	if (range <= 0)
+	{
+		cells.insert(cells.end(), enbList_.begin(), enbList_.end());
+		return;
+	}
+
+	if (enbGridCellSize_ <= 0 || enbGridSize_ != enbList_.size())
+		buildEnbGrid(range);
+
+	int minX = (int)floor((pos.x - range) / enbGridCellSize_);
+	int maxX = (int)floor((pos.x + range) / enbGridCellSize_);
+	int minY = (int)floor((pos.y - range) / enbGridCellSize_);
+	int maxY = (int)floor((pos.y + range) / enbGridCellSize_);
+	for (int x = minX; x <= maxX; x++)
+	{
+		for (int y = minY; y <= maxY; y++)
+		{
+			EnbGrid::iterator git = enbGrid_.find(std::make_pair(x, y));
+			if (git == enbGrid_.end())
+				continue;
+
+			std::vector<std::pair<EnbInfo*, inet::Coord> >::iterator it = git->second.begin();
+			for (; it != git->second.end(); ++it)
+			{
+				if (it->second.distance(pos) <= range)
+					cells.push_back(it->first);
+			}
+		}
+	}
+}
+
+std::pair<int, int> LteBinder::getNodeGridCell(const inet::Coord& pos) const
+{
+	return std::make_pair((int)floor(pos.x / nodeGridCellSize_), (int)floor(pos.y / nodeGridCellSize_));
+}
+
+void LteBinder::updateNodePosition(MacNodeId nodeId, const inet::Coord& pos)
+{
+	std::map<MacNodeId, inet::Coord>::iterator it = nodePositions_.find(nodeId);
+	if (it == nodePositions_.end())
+	{
+		nodePositions_[nodeId] = pos;
+		if (nodeGridCellSize_ > 0)
+			nodeGrid_[getNodeGridCell(pos)].insert(nodeId);
+		return;
+	}
+
+	if (nodeGridCellSize_ > 0)
+	{
+		std::pair<int, int> oldCell = getNodeGridCell(it->second);
+		std::pair<int, int> newCell = getNodeGridCell(pos);
+		if (oldCell != newCell)
+		{
+			nodeGrid_[oldCell].erase(nodeId);
+			nodeGrid_[newCell].insert(nodeId);
+		}
+	}
+	it->second = pos;
+}
+
+void LteBinder::getNodesInRange(const inet::Coord& pos, double range, std::vector<MacNodeId>& nodes)
+{
+	size_t first = nodes.size();
+	if (range <= 0)
+	{
+		std::map<MacNodeId, inet::Coord>::iterator it = nodePositions_.begin();
+		for (; it != nodePositions_.end(); ++it)
+		{
+			if (nodeIds_.find(it->first) != nodeIds_.end())
+				nodes.push_back(it->first);
+		}
+		return;
+	}
+
+	if (nodeGridCellSize_ <= 0)
+	{
+		// build the grid, with cells as large as the range
+		nodeGridCellSize_ = range;
+		std::map<MacNodeId, inet::Coord>::iterator it = nodePositions_.begin();
+		for (; it != nodePositions_.end(); ++it)
+			nodeGrid_[getNodeGridCell(it->second)].insert(it->first);
+	}
+
+	int minX = (int)floor((pos.x - range) / nodeGridCellSize_);
+	int maxX = (int)floor((pos.x + range) / nodeGridCellSize_);
+	int minY = (int)floor((pos.y - range) / nodeGridCellSize_);
+	int maxY = (int)floor((pos.y + range) / nodeGridCellSize_);
+	for (int x = minX; x <= maxX; x++)
+	{
+		for (int y = minY; y <= maxY; y++)
+		{
+			NodeGrid::iterator git = nodeGrid_.find(std::make_pair(x, y));
+			if (git == nodeGrid_.end())
+				continue;
+
+			std::set<MacNodeId>::iterator it = git->second.begin();
+			for (; it != git->second.end(); ++it)
+			{
+				if (nodePositions_[*it].distance(pos) <= range && nodeIds_.find(*it) != nodeIds_.end())
+					nodes.push_back(*it);
+			}
+		}
+	}
+	std::sort(nodes.begin() + first, nodes.end());
+}
+
 void LteBinder::addUeHandoverTriggered(MacNodeId nodeId)
 {
 	ueHandoverTriggered_.insert(nodeId);
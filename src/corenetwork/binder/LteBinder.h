@@ -109,6 +109,32 @@ private:
 	 */
 	// store the id of the UEs that are performing handover
 	std::set<MacNodeId> ueHandoverTriggered_;
+
+	/*
+	 * Handover measurement support
+	 */
+	// uniform grid of eNB positions, built on the first query (eNBs are assumed not to move)
+	typedef std::map<std::pair<int, int>, std::vector<std::pair<EnbInfo*, inet::Coord> > > EnbGrid;
+	EnbGrid enbGrid_;
+	// side of the grid cells, i.e. the range of the query that built the grid
+	double enbGridCellSize_;
+	// number of eNBs in the grid, the grid is rebuilt if more eNBs are registered
+	unsigned int enbGridSize_;
+
+	void buildEnbGrid(double cellSize);
+
+	/*
+	 * Sidelink multicast support
+	 */
+	// last known position of the nodes, kept up to date by their PHY
+	std::map<MacNodeId, inet::Coord> nodePositions_;
+	// uniform grid of node positions, built on the first query and then updated incrementally
+	typedef std::map<std::pair<int, int>, std::set<MacNodeId> > NodeGrid;
+	NodeGrid nodeGrid_;
+	// side of the grid cells, i.e. the range of the query that built the grid
+	double nodeGridCellSize_;
+
+	std::pair<int, int> getNodeGridCell(const inet::Coord& pos) const;
 protected:
 
 	std::vector<double> periodicCamTransmissions;
@@ -120,6 +146,7 @@ protected:
 	MacNodeId rsuUeId;
 	bool nodeRegisteredInSimlation;
 	virtual void initialize(int stages);
+	virtual void finish();
 
 	virtual int numInitStages() const { return INITSTAGE_LAST; }
 
@@ -139,6 +166,9 @@ public:
 		macNodeIdCounter_[2] = UE_MIN_ID;
 		macNodeIdCounter_[4] = RSUEnB_MIN_ID;
 		ulTransmissionMap_.resize(2); // store transmission map of previous and current TTI
+		enbGridCellSize_ = 0;
+		enbGridSize_ = 0;
+		nodeGridCellSize_ = 0;
 	}
 
 	unsigned int getNumBands()
@@ -426,6 +456,18 @@ public:
 	bool hasUeHandoverTriggered(MacNodeId nodeId);
 	void removeUeHandoverTriggered(MacNodeId nodeId);
 	void updateUeInfoCellId(MacNodeId nodeId, MacCellId cellId);
+	/*
+	 *  Handover measurement support
+	 */
+	// append to cells the eNBs within the given range from pos (all the eNBs if range is not positive)
+	void getEnbsInRange(const inet::Coord& pos, double range, std::vector<EnbInfo*>& cells);
+	/*
+	 *  Sidelink multicast support
+	 */
+	// set the position of a node, called by its PHY whenever the node moves
+	void updateNodePosition(MacNodeId nodeId, const inet::Coord& pos);
+	// append to nodes the registered nodes within the given range from pos, in increasing id order
+	void getNodesInRange(const inet::Coord& pos, double range, std::vector<MacNodeId>& nodes);
 
 	//periodic CAM transmissions
 	void updatePeriodicCamTransmissions(MacNodeId, double );
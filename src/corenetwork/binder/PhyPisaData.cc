@@ -13,7 +13,7 @@
 
 using namespace omnetpp;
 
-double blerCurvesNew[3][15][49]={
+const double blerCurvesNew[3][15][49]={
         {
                 { 0.7208885924, 0.6364279834, 0.5332800360, 0.4360423440, 0.3666968777, 0.2702148823, 0.2545646762, 0.1872308878, 0.1517548369, 0.1063099811, 0.0748798778, 0.0606737487, 0.0532828620, 0.0387772788, 0.0293569902, 0.0226701188, 0.0184603938, 0.0142304934, 0.0120606390, 0.0082131224, 0.0063205729, 0.0046069027, 0.0037611803, 0.0031393568, 0.0026150711, 0.0017728079, 0.0015719911, 0.0009521393, 0.0009466133, 0.0008233501, 0.0006088240, 0.0004728737, 0.0003828146, 0.0003060003, 0.0002537224, 0.0002230114, 0.0002008010, 0.0001679888, 0.0001355403, 0.0001104041, 0.0000908001, 0.0000655503, 0.0000570788, 0.0000456929, 0.0000365713, 0.0000292649, 0.0000234136, 0.0000187286, 0.0000149782},
 
@@ -109,40 +109,7 @@ double blerCurvesNew[3][15][49]={
         }
 };
 
-double blerCurves[3][8][46]={
-        {
-            {0.834083,0.778111,0.704648,0.609695,0.530735,0.436782,0.392804,0.317841,0.273863,0.213393,0.167416,0.14043,0.124938,0.095952,0.0774613,0.0609695,0.0504798,0.03998,0.0339713,0.0247167,0.018992,0.0146949,0.0119348,0.00990181,0.00849079,0.00616694,0.00505782,0.00342581,0.00309056,0.00258662,0.00191761,0.00151120,0.00123091,0.00109123,0,0,0,0,0,0,0,0,0,0,0,0},
-            {0.928536,0.857571,0.806597,0.732134,0.670665,0.598201,0.478761,0.418791,0.349325,0.269865,0.254873,0.194403,0.168416,0.130435,0.0969515,0.0849575,0.0704648,0.0544728,0.0429785,0.0348552,0.0299831,0.0237936,0.0190196,0.0149442,0.011859,0.00862212,0.00756314,0.00603409,0.00480498,0.00355861,0.002786012,0.00213212,0.00167882,0.00149436,0,0,0,0,0,0,0,0,0,0,0,0},
-            {0.964017991004,0.937531234383,0.908045977011,0.849575212394,0.751124437781,0.688655672164,0.609695152424,0.517741129435,0.436781609195,0.387306346827,0.290354822589,0.257371314343,0.209395302349,0.174912543728,0.145927036482,0.115942028986,0.095952023988,0.075462268866,0.060469765117,0.051474262869,0.043978010995,0.036981509245,0.025641025641,0.020735981308,0.014433828014,0.010876225490,0.011179341836,0.007338501292,0.006810551559,0.004557124519,0.003527775017,0.003070403044,0.002534808997,0.001642036125,0.001458294822,0,0,0,0,0,0,0,0,0,0,0},
-            {0.998001,0.994503,0.981509,0.969515,0.935532,0.890555,0.828086,0.761619,0.670165,0.585707,0.537731,0.435282,0.366317,0.298351,0.243378,0.195402,0.157921,0.133933,0.115442,0.089955,0.067966,0.0559735,0.0509745,0.0384823,0.0294449,0.023927,0.0198168,0.0145598,0.0129657,0.0101342,0.00690216,0.00633367,0.00419172,0.00366338,0.00269644,0.00212588,0,0,0,0,0,0,0,0,0,0},
-            {1,0.998501,0.995502,0.992004,0.986507,0.964518,0.923038,0.876062,0.811094,0.754623,0.670165,0.578711,0.508246,0.405797,0.36032,0.29985,0.23988,0.192904,0.177411,0.138931,0.113443,0.0844578,0.0654673,0.049975,0.0424788,0.0344828,0.0300975,0.019955,0.0186499,0.0113292,0.0130851,0.00862174,0.00663986,0.00646866,0.0052698,0.00405714,0.00244532,0.00230932,0.00166698,0.00142003,0.00112,0.00062,0.00072,0,0,0},
-            {1,1,1,1,0.996002,0.988506,0.974513,0.944528,0.909045,0.842579,0.774613,0.715142,0.623688,0.531734,0.447776,0.384808,0.321839,0.242379,0.218391,0.167916,0.145427,0.104948,0.0914543,0.0694653,0.0564718,0.0474763,0.0313189,0.0274449,0.0232026,0.0188329,0.015492,0.0125088,0.0115372,0.00735218,0.0062489,0.00446878,0.00370873,0.00345146,0.00303458,0.00222941,0.0017345,0.00134,0.00086,0,0,0},
-            {1,1,1,1,1,0.995002,0.988506,0.971014,0.943528,0.896052,0.833083,0.767116,0.703148,0.603698,0.523238,0.457271,0.381809,0.332334,0.25937,0.203398,0.167916,0.146927,0.110445,0.0874563,0.0834583,0.0654673,0.0469765,0.0464768,0.0341182,0.0239218,0.0191066,0.016554,0.0130299,0.0112431,0.00733092,0.00733623,0.00605337,0.00424972,0.00346443,0.00221246,0.00185354,0.00208126,0.00118,0,0,0},
-            {1,1,1,1,1,0.998501,0.995502,0.985507,0.964518,0.941529,0.894553,0.849075,0.767616,0.678661,0.618191,0.514743,0.450775,0.366817,0.298351,0.264368,0.207396,0.187406,0.142929,0.12044,0.102949,0.0849575,0.0609695,0.0524738,0.0389805,0.0278322,0.0200735,0.0175569,0.0156457,0.01428,0.0119188,0.00822902,0.00585133,0.00465086,0.0039333,0.00313923,0.00254818,0.00249105,0.00185127,0,0,0}
-        },
-        {
-            {0.873063468266, 0.788105947026, 0.674662668666, 0.561719140430, 0.454272863568, 0.321839080460, 0.244877561219,0.170414792604, 0.125437281359, 0.077961019490, 0.056448598131, 0.042836879433, 0.031204794379, 0.015809862842, 0.011510901052, 0.006883034005, 0.004453226377, 0.002980000000, 0.002060000000,0.001340000000, 0.000760000000, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
-            {0.960019990005, 0.910044977511, 0.836081959020, 0.745127436282, 0.613193403298, 0.499250374813, 0.397301349325, 0.309845077461, 0.207896051974, 0.163418290855, 0.099450274863, 0.071192833569, 0.056702966579, 0.031923890063, 0.023436287444, 0.014113468548, 0.009647945818, 0.005474386397, 0.003835992277, 0.002420000000, 0.001700000000, 0.001180000000, 0.000740000000, 0.000580000000, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
-            {0.996001999000, 0.990004997501, 0.962518740630, 0.931534232884, 0.855572213893, 0.784607696152, 0.662168915542, 0.570714642679, 0.434782608696, 0.338330834583, 0.263868065967, 0.168915542229, 0.127436281859, 0.089955022489, 0.057589626240, 0.036072623029, 0.025420875421, 0.016600703606, 0.009982811054, 0.006987505784, 0.004355601708, 0.002840000000, 0.001500000000, 0.001160000000, 0.000880000000, 0.000540000000, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
-            {1, 1, 0.9980012, 0.9955023, 0.9865074, 0.9670165, 0.9360326, 0.8420797, 0.7671168, 0.6411799, 0.53423310, 0.42728611, 0.32433812, 0.24287913, 0.16541714, 0.1194415, 0.084957516, 0.055109517, 0.034593418, 0.024693419, 0.01470320, 0.0094475421, 0.0062830322, 0.0041403923, 0.0026886824, 0.001734525, 0.0011232326, 0.00070232,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
-            {1.000000000000, 1.000000000000, 1.000000000000, 0.998000999500, 0.992003998001, 0.990004997501, 0.959520239880, 0.910044977511, 0.838580709645, 0.743628185907, 0.655172413793, 0.508245877061, 0.409295352324, 0.300849575212, 0.213393303348, 0.164917541229, 0.117441279360, 0.079960019990, 0.054591467824, 0.032911944202, 0.024473257699, 0.014470531864, 0.009441630713, 0.006377766515, 0.004017560197, 0.002500000000, 0.001580000000, 0.000900000000, 0.000740000000, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
-            {1.000000000000, 1.000000000000, 1.000000000000, 1.000000000000, 1.000000000000, 0.997001499250, 0.994502748626, 0.976011994003, 0.938030984508, 0.875062468766, 0.781609195402, 0.678660669665, 0.583208395802, 0.442278860570, 0.346826586707, 0.256871564218, 0.166416791604, 0.118940529735, 0.088955522239, 0.066286215979, 0.047011207970, 0.026329555362, 0.015642805345, 0.012283413325, 0.006943486458, 0.004911527453, 0.003456405796, 0.001960000000, 0.001540000000, 0.000660000000, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
-            {1.000000000000, 1.000000000000, 1.000000000000, 1.000000000000, 1.000000000000, 1.000000000000, 0.999000499750, 0.989505247376, 0.966016991504, 0.935532233883, 0.876061969015, 0.784107946027, 0.686156921539, 0.561719140430, 0.425787106447, 0.340829585207, 0.249375312344, 0.181409295352, 0.114442778611, 0.096951524238, 0.063820794590, 0.043591224018, 0.026260869565, 0.016979646913, 0.012691208606, 0.007763496144, 0.004915524594, 0.003032676588, 0.001920000000, 0.001220000000, 0.000900000000, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
-            {1.000000000000, 1.000000000000, 1.000000000000, 1.000000000000, 1.000000000000, 0.999500249875, 0.999500249875, 0.999500249875, 0.991504247876, 0.972013993003, 0.946026986507, 0.870064967516, 0.773613193403, 0.677661169415, 0.559220389805, 0.441779110445, 0.337831084458, 0.252373813093, 0.182908545727, 0.135932033983, 0.092453773113, 0.058869395712, 0.037958773253, 0.024433656958, 0.017787725292, 0.011207600386, 0.007004685253, 0.004637734574, 0.002860000000, 0.001800000000, 0.001320000000, 0.000940000000, 0.000520000000, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}
-        },
-        {
-            {0.9385311, 0.8835582, 0.779113, 0.7171414, 0.6016995, 0.519746, 0.4157927, 0.339838, 0.2913549, 0.2203910, 0.17091511, 0.14492812, 0.11694213, 0.084957514, 0.06996515, 0.050474816, 0.047476317, 0.036981518, 0.031415919, 0.018872920, 0.015318521, 0.013519322, 0.010755923, 0.0089173624, 0.0064102625, 0.0052137326, 0.0044525327, 0.0033044828, 0.0023044829, 0.0017044830, 0.00123212, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
-            {0.9991, 0.9920042, 0.979013, 0.960524, 0.9240385, 0.8435786, 0.7941037, 0.7086468, 0.6446789, 0.56621710, 0.46176911, 0.39530212, 0.32383813, 0.25887114, 0.20839615, 0.18140916, 0.13193417, 0.11844118, 0.08795619, 0.080459820, 0.058970521, 0.042478322, 0.041479323, 0.033482324, 0.027174225, 0.019564626, 0.016080927, 0.01254228, 0.01054229, 0.008131230, 0.006148731, 0.004046132, 0.0029796833, 0.002145734, 0.0016353535, 0.00123246, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
-            {1, 1, 0.9985012, 0.9975013, 0.9950024, 0.9835085, 0.9665176, 0.939537, 0.8710648, 0.8130939, 0.73763110, 0.66366811, 0.54822612, 0.49675213, 0.39480314, 0.32733615, 0.26836616, 0.22288917, 0.17741118, 0.15742119, 0.12793620, 0.094452821, 0.068465822, 0.058470823, 0.045477324, 0.040979525, 0.026802626, 0.03088327, 0.017825828, 0.01640129, 0.013617230, 0.010402931, 0.008566532, 0.0065748533, 0.0049784534, 0.0035641535, 0.00265755, 0, 0, 0, 0, 0, 0, 0, 0, 0},
-            {1, 1, 1, 1, 0.99955, 0.9950026, 0.9835087, 0.9630188, 0.9380319, 0.88605710, 0.82508711, 0.75612212, 0.66316813, 0.58570714, 0.50624715, 0.44227916, 0.35182417, 0.2993518, 0.24887619, 0.20339820, 0.16691721, 0.13143422, 0.11744123, 0.090454824, 0.07396325, 0.053473326, 0.04097427, 0.031195128, 0.025849529, 0.019125230, 0.015615631, 0.012615632, 0.010006233, 0.0079126234, 0.0058615635, 0.00435155, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
-            {1, 1, 1, 1, 1, 1, 0.9945037, 0.9945038, 0.9770119, 0.9590210, 0.91754111, 0.86506712, 0.800113, 0.72813614, 0.64567715, 0.56871616, 0.45727117, 0.40229918, 0.34282919, 0.26286920, 0.21589221, 0.17241422, 0.13343323, 0.12643724, 0.09795125, 0.066966526, 0.05197427, 0.04397828, 0.035482329, 0.028826630, 0.020987331, 0.018166732, 0.015133, 0.012512234, 0.010300335, 0.0084289536, 0.0069365837, 0.0052390838, 0.0041172939, 0.003416940, 0.002816941, 0.001990942, 0.00136901, 0, 0, 0},
-            {1, 1, 1, 1, 1, 1, 0.9997, 0.99958, 0.9945039, 0.99050510, 0.97201411, 0.94902512, 0.90154913, 0.83858114, 0.77261415, 0.68415816, 0.61419317, 0.54122918, 0.43028519, 0.37581220, 0.30834621, 0.25687222, 0.20739623, 0.1794124, 0.13343325, 0.10644726, 0.089455327, 0.06796628, 0.052473829, 0.04197930, 0.035044431, 0.028768232, 0.021417833, 0.020845634, 0.016892735, 0.012243836, 0.010846337, 0.0075806138, 0.0066848739, 0.0055455840, 0.0041455841, 0.0033455842, 0.0023558, 0, 0, 0,},
-            {1, 1, 1, 1, 1, 1, 1, 1, 0.9985019, 0.99600210, 0.98950511, 0.97501212, 0.95252413, 0.91604214, 0.84207915, 0.77211416, 0.70364817, 0.60119918, 0.51874119, 0.46376820, 0.38330821, 0.30984522, 0.25437323, 0.21389324, 0.16991525, 0.14542726, 0.12443827, 0.090954528, 0.073463329, 0.06196930, 0.052973531, 0.044477832, 0.034388233, 0.026119534, 0.022903135, 0.019473436, 0.015258337, 0.012423438, 0.0089725839, 0.0073345840, 0.0059079141, 0.0048261542, 0.0038256143, 0.0028256144, 0.0020256145, 0.00152561},
-            {1, 1, 1, 1, 1, 1, 1, 0.99958, 0.99959, 0.999510, 0.99400311, 0.99150412, 0.96951513, 0.94602714, 0.90754615, 0.84757616, 0.76261917, 0.69365318, 0.61719119, 0.53273420, 0.46826621, 0.39230422, 0.31634223, 0.2808624, 0.20689725, 0.17141426, 0.15592227, 0.11544228, 0.09795129, 0.070464830, 0.07196431, 0.05797132, 0.043478333, 0.027756134, 0.025613335, 0.022525436, 0.016431437, 0.014853638, 0.010966939, 0.0086606540, 0.0067330541, 0.0058258842, 0.0045178543, 0.0037178544, 0.0028917945, 0.0021785}
-        }
-    };
-
-double lambdaTable[][3]={{1.597911858997, 0.710313546117, 2.249586633581}, {1.596637792198, 0.495826714440, 3.220152818918}, {1.919399495716, 0.432685156729, 4.436018813830}, {1.783436236411, 0.175433296494, 10.165893659026},
+const double lambdaTable[][3]={{1.597911858997, 0.710313546117, 2.249586633581}, {1.596637792198, 0.495826714440, 3.220152818918}, {1.919399495716, 0.432685156729, 4.436018813830}, {1.783436236411, 0.175433296494, 10.165893659026},
         {1.601185653216, 0.663524990588, 2.413150485557}, {1.013635204668, 0.400976920537, 2.527914083707}, {3.433005091875, 0.640791622132, 5.357443782507}, {1.729162282384, 0.618298264805, 2.796647477133},
         {1.388369315840, 0.235029187439, 5.907220847614}, {2.321342872213, 0.645022737237, 3.598854332109}, {1.968126135269, 0.715414278598, 2.751029989400}, {2.168855708983, 0.692363418760, 3.132539429749},
         {1.871198920414, 0.446293573842, 4.192753447703}, {1.036764658035, 0.772901393001, 1.341393180841}, {1.470343928566, 0.506973491221, 2.900238284697}, {1.358735351867, 0.231040555268, 5.880938739480},
@@ -2646,9 +2613,11 @@ double lambdaTable[][3]={{1.597911858997, 0.710313546117, 2.249586633581}, {1.59
 
 PhyPisaData::PhyPisaData()
 {
-    // TODO Auto-generated constructor stub
-    memcpy(blerCurves_, blerCurvesNew, sizeof(double) * 3 * 15 * 49);
-    memcpy(lambdaTable_, lambdaTable, sizeof(double) * 10000 * 3);
+    // the tables are constant: refer to them instead of copying them in every run
+    blerCurves_ = blerCurvesNew;
+    lambdaTable_ = lambdaTable;
+
+    // channel samples are drawn from the RNGs of the run
     channel_.resize(10000);
     double x, y;
     for (int i = 0; i < 1000; i++)
@@ -18,8 +18,9 @@
 
 class SIMULTE_API PhyPisaData
 {
-    double lambdaTable_[10000][3];
-    double blerCurves_[3][15][49];
+    // read-only tables, shared by all the instances (and runs) of the process
+    const double (*lambdaTable_)[3];
+    const double (*blerCurves_)[15][49];
     std::vector<double> channel_;
     public:
     PhyPisaData();
@@ -34,6 +34,7 @@
 #include "corenetwork/lteCellInfo/LteCellInfo.h"
 #include "corenetwork/lteip/Constants.h"
 #include "stack/mac/layer/LteMacBase.h"
+#include "common/LteProfiler.h"
 
 using namespace std;
 using namespace inet;
@@ -103,6 +104,7 @@ void IP2lte::initialize(int stage)
 
 void IP2lte::handleMessage(cMessage *msg)
 {
+	LTE_PROFILE_SCOPE(this, "handleMessage");
 	if( nodeType_ == ENODEB )
 	{
 		// message from IP Layer: send to stack
@@ -194,42 +196,39 @@ void IP2lte::fromIpUe(Packet * datagram)
 }
 
 void IP2lte::toStackUe(Packet * pkt)
+{
+	setFlowControlInfo(pkt, true);
+
+	printControlInfo(pkt);
+
+	//** Send datagram to lte stack or LteIp peer **
+	send(pkt,stackGateOut_);
+}
+
+void IP2lte::setFlowControlInfo(Packet* pkt, bool countIpHeader)
 {
 	// 5-Tuple infos
 	unsigned short srcPort = 0;
 	unsigned short dstPort = 0;
 
-	auto protocolId = getProtocolId(pkt);
-	auto datagram = pkt->peekAtFront<Ipv4Header>();
-	auto transportHeader = getTransportProtocolHeader(pkt);
-
-	int transportProtocol = datagram->getProtocolId();
 	// TODO Add support to IPv6 (=> see L3Tools.cc of INET)
-	auto srcAddr  = datagram->getSrcAddress();
-	auto destAddr = datagram->getDestAddress();
-
-	// if needed, create a new structure for the flow
-	AddressPair pair(srcAddr, destAddr);
-	if (seqNums_.find(pair) == seqNums_.end())
-	{
-		std::pair<AddressPair, unsigned int> p(pair, 0);
-		seqNums_.insert(p);
-	}
-
-	int headerSize = datagram->getHeaderLength().get();
+	const auto& iphdr = pkt->peekAtFront<Ipv4Header>();
+	int transportProtocol = iphdr->getProtocolId();
+	Ipv4Address srcAddr  = iphdr->getSrcAddress(),
+			destAddr = iphdr->getDestAddress();
+	int headerSize = countIpHeader ? iphdr->getHeaderLength().get() : 0;
 
-	// inspect packet depending on the transport protocol type
-	// TODO: needs refactoring (redundant code, see toStackEnb())
+	// inspect the transport header, which follows the IP header
 	switch (transportProtocol) {
 	case IP_PROT_TCP: {
-		auto tcpHdr = dynamicPtrCast<const tcp::TcpHeader>(transportHeader);
+		const auto& tcpHdr = pkt->peekDataAt<tcp::TcpHeader>(iphdr->getChunkLength());
 		srcPort = tcpHdr->getSrcPort();
 		dstPort = tcpHdr->getDestPort();
 		headerSize += B(tcpHdr->getHeaderLength()).get();
 		break;
 	}
 	case IP_PROT_UDP: {
-		auto udpHdr = dynamicPtrCast<const UdpHeader>(transportHeader);
+		const auto& udpHdr = pkt->peekDataAt<UdpHeader>(iphdr->getChunkLength());
 		srcPort = udpHdr->getSrcPort();
 		dstPort = udpHdr->getDestPort();
 		headerSize += UDP_HEADER_BYTES;
@@ -240,17 +239,16 @@ void IP2lte::toStackUe(Packet * pkt)
 	}
 	}
 
-	pkt->addTagIfAbsent<FlowControlInfo>()->setSrcAddr(srcAddr.getInt());
-	pkt->addTagIfAbsent<FlowControlInfo>()->setDstAddr(destAddr.getInt());
-	pkt->addTagIfAbsent<FlowControlInfo>()->setSrcPort(srcPort);
-	pkt->addTagIfAbsent<FlowControlInfo>()->setDstPort(dstPort);
-	pkt->addTagIfAbsent<FlowControlInfo>()->setSequenceNumber(seqNums_[pair]++);
-	pkt->addTagIfAbsent<FlowControlInfo>()->setHeaderSize(headerSize);
-
-	printControlInfo(pkt);
+	// one sequence number counter for each flow, created on its first packet
+	unsigned int& seqNum = seqNums_[AddressPair(srcAddr, destAddr)];
 
-	//** Send datagram to lte stack or LteIp peer **
-	send(pkt,stackGateOut_);
+	auto lteInfo = pkt->addTagIfAbsent<FlowControlInfo>();
+	lteInfo->setSrcAddr(srcAddr.getInt());
+	lteInfo->setDstAddr(destAddr.getInt());
+	lteInfo->setSrcPort(srcPort);
+	lteInfo->setDstPort(dstPort);
+	lteInfo->setSequenceNumber(seqNum++);
+	lteInfo->setHeaderSize(headerSize);
 }
 
 void IP2lte::prepareForIpv4(Packet *datagram, const Protocol *protocol){
@@ -337,60 +335,16 @@ void IP2lte::toIpEnb(Packet* pkt)
 void IP2lte::toStackEnb(Packet* pkt)
 {
 	EV << "IP2lte::toStackEnb - packet is forwarded to stack" << endl;
-	// 5-Tuple infos
-	unsigned short srcPort = 0;
-	unsigned short dstPort = 0;
-	auto& iphdr = pkt->removeAtFront<Ipv4Header>();
-	int transportProtocol = iphdr->getProtocolId();
-	Ipv4Address srcAddr  = iphdr->getSrcAddress(),
-			destAddr = iphdr->getDestAddress();
-	MacNodeId destId = binder_->getMacNodeId(destAddr);
-
-	// if needed, create a new structure for the flow
-	AddressPair pair(srcAddr, destAddr);
-	if (seqNums_.find(pair) == seqNums_.end())
-	{
-		std::pair<AddressPair, unsigned int> p(pair, 0);
-		seqNums_.insert(p);
-	}
-
-	int headerSize = 0;
-
-	switch(transportProtocol)
-	{
-	case IP_PROT_TCP: {
-		auto& tcpHdr = pkt->peekAtFront<tcp::TcpHeader>();
-		srcPort = tcpHdr->getSrcPort();
-		dstPort = tcpHdr->getDestPort();
-		headerSize += B(tcpHdr->getHeaderLength()).get();
-		break;
-	}
-	case IP_PROT_UDP: {
-		auto& udpHdr = pkt->peekAtFront<UdpHeader>();
-		srcPort = udpHdr->getSrcPort();
-		dstPort = udpHdr->getDestPort();
-		headerSize += inet::UDP_HEADER_LENGTH.get();
-		break;
-	}
-	default: {
-		EV_ERROR << "Unknown transport protocol id." << endl;
-	}
-	}
-	// re-insert ip header
-	pkt->insertAtFront(iphdr);
 
 	// prepare flow info for LTE stack
-	pkt->addTagIfAbsent<FlowControlInfo>()->setSrcAddr(srcAddr.getInt());
-	pkt->addTagIfAbsent<FlowControlInfo>()->setDstAddr(destAddr.getInt());
-	pkt->addTagIfAbsent<FlowControlInfo>()->setSrcPort(srcPort);
-	pkt->addTagIfAbsent<FlowControlInfo>()->setDstPort(dstPort);
-	pkt->addTagIfAbsent<FlowControlInfo>()->setSequenceNumber(seqNums_[pair]++);
-	pkt->addTagIfAbsent<FlowControlInfo>()->setHeaderSize(headerSize);
+	setFlowControlInfo(pkt, false);
+	auto lteInfo = pkt->getTagForUpdate<FlowControlInfo>();
 
 	// TODO Relay management should be placed here
+	MacNodeId destId = binder_->getMacNodeId(Ipv4Address(lteInfo->getDstAddr()));
 	MacNodeId master = binder_->getNextHop(destId);
 
-	pkt->addTagIfAbsent<FlowControlInfo>()->setDestId(master);
+	lteInfo->setDestId(master);
 	printControlInfo(pkt);
 
 	send(pkt,stackGateOut_);
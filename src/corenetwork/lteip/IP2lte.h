@@ -11,6 +11,7 @@
 #define __SIMULTE_IP2LTE_H_
 
 #include <omnetpp.h>
+#include <unordered_map>
 #include <inet/networklayer/common/NetworkInterface.h>
 
 #include "common/LteCommon.h"
@@ -23,6 +24,14 @@ class LteHandoverManager;
 // a sort of five-tuple with only two elements (a two-tuple...), src and dst addresses
 typedef std::pair<inet::Ipv4Address, inet::Ipv4Address> AddressPair;
 
+struct AddressPairHash
+{
+    size_t operator()(const AddressPair& pair) const
+    {
+        return std::hash<uint64_t>()(((uint64_t)pair.first.getInt() << 32) | pair.second.getInt());
+    }
+};
+
 /**
  *
  */
@@ -36,7 +45,7 @@ protected:
 
 	// datagram sequence numbers (one for each flow)
 	// TODO move numbering to PDCP
-	std::map<AddressPair, unsigned int> seqNums_;
+	std::unordered_map<AddressPair, unsigned int, AddressPairHash> seqNums_;
 
 	// obsolete with the above map
 	unsigned int seqNum_;       // datagram sequence number (RLC fragmentation needs it)
@@ -84,6 +93,15 @@ protected:
 	virtual void toStackEnb(inet::Packet* datagram);
 	virtual void toStackUe(inet::Packet* datagram);
 
+	/**
+	 * Classifies the datagram, which starts with its IP header: parses
+	 * the IP and transport headers once and fills the FlowControlInfo tag
+	 * with the four-tuple, the header size (transport header, plus the IP
+	 * header if countIpHeader) and the sequence number of the flow.
+	 * The lower layers only read the tag.
+	 */
+	void setFlowControlInfo(inet::Packet* datagram, bool countIpHeader);
+
 	/**
 	 * utility: set nodeType_ field
 	 *
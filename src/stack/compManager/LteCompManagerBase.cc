@@ -8,6 +8,7 @@
 //
 
 #include "stack/compManager/LteCompManagerBase.h"
+#include "common/LteProfiler.h"
 
 using namespace omnetpp;
 using namespace inet;
@@ -81,6 +82,7 @@ void LteCompManagerBase::initialize()
 
 void LteCompManagerBase::handleMessage(cMessage *msg)
 {
+    LTE_PROFILE_SCOPE(this, "handleMessage");
     if (msg->isSelfMessage())
     {
         if (strcmp(msg->getName(),"compClientTick_") == 0)
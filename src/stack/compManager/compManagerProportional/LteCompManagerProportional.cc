@@ -7,6 +7,7 @@
 // and cannot be removed from it.
 //
 
+#include <algorithm>
 #include "stack/compManager/compManagerProportional/LteCompManagerProportional.h"
 
 Define_Module(LteCompManagerProportional);
@@ -15,6 +16,8 @@ using namespace inet;
 void LteCompManagerProportional::initialize()
 {
     LteCompManagerBase::initialize();
+
+    noBlocks_.assign(numBands_, NOT_AVAILABLE_RB);
 }
 
 void LteCompManagerProportional::provisionalSchedule()
@@ -60,45 +63,39 @@ void LteCompManagerProportional::doCoordination()
 {
     EV << NOW << " LteCompManagerProportional::doCoordination - Start " << endl;
 
-    partitioning_.clear();
-    offset_.clear();
-
-    unsigned int requestsSum = 0;
-    std::map<X2NodeId, unsigned int>::iterator it = reqBlocksMap_.begin();
-    for (; it != reqBlocksMap_.end(); ++it)
-        requestsSum += it->second;
+    if (!requestsChanged_)
+    {
+        // same requests as in the previous round, hence same partitioning
+        EV << NOW << " LteCompManagerProportional::doCoordination - End (requests unchanged)" << endl;
+        return;
+    }
+    requestsChanged_ = false;
 
     // assign a number of blocks that is proportional to the requests received from each eNB
-    unsigned int totalReservedBlocks = 0;
-    std::vector<double> reservation;
-    reservation.clear();
-    for (it = reqBlocksMap_.begin(); it != reqBlocksMap_.end(); ++it)
+    unsigned int numSlots = reqNodes_.size();
+    for (unsigned int i = 0; i < numSlots; i++)
     {
-
-
-        // requests from the current node
-        unsigned int req = it->second;
-
         // compute the number of blocks to reserve
         double percentage;
-        if (requestsSum == 0)
+        if (requestsSum_ == 0)
             percentage = 1.0 / (clientList_.size() + 1);  // slaves + master
         else
-            percentage = (double) req / requestsSum;
-
-        double toReserve = numBands_ * percentage;
-        totalReservedBlocks += toReserve;
+            percentage = (double) reqBlocks_[i] / requestsSum_;
 
-        reservation.push_back(toReserve);
+        reservation_[i] = numBands_ * percentage;
     }
 
-    // round vector to integer
-    partitioning_ = roundVector(reservation, totalReservedBlocks);
+    // round reservations to integer
+    roundReservation();
 
-    offset_.push_back(0);
-    for (unsigned int i=0; i < partitioning_.size() - 1; i++)
+    for (unsigned int i = 0; i < numSlots; i++)
     {
-        offset_.push_back(partitioning_[i]);
+        unsigned int offset = (i == 0) ? 0 : partitioning_[i - 1];
+        if (offset_[i] != offset)
+        {
+            offset_[i] = offset;
+            allowedBlocksValid_[i] = false;
+        }
     }
 
     EV << NOW << " LteCompManagerProportional::doCoordination - End " << endl;
@@ -115,47 +112,32 @@ X2CompProportionalRequestIE* LteCompManagerProportional::buildClientRequest()
 
 X2CompProportionalReplyIE* LteCompManagerProportional::buildCoordinatorReply(X2NodeId clientId)
 {
-    // find the correct entry in the partitioning vector
-    bool found = false;
-    unsigned int index = 0;
-    std::map<X2NodeId, unsigned int>::iterator it = reqBlocksMap_.begin();
-    for (; it != reqBlocksMap_.end(); ++it)
+    const std::vector<CompRbStatus>* allowedBlocks = &noBlocks_;
+
+    int slot = findSlot(clientId);
+    if (slot >= 0)
     {
-        if (it->first == clientId)
+        std::vector<CompRbStatus>& blocksMap = allowedBlocks_[slot];
+        if (!allowedBlocksValid_[slot])
         {
-            found = true;
-            break;
+            // set "numBlocks" contiguous blocks for this node
+            blocksMap.assign(numBands_, NOT_AVAILABLE_RB);
+            unsigned int lb = offset_[slot];
+            unsigned int ub = lb + partitioning_[slot];
+            for (unsigned int b = lb; b < ub; b++)
+                blocksMap[b] = AVAILABLE_RB;
+            allowedBlocksValid_[slot] = true;
         }
-        index++;
+        allowedBlocks = &blocksMap;
     }
-
-    unsigned int numBlocks = 0;
-    unsigned int band = 0;
-    if (found)
+    else
     {
-        numBlocks = partitioning_[index];
-        band = offset_[index];
-    } else {
         EV << "LteCompManagerProportional::buildCoordinatorReply: no information for " << clientId << " available (number of requested blocks unknown)" << std::endl;
     }
 
-    // build map for each node
-    std::vector<CompRbStatus> allowedBlocks;
-
-    // set "numBlocks" contiguous blocks for this node
-    allowedBlocks.clear();
-    allowedBlocks.resize(numBands_, NOT_AVAILABLE_RB);
-    unsigned int lb = band;
-    unsigned int ub = band + numBlocks;
-    for (unsigned int b = lb; b < ub; b++)
-    {
-        allowedBlocks[b] = AVAILABLE_RB;
-        band++;
-    }
-
     // build IE
     X2CompProportionalReplyIE* replyIe = new X2CompProportionalReplyIE();
-    replyIe->setAllowedBlocksMap(allowedBlocks);
+    replyIe->setAllowedBlocksMap(*allowedBlocks);
 
     return replyIe;
 }
@@ -174,11 +156,35 @@ void LteCompManagerProportional::handleClientRequest(inet::Ptr<X2CompMsg> compMs
 
         EV << "LteCompManagerProportional::handleClientRequest: " << this->getFullPath() << "received request from " << sourceId << " for " << reqBlocks << " blocks." << std::endl;
 
-        // update map entry for this node
-        if (reqBlocksMap_.find(sourceId) == reqBlocksMap_.end())
-            reqBlocksMap_.insert(std::pair<X2NodeId, unsigned int>(sourceId, reqBlocks));
-        else
-            reqBlocksMap_[sourceId] = reqBlocks;
+        // create the slot for this node, if needed
+        int slot = findSlot(sourceId);
+        if (slot < 0)
+        {
+            slot = std::lower_bound(reqNodes_.begin(), reqNodes_.end(), sourceId) - reqNodes_.begin();
+            reqNodes_.insert(reqNodes_.begin() + slot, sourceId);
+            reqBlocks_.insert(reqBlocks_.begin() + slot, 0);
+            partitioning_.insert(partitioning_.begin() + slot, 0);
+            offset_.insert(offset_.begin() + slot, 0);
+            reservation_.insert(reservation_.begin() + slot, 0.0);
+            allowedBlocks_.insert(allowedBlocks_.begin() + slot, std::vector<CompRbStatus>());
+            allowedBlocksValid_.insert(allowedBlocksValid_.begin() + slot, false);
+
+            // slots following the new one are shifted by one position
+            for (unsigned int i = 0; i < sortedSlots_.size(); i++)
+                if (sortedSlots_[i] >= (unsigned int)slot)
+                    sortedSlots_[i]++;
+            sortedSlots_.push_back(slot);
+
+            requestsChanged_ = true;
+        }
+
+        // update the request of this node
+        if (reqBlocks_[slot] != reqBlocks)
+        {
+            requestsSum_ = requestsSum_ - reqBlocks_[slot] + reqBlocks;
+            reqBlocks_[slot] = reqBlocks;
+            requestsChanged_ = true;
+        }
 
         delete requestIe;
     }
@@ -195,7 +201,7 @@ void LteCompManagerProportional::handleCoordinatorReply(inet::Ptr<X2CompMsg> com
 
         // parse reply message
         X2CompProportionalReplyIE* replyIe = check_and_cast<X2CompProportionalReplyIE*>(ie);
-        std::vector<CompRbStatus> allowedBlocksMap = replyIe->getAllowedBlocksMap();
+        const std::vector<CompRbStatus>& allowedBlocksMap = replyIe->getAllowedBlocksMap();
         UsableBands usableBands = parseAllowedBlocksMap(allowedBlocksMap);
 
         EV << "at" << this->getFullPath() << " LteCompManagerProportional::handleCoordinatorReply: " << usableBands.size() << " bands usable." << std::endl;
@@ -206,7 +212,7 @@ void LteCompManagerProportional::handleCoordinatorReply(inet::Ptr<X2CompMsg> com
     }
 }
 
-UsableBands LteCompManagerProportional::parseAllowedBlocksMap(std::vector<CompRbStatus>& allowedBlocksMap)
+UsableBands LteCompManagerProportional::parseAllowedBlocksMap(const std::vector<CompRbStatus>& allowedBlocksMap)
 {
     unsigned int reservedBlocks = 0;
     UsableBands usableBands;
@@ -225,65 +231,48 @@ UsableBands LteCompManagerProportional::parseAllowedBlocksMap(std::vector<CompRb
     return usableBands;
 }
 
-std::vector<unsigned int> LteCompManagerProportional::roundVector(std::vector<double>& vec, int sum)
+int LteCompManagerProportional::findSlot(X2NodeId nodeId) const
 {
-    // the rounding algorithm needs that the vector is sorted in ascending order
-
-    // we sort the vector, then put the elements in the original order
-    // to do this, we use an auxiliary vector to remember the original positions
-
-    unsigned int len = vec.size();
-    std::vector<unsigned int> integerVec;
-    integerVec.resize(len, 0);
+    std::vector<X2NodeId>::const_iterator it = std::lower_bound(reqNodes_.begin(), reqNodes_.end(), nodeId);
+    if (it == reqNodes_.end() || *it != nodeId)
+        return -1;
+    return it - reqNodes_.begin();
+}
 
-    if (len > 0)
+void LteCompManagerProportional::roundReservation()
+{
+    // the rounding algorithm needs the reservations sorted in ascending order (ties are
+    // broken by slot). The order of the previous round is the starting point, so that
+    // the insertion sort takes linear time when only a few requests changed
+    unsigned int len = sortedSlots_.size();
+    for (unsigned int i = 1; i < len; i++)
     {
-        // auxiliary vector
-        std::vector<unsigned int> auxVec;
-        auxVec.resize(len, 0);
-        for (unsigned int i = 0; i < auxVec.size(); i++)
-            auxVec[i] = i;
-
-        // sort vector in ascending order
-        bool swap = true;
-        while (swap)
+        unsigned int slot = sortedSlots_[i];
+        unsigned int j = i;
+        for (; j > 0; j--)
         {
-            swap = false;
-            for (unsigned int i = 0; i < len - 1; i++)
-            {
-                if (vec[i] > vec[i + 1])
-                {
-                    double tmp = vec[i + 1];
-                    vec[i + 1] = vec[i];
-                    vec[i] = tmp;
-
-                    unsigned int auxTmp = auxVec[i + 1];
-                    auxVec[i + 1] = auxVec[i];
-                    auxVec[i] = auxTmp;
-
-                    swap = true;
-                }
-            }
-        }
-
-        // round vector (the sum of the elements is preserved)
-        int integerTot = 0;
-        double doubleTot = 0;
-        for (unsigned int i = 0; i < len; i++)
-        {
-            doubleTot += vec[i];
-            vec[i] = (int) (doubleTot - integerTot);
-            integerTot += vec[i];
+            unsigned int prev = sortedSlots_[j - 1];
+            if (reservation_[prev] < reservation_[slot] || (reservation_[prev] == reservation_[slot] && prev < slot))
+                break;
+            sortedSlots_[j] = prev;
         }
+        sortedSlots_[j] = slot;
+    }
 
-        // TODO -  check numerical errors
+    // round reservations (the sum of the elements is preserved)
+    int integerTot = 0;
+    double doubleTot = 0;
+    for (unsigned int i = 0; i < len; i++)
+    {
+        unsigned int slot = sortedSlots_[i];
+        doubleTot += reservation_[slot];
+        int blocks = (int) (doubleTot - integerTot);
+        integerTot += blocks;
 
-        // set the integer vector with the elements in their original positions
-        for (unsigned int i = 0; i < integerVec.size(); i++)
+        if (partitioning_[slot] != (unsigned int)blocks)
         {
-            unsigned int index = auxVec[i];
-            integerVec[index] = vec[i];
+            partitioning_[slot] = blocks;
+            allowedBlocksValid_[slot] = false;
         }
     }
-    return integerVec;
 }
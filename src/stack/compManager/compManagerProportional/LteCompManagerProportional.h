@@ -26,15 +26,37 @@ protected:
 
     /*
      * Coordinator info
+     *
+     * Per-client state is kept in parallel vectors indexed by a slot, with
+     * slots sorted by X2NodeId. Slots are created on the first request of a
+     * client and then reused, so that a coordination round does not allocate.
      */
+    // clients that sent at least one request (sorted)
+    std::vector<X2NodeId> reqNodes_;
     // requests from clients
-    std::map<X2NodeId, unsigned int> reqBlocksMap_;
+    std::vector<unsigned int> reqBlocks_;
+    // sum of the requests
+    unsigned int requestsSum_;
+    // true if some request changed since the last coordination
+    bool requestsChanged_;
     // frame partitioning
     std::vector<unsigned int> partitioning_;
     std::vector<unsigned int> offset_;
+    // proportional (non-integer) reservation of each client
+    std::vector<double> reservation_;
+    // slots sorted by ascending reservation, kept between rounds
+    std::vector<unsigned int> sortedSlots_;
+    // allowed blocks map sent to each client, rebuilt only when its partition changes
+    std::vector<std::vector<CompRbStatus> > allowedBlocks_;
+    std::vector<bool> allowedBlocksValid_;
+    // allowed blocks map for clients without a partition
+    std::vector<CompRbStatus> noBlocks_;
 
-    // utility function: convert a vector of double to a vector of integer, preserving the sum of the elements
-    std::vector<unsigned int> roundVector(std::vector<double>& vec, int sum);
+    // return the slot of the given client, -1 if it has not sent any request
+    int findSlot(X2NodeId nodeId) const;
+
+    // convert reservation_ to integer partitioning_, preserving the sum of the elements
+    void roundReservation();
 
     virtual void provisionalSchedule();  // run the provisional scheduling algorithm (client side)
     virtual void doCoordination();       // run the coordination algorithm (coordinator side)
@@ -45,10 +67,11 @@ protected:
     virtual X2CompProportionalReplyIE* buildCoordinatorReply(X2NodeId clientId);
     virtual void handleCoordinatorReply(inet::Ptr<X2CompMsg> compMsg);
 
-    UsableBands parseAllowedBlocksMap(std::vector<CompRbStatus>& allowedBlocksMap);
+    UsableBands parseAllowedBlocksMap(const std::vector<CompRbStatus>& allowedBlocksMap);
 
 public:
-    LteCompManagerProportional() {}
+    LteCompManagerProportional() :
+        requestsSum_(0), requestsChanged_(false) {}
     virtual ~LteCompManagerProportional() {}
 
     virtual void initialize();
@@ -54,7 +54,7 @@ class SIMULTE_API X2CompProportionalReplyIE : public X2CompReplyIE
     virtual ~X2CompProportionalReplyIE() {}
 
     // getter/setter methods
-    void setAllowedBlocksMap(std::vector<CompRbStatus>& map)
+    void setAllowedBlocksMap(const std::vector<CompRbStatus>& map)
     {
         allowedBlocksMap_ = map;
         // number of bytes of map when being serialized
@@ -9,6 +9,7 @@
 
 #include "stack/d2dModeSelection/D2DModeSelectionBase.h"
 #include "stack/mac/layer/LteMacEnbD2D.h"
+#include "common/LteProfiler.h"
 
 Define_Module(D2DModeSelectionBase);
 
@@ -44,6 +45,7 @@ void D2DModeSelectionBase::initialize(int stage)
 
 void D2DModeSelectionBase::handleMessage(cMessage *msg)
 {
+    LTE_PROFILE_SCOPE(this, "handleMessage");
     if (msg->isSelfMessage())
     {
         if (strcmp(msg->getName(),"modeSelectionTick") == 0)
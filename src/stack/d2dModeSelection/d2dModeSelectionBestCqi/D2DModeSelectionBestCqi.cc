@@ -33,32 +33,44 @@ void D2DModeSelectionBestCqi::doModeSelection()
         if (binder_->getNextHop(srcId) != mac_->getMacCellId())
             continue;
 
+        // skip UEs that are performing handover
+        if (binder_->hasUeHandoverTriggered(srcId))
+            continue;
+
+        // since the D2D CQI is the same for all D2D connections, the mode will be the same for all
+        // destinations: it is computed at the first destination to be evaluated and reused for the others
+        bool modeComputed = false;
+        LteD2DMode newMode = DM;
+
         std::map<MacNodeId, LteD2DMode>::iterator jt = it->second.begin();
         for (; jt != it->second.end(); ++jt)
         {
-            MacNodeId dstId = jt->first;   // since the D2D CQI is the same for all D2D connections,
-                                            // the mode will be the same for all destinations
+            MacNodeId dstId = jt->first;
 
             // consider only UEs within this cell
             if (binder_->getNextHop(dstId) != mac_->getMacCellId())
                 continue;
 
             // skip UEs that are performing handover
-            if (binder_->hasUeHandoverTriggered(dstId) || binder_->hasUeHandoverTriggered(srcId))
+            if (binder_->hasUeHandoverTriggered(dstId))
                 continue;
 
             LteD2DMode oldMode = jt->second;
 
-            // Compute the achievable bits on a single RB for UL direction
-            // Note that this operation takes into account the CQI returned by the AMC Pilot (by default, it
-            // is the minimum CQI over all RBs)
-            unsigned int bitsUl = mac_->getAmc()->computeBitsOnNRbs(srcId, 0, 0, 1, UL);
-            unsigned int bitsD2D = mac_->getAmc()->computeBitsOnNRbs(srcId, 0, 0, 1, D2D);
+            if (!modeComputed)
+            {
+                // Compute the achievable bits on a single RB for UL direction
+                // Note that this operation takes into account the CQI returned by the AMC Pilot (by default, it
+                // is the minimum CQI over all RBs)
+                unsigned int bitsUl = mac_->getAmc()->computeBitsOnNRbs(srcId, 0, 0, 1, UL);
+                unsigned int bitsD2D = mac_->getAmc()->computeBitsOnNRbs(srcId, 0, 0, 1, D2D);
 
-            EV << NOW << " D2DModeSelectionBestCqi::doModeSelection - bitsUl[" << bitsUl << "] bitsD2D[" << bitsD2D << "]" << endl;
+                EV << NOW << " D2DModeSelectionBestCqi::doModeSelection - bitsUl[" << bitsUl << "] bitsD2D[" << bitsD2D << "]" << endl;
 
-            // compare the bits in the two modes and select the best one
-            LteD2DMode newMode = (bitsUl > bitsD2D) ? IM : DM;
+                // compare the bits in the two modes and select the best one
+                newMode = (bitsUl > bitsD2D) ? IM : DM;
+                modeComputed = true;
+            }
 
             if (newMode != oldMode)
             {
@@ -10,6 +10,7 @@
 #include "stack/handoverManager/LteHandoverManager.h"
 #include "stack/handoverManager/X2HandoverCommandIE.h"
 #include "inet/common/ProtocolTag_m.h"
+#include "common/LteProfiler.h"
 
 Define_Module(LteHandoverManager);
 
@@ -42,6 +43,7 @@ void LteHandoverManager::initialize()
 
 void LteHandoverManager::handleMessage(cMessage *msg)
 {
+    LTE_PROFILE_SCOPE(this, "handleMessage");
     cPacket* pkt = check_and_cast<cPacket*>(msg);
     cGate* incoming = pkt->getArrivalGate();
     if (incoming == x2Manager_[IN_GATE])
@@ -29,7 +29,7 @@ LteAmc::~LteAmc()
 
 AmcPilot* LteAmc::getAmcPilot(const cPar& p)
 {
-    EV << "Creating Amc pilot " << p.stringValue() << endl;
+    EV_MAC << "Creating Amc pilot " << p.stringValue() << endl;
     const char* s = p.stringValue();
     if(strcmp(s,"AUTO")==0)
     return new AmcPilotAuto(this);
@@ -48,7 +48,7 @@ MacNodeId LteAmc::getNextHop(MacNodeId dst)
         return dst;
     }
 
-    EV << "LteAmc::getNextHop Node Id dst : " << dst << endl;
+    EV_MAC << "LteAmc::getNextHop Node Id dst : " << dst << endl;
 
     // The UE is connected to a relay
     // XXX assert(nodeType_==ENODEB);
@@ -57,34 +57,34 @@ MacNodeId LteAmc::getNextHop(MacNodeId dst)
 
 void LteAmc::printParameters()
 {
-    EV << "###################" << endl;
-    EV << "# LteAmc parameters" << endl;
-    EV << "###################" << endl;
-
-    EV << "NumUeDl: " << dlConnectedUe_.size() << endl;
-    EV << "NumUeUl: " << ulConnectedUe_.size() << endl;
-    EV << "Number of cell bands: " << numBands_ << endl;
-
-    EV << "MacNodeId: " << nodeId_ << endl;
-    EV << "MacCellId: " << cellId_ << endl;
-    EV << "AmcMode: " << mac_->par("amcMode").stdstringValue() << endl;
-    EV << "RbAllocationType: " << allocationType_ << endl;
-    EV << "FBHB capacity DL: " << fbhbCapacityDl_ << endl;
-    EV << "FBHB capacity UL: " << fbhbCapacityUl_ << endl;
-    EV << "PmiWeight: " << pmiComputationWeight_ << endl;
-    EV << "CqiWeight: " << cqiComputationWeight_ << endl;
-    EV << "kCqi: " << kCqi_ << endl;
-    EV << "DL MCS scale: " << mcsScaleDl_ << endl;
-    EV << "UL MCS scale: " << mcsScaleUl_ << endl;
-    EV << "Confidence LB: " << lb_ << endl;
-    EV << "Confidence UB: " << ub_ << endl;
+    EV_MAC << "###################" << endl;
+    EV_MAC << "# LteAmc parameters" << endl;
+    EV_MAC << "###################" << endl;
+
+    EV_MAC << "NumUeDl: " << dlConnectedUe_.size() << endl;
+    EV_MAC << "NumUeUl: " << ulConnectedUe_.size() << endl;
+    EV_MAC << "Number of cell bands: " << numBands_ << endl;
+
+    EV_MAC << "MacNodeId: " << nodeId_ << endl;
+    EV_MAC << "MacCellId: " << cellId_ << endl;
+    EV_MAC << "AmcMode: " << mac_->par("amcMode").stdstringValue() << endl;
+    EV_MAC << "RbAllocationType: " << allocationType_ << endl;
+    EV_MAC << "FBHB capacity DL: " << fbhbCapacityDl_ << endl;
+    EV_MAC << "FBHB capacity UL: " << fbhbCapacityUl_ << endl;
+    EV_MAC << "PmiWeight: " << pmiComputationWeight_ << endl;
+    EV_MAC << "CqiWeight: " << cqiComputationWeight_ << endl;
+    EV_MAC << "kCqi: " << kCqi_ << endl;
+    EV_MAC << "DL MCS scale: " << mcsScaleDl_ << endl;
+    EV_MAC << "UL MCS scale: " << mcsScaleUl_ << endl;
+    EV_MAC << "Confidence LB: " << lb_ << endl;
+    EV_MAC << "Confidence UB: " << ub_ << endl;
 }
 
 void LteAmc::printFbhb(Direction dir)
 {
-    EV << "###################################" << endl;
-    EV << "# AMC FeedBack Historical Base (" << dirToA(dir) << ")" << endl;
-    EV << "###################################" << endl;
+    EV_MAC << "###################################" << endl;
+    EV_MAC << "# AMC FeedBack Historical Base (" << dirToA(dir) << ")" << endl;
+    EV_MAC << "###################################" << endl;
 
     History_ *history;
     std::vector<MacNodeId> *revIndex;
@@ -112,13 +112,13 @@ void LteAmc::printFbhb(Direction dir)
 
     for(; it!=et; it++)  // for each antenna
     {
-        EV << simTime() << " # Remote: " << dasToA(it->first) << "\n";
+        EV_MAC << simTime() << " # Remote: " << dasToA(it->first) << "\n";
         uit = (*history)[it->first].begin();
         uet = (*history)[it->first].end();
         int i = 0;
         for(; uit!=uet; uit++) // for each UE
         {
-            EV << "Ue index: " << i << ", MacNodeId: " << (*revIndex)[i] << endl;
+            EV_MAC << "Ue index: " << i << ", MacNodeId: " << (*revIndex)[i] << endl;
             txit = (*history)[it->first][i].begin();
             txet = (*history)[it->first][i].end();
             int t = 0;
@@ -133,7 +133,7 @@ void LteAmc::printFbhb(Direction dir)
                 if(testCqi==NOSIGNALCQI)
                 continue;
 
-                EV << "@TxMode " << txMode << endl;
+                EV_MAC << "@TxMode " << txMode << endl;
                 ((*txit).get()).print(0,(*revIndex)[i],dir, txMode,"LteAmc::printAmcFbhb");
             }
             i++;
@@ -143,9 +143,9 @@ void LteAmc::printFbhb(Direction dir)
 
 void LteAmc::printTxParams(Direction dir)
 {
-    EV << "######################" << endl;
-    EV << "# UserTxParams vector (" << dirToA(dir) << ")" << endl;
-    EV << "######################" << endl;
+    EV_MAC << "######################" << endl;
+    EV_MAC << "# UserTxParams vector (" << dirToA(dir) << ")" << endl;
+    EV_MAC << "######################" << endl;
 
     std::vector<UserTxParams>::const_iterator it,et;
     std::vector<UserTxParams> *userInfo;
@@ -178,7 +178,7 @@ void LteAmc::printTxParams(Direction dir)
     int index = 0;
     for(; it!=et; it++)
     {
-        EV << "Ue index: " << index << ", MacNodeId: " << (*revIndex)[index] << endl;
+        EV_MAC << "Ue index: " << index << ", MacNodeId: " << (*revIndex)[index] << endl;
 
         // Print only non empty user transmission parameters
         // testCqi = (*it).readCqiVector().at(0);
@@ -246,11 +246,13 @@ void LteAmc::initialize()
     dlMcsTable_.rescale(mcsScaleDl_);
     ulMcsTable_.rescale(mcsScaleUl_);
     d2dMcsTable_.rescale(mcsScaleD2D_);
+    tbsTable_ = &TbsTable::instance();
+    computeCqiTables();
 
     // Initialize DAS structures
     for (int i = 0; i < numAntennas_; i++)
     {
-        EV << "Adding Antenna: " << dasToA(Remote(i)) << endl;
+        EV_MAC << "Adding Antenna: " << dasToA(Remote(i)) << endl;
         remoteSet_.insert(Remote(i));
     }
 
@@ -268,7 +270,7 @@ void LteAmc::initialize()
     it = dlConnectedUe_.begin();
     et = dlConnectedUe_.end();
 
-    EV << "DL CONNECTED: " << dlConnectedUe_.size() << endl;
+    EV_MAC << "DL CONNECTED: " << dlConnectedUe_.size() << endl;
 
     for (; it != et; it++)  // For all UEs (DL)
     {
@@ -276,7 +278,7 @@ void LteAmc::initialize()
         dlNodeIndex_[nodeId] = dlRevNodeIndex_.size();
         dlRevNodeIndex_.push_back(nodeId);
 
-        EV << "Creating UE, id: " << nodeId << ", index: " << dlNodeIndex_[nodeId] << endl;
+        EV_MAC << "Creating UE, id: " << nodeId << ", index: " << dlNodeIndex_[nodeId] << endl;
 
         ait = remoteSet_.begin();
         aet = remoteSet_.end();
@@ -294,7 +296,7 @@ void LteAmc::initialize()
     dlTxParams_.resize(dlConnectedUe_.size(), UserTxParams());
 
     /* UPLINK */
-    EV << "UL CONNECTED: " << dlConnectedUe_.size() << endl;
+    EV_MAC << "UL CONNECTED: " << dlConnectedUe_.size() << endl;
 
     it = ulConnectedUe_.begin();
     et = ulConnectedUe_.end();
@@ -321,7 +323,7 @@ void LteAmc::initialize()
     ulTxParams_.resize(ulConnectedUe_.size(), UserTxParams());
 
     /* D2D */
-    EV << "D2D CONNECTED: " << d2dConnectedUe_.size() << endl;
+    EV_MAC << "D2D CONNECTED: " << d2dConnectedUe_.size() << endl;
 
     it = d2dConnectedUe_.begin();
     et = d2dConnectedUe_.end();
@@ -366,15 +368,22 @@ void LteAmc::rescaleMcs(double rePerRb, Direction dir)
     else if (dir == D2D) {
         d2dMcsTable_.rescale(rePerRb);
     }
+    computeCqiTables();
+}
+
+void LteAmc::computeCqiTables()
+{
+    dlCqiTbs_.compute(dlMcsTable_);
+    ulCqiTbs_.compute(ulMcsTable_);
 }
 
 /*******************************************
  *    Functions for feedback management    *
  *******************************************/
 
-void LteAmc::pushFeedback(MacNodeId id, Direction dir, LteFeedback fb)
+void LteAmc::pushFeedback(MacNodeId id, Direction dir, const LteFeedback& fb)
 {
-    EV << "Feedback from MacNodeId " << id << " (direction " << dirToA(dir) << ")" << endl;
+    EV_MAC << "Feedback from MacNodeId " << id << " (direction " << dirToA(dir) << ")" << endl;
 
     History_ *history;
     std::map<MacNodeId, unsigned int> *nodeIndex;
@@ -403,22 +412,22 @@ void LteAmc::pushFeedback(MacNodeId id, Direction dir, LteFeedback fb)
     }
     int index = (*nodeIndex).at(id);
 
-    EV << "ID: " << id << endl;
-    EV << "index: " << index << endl;
+    EV_MAC << "ID: " << id << endl;
+    EV_MAC << "index: " << index << endl;
     (*history)[antenna].at(index).at(txMode).put(fb);
 
     // DEBUG
 //    printFbhb(dir);
-    EV << "Antenna: " << dasToA(antenna) << ", TxMode: " << txMode << ", Index: " << index << endl;
-    EV << "RECEIVED" << endl;
+    EV_MAC << "Antenna: " << dasToA(antenna) << ", TxMode: " << txMode << ", Index: " << index << endl;
+    EV_MAC << "RECEIVED" << endl;
     fb.print(0,id,dir,"LteAmc::pushFeedback");
-//    EV << "SUMMARY" << endl;
+//    EV_MAC << "SUMMARY" << endl;
 //    (*history)[antenna].at(index).at(txMode).get().print(0,id,dir,txMode,"LteAmc::pushFeedback");
 }
 
-void LteAmc::pushFeedbackD2D(MacNodeId id, LteFeedback fb, MacNodeId peerId)
+void LteAmc::pushFeedbackD2D(MacNodeId id, const LteFeedback& fb, MacNodeId peerId)
 {
-    EV << "Feedback from MacNodeId " << id << " (direction D2D), peerId = " << peerId << endl;
+    EV_MAC << "Feedback from MacNodeId " << id << " (direction D2D), peerId = " << peerId << endl;
 
     std::map<MacNodeId, History_> *history = &d2dFeedbackHistory_;
     std::map<MacNodeId, unsigned int> *nodeIndex = &d2dNodeIndex_;
@@ -428,8 +437,8 @@ void LteAmc::pushFeedbackD2D(MacNodeId id, LteFeedback fb, MacNodeId peerId)
     TxMode txMode = fb.getTxMode();
     int index = (*nodeIndex).at(id);
 
-    EV << "ID: " << id << endl;
-    EV << "index: " << index << endl;
+    EV_MAC << "ID: " << id << endl;
+    EV_MAC << "index: " << index << endl;
 
     if (history->find(peerId) == history->end())
     {
@@ -448,17 +457,45 @@ void LteAmc::pushFeedbackD2D(MacNodeId id, LteFeedback fb, MacNodeId peerId)
     (*history)[peerId][antenna].at(index).at(txMode).put(fb);
 
     // DEBUG
-    EV << "PeerId: " << peerId << ", Antenna: " << dasToA(antenna) << ", TxMode: " << txMode << ", Index: " << index << endl;
-    EV << "RECEIVED" << endl;
+    EV_MAC << "PeerId: " << peerId << ", Antenna: " << dasToA(antenna) << ", TxMode: " << txMode << ", Index: " << index << endl;
+    EV_MAC << "RECEIVED" << endl;
     fb.print(0,id,D2D,"LteAmc::pushFeedbackD2D");
 }
 
+void LteAmc::pushFeedback(MacNodeId id, Direction dir, const LteFeedbackDoubleVector& fb)
+{
+    LteFeedbackDoubleVector::const_iterator it;
+    LteFeedbackVector::const_iterator jt;
+    for (it = fb.begin(); it != fb.end(); ++it)
+    {
+        for (jt = it->begin(); jt != it->end(); ++jt)
+        {
+            if (!jt->isEmptyFeedback())
+                pushFeedback(id, dir, *jt);
+        }
+    }
+}
+
+void LteAmc::pushFeedbackD2D(MacNodeId id, const LteFeedbackDoubleVector& fb, MacNodeId peerId)
+{
+    LteFeedbackDoubleVector::const_iterator it;
+    LteFeedbackVector::const_iterator jt;
+    for (it = fb.begin(); it != fb.end(); ++it)
+    {
+        for (jt = it->begin(); jt != it->end(); ++jt)
+        {
+            if (!jt->isEmptyFeedback())
+                pushFeedbackD2D(id, *jt, peerId);
+        }
+    }
+}
+
 
 LteSummaryFeedback LteAmc::getFeedback(MacNodeId id, Remote antenna, TxMode txMode, const Direction dir)
 {
     MacNodeId nh = getNextHop(id);
     if (id != nh)
-        EV << NOW << " LteAmc::getFeedback detected " << nh << " as nexthop for " << id << "\n";
+        EV_MAC << NOW << " LteAmc::getFeedback detected " << nh << " as nexthop for " << id << "\n";
     id = nh;
 
     if (dir == DL)
@@ -476,7 +513,7 @@ LteSummaryFeedback LteAmc::getFeedbackD2D(MacNodeId id, Remote antenna, TxMode t
     MacNodeId nh = getNextHop(id);
 
     if (id != nh)
-        EV << NOW << " LteAmc::getFeedbackD2D detected " << nh << " as nexthop for " << id << "\n";
+        EV_MAC << NOW << " LteAmc::getFeedbackD2D detected " << nh << " as nexthop for " << id << "\n";
     id = nh;
 
     if (peerId == 0)
@@ -532,7 +569,7 @@ bool LteAmc::existTxParams(MacNodeId id, const Direction dir)
 {
     MacNodeId nh = getNextHop(id);
     if (id != nh)
-        EV << NOW << " LteAmc::existTxparams detected " << nh << " as nexthop for " << id << "\n";
+        EV_MAC << NOW << " LteAmc::existTxparams detected " << nh << " as nexthop for " << id << "\n";
     id = nh;
 
     if (dir == DL)
@@ -551,7 +588,7 @@ const UserTxParams& LteAmc::setTxParams(MacNodeId id, const Direction dir, UserT
 {
     MacNodeId nh = getNextHop(id);
     if (id != nh)
-        EV << NOW << " LteAmc::setTxParams detected " << nh << " as nexthop for " << id << "\n";
+        EV_MAC << NOW << " LteAmc::setTxParams detected " << nh << " as nexthop for " << id << "\n";
     id = nh;
 
     info.isSet() = true;
@@ -563,12 +600,12 @@ const UserTxParams& LteAmc::setTxParams(MacNodeId id, const Direction dir, UserT
      */
 
     // DEBUG
-    EV << NOW << " LteAmc::setTxParams DAS antenna set for user " << id << " is \t";
+    EV_MAC << NOW << " LteAmc::setTxParams DAS antenna set for user " << id << " is \t";
     for (std::set<Remote>::const_iterator it = info.readAntennaSet().begin(); it != info.readAntennaSet().end(); ++it)
     {
-        EV << "[" << dasToA(*it) << "]\t";
+        EV_MAC << "[" << dasToA(*it) << "]\t";
     }
-    EV << endl;
+    EV_MAC << endl;
 
     if (dir == DL)
         return (dlTxParams_.at(dlNodeIndex_.at(id)) = info);
@@ -585,28 +622,28 @@ const UserTxParams& LteAmc::setTxParams(MacNodeId id, const Direction dir, UserT
 const UserTxParams& LteAmc::computeTxParams(MacNodeId id, const Direction dir)
 {
     // DEBUG
-    EV << NOW << " LteAmc::computeTxParams --------------::[ START ]::--------------\n";
-    EV << NOW << " LteAmc::computeTxParams CellId: " << cellId_ << "\n";
-    EV << NOW << " LteAmc::computeTxParams NodeId: " << id << "\n";
-    EV << NOW << " LteAmc::computeTxParams Direction: " << dirToA(dir) << "\n";
-    EV << NOW << " LteAmc::computeTxParams - - - - - - - - - - - - - - - - - - - - -\n";
-    EV << NOW << " LteAmc::computeTxParams RB allocation type: " << allocationTypeToA(allocationType_) << "\n";
-    EV << NOW << " LteAmc::computeTxParams - - - - - - - - - - - - - - - - - - - - -\n";
+    EV_MAC << NOW << " LteAmc::computeTxParams --------------::[ START ]::--------------\n";
+    EV_MAC << NOW << " LteAmc::computeTxParams CellId: " << cellId_ << "\n";
+    EV_MAC << NOW << " LteAmc::computeTxParams NodeId: " << id << "\n";
+    EV_MAC << NOW << " LteAmc::computeTxParams Direction: " << dirToA(dir) << "\n";
+    EV_MAC << NOW << " LteAmc::computeTxParams - - - - - - - - - - - - - - - - - - - - -\n";
+    EV_MAC << NOW << " LteAmc::computeTxParams RB allocation type: " << allocationTypeToA(allocationType_) << "\n";
+    EV_MAC << NOW << " LteAmc::computeTxParams - - - - - - - - - - - - - - - - - - - - -\n";
 
     MacNodeId nh = getNextHop(id);
     if(id != nh)
-    EV << NOW << " LteAmc::computeTxParams detected " << nh << " as nexthop for " << id << "\n";
+    EV_MAC << NOW << " LteAmc::computeTxParams detected " << nh << " as nexthop for " << id << "\n";
     id = nh;
 
     const UserTxParams &info = pilot_->computeTxParams(id,dir);
-    EV << NOW << " LteAmc::computeTxParams --------------::[  END  ]::--------------\n";
+    EV_MAC << NOW << " LteAmc::computeTxParams --------------::[  END  ]::--------------\n";
 
     return info;
 }
 
 void LteAmc::cleanAmcStructures(Direction dir, ActiveSet aUser)
 {
-    EV << NOW << " LteAmc::cleanAmcStructures. Direction " << dirToA(dir) << endl;
+    EV_MAC << NOW << " LteAmc::cleanAmcStructures. Direction " << dirToA(dir) << endl;
 
     //Convert from active cid to active users
     //Update active user for TMS algorithms
@@ -645,38 +682,29 @@ void LteAmc::cleanAmcStructures(Direction dir, ActiveSet aUser)
 
 unsigned int LteAmc::computeReqRbs(MacNodeId id, Band b, Codeword cw, unsigned int bytes, const Direction dir)
 {
-    EV << NOW << " LteAmc::getRbs Node " << id << ", Band " << b << ", Codeword " << cw << ", direction " << dirToA(dir) << endl;
+    EV_MAC << NOW << " LteAmc::getRbs Node " << id << ", Band " << b << ", Codeword " << cw << ", direction " << dirToA(dir) << endl;
 
     if(bytes == 0)
     {
         // DEBUG
-        EV << NOW << " LteAmc::getRbs Occupation: 0 bytes\n";
-        EV << NOW << " LteAmc::getRbs Number of RBs: 0\n";
+        EV_MAC << NOW << " LteAmc::getRbs Occupation: 0 bytes\n";
+        EV_MAC << NOW << " LteAmc::getRbs Number of RBs: 0\n";
 
         return 0;
     }
 
-    // Loading TBS vectors
-    const unsigned int* tbsVect;// it is a row of the itbs matrix
-    UserTxParams info = computeTxParams(id, dir);
+    const UserTxParams& info = computeTxParams(id, dir);
     unsigned char layers = info.getLayers().at(cw);
-
-    LteMod mod = info.getCwModulation(cw);
-    unsigned int iTbs = getItbsPerCqi(info.readCqiVector().at(cw), dir);
-    unsigned int i = (mod == _QPSK ? 0 : (mod == _16QAM ? 9 : (mod == _64QAM ? 15 : 0)));
-    tbsVect = itbs2tbs(mod, info.readTxMode(), layers, iTbs-i);
+    unsigned int row = getTbsRowPerCqi(info.readCqiVector().at(cw), dir);
 
     // Computing RB occupation
-    unsigned int j;
-    for(j = 0; j < 110; ++j)
-    if(tbsVect[j] >= bytes*8)
-    break;
+    unsigned int blocks = tbsTable_->reqRbs(info.readTxMode(), layers, row, bytes*8);
 
     // DEBUG
-    EV << NOW << " LteAmc::getRbs Occupation: " << bytes << " bytes , CQI : " << info.readCqiVector().at(cw) << " \n";
-    EV << NOW << " LteAmc::getRbs Number of RBs: " << j+1 << "\n";
+    EV_MAC << NOW << " LteAmc::getRbs Occupation: " << bytes << " bytes , CQI : " << info.readCqiVector().at(cw) << " \n";
+    EV_MAC << NOW << " LteAmc::getRbs Number of RBs: " << blocks << "\n";
 
-    return j+1;
+    return blocks;
 }
 
 unsigned int LteAmc::computeBitsOnNRbs(MacNodeId id, Band b, unsigned int blocks, const Direction dir)
@@ -688,14 +716,25 @@ unsigned int LteAmc::computeBitsOnNRbs(MacNodeId id, Band b, unsigned int blocks
         return 0;
 
     // DEBUG
-    EV << NOW << " LteAmc::blocks2bits Node: " << id << "\n";
-    EV << NOW << " LteAmc::blocks2bits Band: " << b << "\n";
-    EV << NOW << " LteAmc::blocks2bits Direction: " << dirToA(dir) << "\n";
+    EV_MAC << NOW << " LteAmc::blocks2bits Node: " << id << "\n";
+    EV_MAC << NOW << " LteAmc::blocks2bits Band: " << b << "\n";
+    EV_MAC << NOW << " LteAmc::blocks2bits Direction: " << dirToA(dir) << "\n";
 
     // Acquiring current user scheduling information
     const UserTxParams & info = computeTxParams(id, dir);
 
-    std::vector<unsigned char> layers = info.getLayers();
+    return computeBitsOnNRbs(info, blocks, dir);
+}
+
+unsigned int LteAmc::computeBitsOnNRbs(const UserTxParams& info, unsigned int blocks, const Direction dir)
+{
+    if (blocks > 110)    // Safety check to avoid segmentation fault
+        throw cRuntimeError("LteAmc::computeBitsOnNRbs(): Too many blocks");
+
+    if (blocks == 0)
+        return 0;
+
+    const std::vector<unsigned char>& layers = info.getLayers();
 
     unsigned int bits = 0;
     unsigned int codewords = layers.size();
@@ -704,30 +743,27 @@ unsigned int LteAmc::computeBitsOnNRbs(MacNodeId id, Band b, unsigned int blocks
         // if CQI == 0 the UE is out of range, thus bits=0
         if (info.readCqiVector().at(cw) == 0)
         {
-            EV << NOW << " LteAmc::blocks2bits - CQI equal to zero on cw " << cw << ", return no blocks available" << endl;
+            EV_MAC << NOW << " LteAmc::blocks2bits - CQI equal to zero on cw " << cw << ", return no blocks available" << endl;
             continue;
         }
 
-        LteMod mod = info.getCwModulation(cw);
-        unsigned int iTbs = getItbsPerCqi(info.readCqiVector().at(cw), dir);
-        unsigned int i = (mod == _QPSK ? 0 : (mod == _16QAM ? 9 : (mod == _64QAM ? 15 : 0)));
+        Cqi cqi = info.readCqiVector().at(cw);
+        unsigned int iTbs = getItbsPerCqi(cqi, dir);
 
         // DEBUG
-        EV << NOW << " LteAmc::blocks2bits ---::[ Codeword = " << cw << "\n";
-        EV << NOW << " LteAmc::blocks2bits Modulation: " << modToA(mod) << "\n";
-        EV << NOW << " LteAmc::blocks2bits iTbs: " << iTbs << "\n";
-        EV << NOW << " LteAmc::blocks2bits i: " << i << "\n";
-        EV << NOW << " LteAmc::blocks2bits CQI: " << info.readCqiVector().at(cw) << "\n";
+        EV_MAC << NOW << " LteAmc::blocks2bits ---::[ Codeword = " << cw << "\n";
+        EV_MAC << NOW << " LteAmc::blocks2bits Modulation: " << modToA(info.getCwModulation(cw)) << "\n";
+        EV_MAC << NOW << " LteAmc::blocks2bits iTbs: " << iTbs << "\n";
+        EV_MAC << NOW << " LteAmc::blocks2bits CQI: " << cqi << "\n";
 
         mac_->emitItbs(iTbs);
 
-        const unsigned int* tbsVect = itbs2tbs(mod, info.readTxMode(), layers.at(cw), iTbs-i);
-        bits += tbsVect[blocks-1];
+        bits += tbsTable_->bitsOnNRbs(info.readTxMode(), layers.at(cw), getTbsRowPerCqi(cqi, dir), blocks);
     }
 
             // DEBUG
-    EV << NOW << " LteAmc::blocks2bits Resource Blocks: " << blocks << "\n";
-    EV << NOW << " LteAmc::blocks2bits Available space: " << bits << "\n";
+    EV_MAC << NOW << " LteAmc::blocks2bits Resource Blocks: " << blocks << "\n";
+    EV_MAC << NOW << " LteAmc::blocks2bits Available space: " << bits << "\n";
 
     return bits;
 }
@@ -741,81 +777,82 @@ unsigned int LteAmc::computeBitsOnNRbs(MacNodeId id, Band b, Codeword cw, unsign
         return 0;
 
     // DEBUG
-    EV << NOW << " LteAmc::blocks2bits Node: " << id << "\n";
-    EV << NOW << " LteAmc::blocks2bits Band: " << b << "\n";
-    EV << NOW << " LteAmc::blocks2bits Codeword: " << cw << "\n";
-    EV << NOW << " LteAmc::blocks2bits Direction: " << dirToA(dir) << "\n";
+    EV_MAC << NOW << " LteAmc::blocks2bits Node: " << id << "\n";
+    EV_MAC << NOW << " LteAmc::blocks2bits Band: " << b << "\n";
+    EV_MAC << NOW << " LteAmc::blocks2bits Codeword: " << cw << "\n";
+    EV_MAC << NOW << " LteAmc::blocks2bits Direction: " << dirToA(dir) << "\n";
 
     // Acquiring current user scheduling information
-    UserTxParams info = computeTxParams(id, dir);
+    const UserTxParams& info = computeTxParams(id, dir);
 
     // if CQI == 0 the UE is out of range, thus return 0
-    if (info.readCqiVector().at(cw) == 0)
+    Cqi cqi = info.readCqiVector().at(cw);
+    if (cqi == 0)
     {
-        EV << NOW << " LteAmc::blocks2bits - CQI equal to zero, return no blocks available" << endl;
+        EV_MAC << NOW << " LteAmc::blocks2bits - CQI equal to zero, return no blocks available" << endl;
         return 0;
     }
     unsigned char layers = info.getLayers().at(cw);
 
-    unsigned int iTbs = getItbsPerCqi(info.readCqiVector().at(cw), dir);
-    LteMod mod = info.getCwModulation(cw);
-    unsigned int i = (mod == _QPSK ? 0 : (mod == _16QAM ? 9 : (mod == _64QAM ? 15 : 0)));
-
     // DEBUG
-    EV << NOW << " LteAmc::blocks2bits Modulation: " << modToA(mod) << "\n";
-    EV << NOW << " LteAmc::blocks2bits iTbs: " << iTbs << "\n";
-    EV << NOW << " LteAmc::blocks2bits i: " << i << "\n";
+    EV_MAC << NOW << " LteAmc::blocks2bits Modulation: " << modToA(info.getCwModulation(cw)) << "\n";
+    EV_MAC << NOW << " LteAmc::blocks2bits iTbs: " << getItbsPerCqi(cqi, dir) << "\n";
 
-    const unsigned int* tbsVect = itbs2tbs(mod, info.readTxMode(), layers, iTbs - i);
+    unsigned int bits = tbsTable_->bitsOnNRbs(info.readTxMode(), layers, getTbsRowPerCqi(cqi, dir), blocks);
 
     // DEBUG
-    EV << NOW << " LteAmc::blocks2bits Resource Blocks: " << blocks << "\n";
-    EV << NOW << " LteAmc::blocks2bits Available space: " << tbsVect[blocks-1] << "\n";
+    EV_MAC << NOW << " LteAmc::blocks2bits Resource Blocks: " << blocks << "\n";
+    EV_MAC << NOW << " LteAmc::blocks2bits Available space: " << bits << "\n";
 
-    return tbsVect[blocks - 1];
+    return bits;
 }
 
 unsigned int LteAmc::computeBytesOnNRbs(MacNodeId id, Band b, unsigned int blocks, const Direction dir)
 {
-    EV << NOW << " LteAmc::blocks2bytes Node " << id << ", Band " << b << ", direction " << dirToA(dir) << ", blocks " << blocks << "\n";
+    EV_MAC << NOW << " LteAmc::blocks2bytes Node " << id << ", Band " << b << ", direction " << dirToA(dir) << ", blocks " << blocks << "\n";
 
     unsigned int bits = computeBitsOnNRbs(id, b, blocks, dir);
     unsigned int bytes = bits/8;
 
     // DEBUG
-    EV << NOW << " LteAmc::blocks2bytes Resource Blocks: " << blocks << "\n";
-    EV << NOW << " LteAmc::blocks2bytes Available space: " << bits << "\n";
-    EV << NOW << " LteAmc::blocks2bytes Available space: " << bytes << "\n";
+    EV_MAC << NOW << " LteAmc::blocks2bytes Resource Blocks: " << blocks << "\n";
+    EV_MAC << NOW << " LteAmc::blocks2bytes Available space: " << bits << "\n";
+    EV_MAC << NOW << " LteAmc::blocks2bytes Available space: " << bytes << "\n";
 
     return bytes;
 }
 
+unsigned int LteAmc::computeBytesOnNRbs(const UserTxParams& info, unsigned int blocks, const Direction dir)
+{
+    return computeBitsOnNRbs(info, blocks, dir) / 8;
+}
+
 unsigned int LteAmc::computeBytesOnNRbs(MacNodeId id, Band b, Codeword cw, unsigned int blocks, const Direction dir)
 {
-    EV << NOW << " LteAmc::blocks2bytes Node " << id << ", Band " << b << ", Codeword " << cw << ",  direction " << dirToA(dir) << ", blocks " << blocks << "\n";
+    EV_MAC << NOW << " LteAmc::blocks2bytes Node " << id << ", Band " << b << ", Codeword " << cw << ",  direction " << dirToA(dir) << ", blocks " << blocks << "\n";
 
     unsigned int bits = computeBitsOnNRbs(id, b, cw, blocks, dir);
     unsigned int bytes = bits/8;
 
     // DEBUG
-    EV << NOW << " LteAmc::blocks2bytes Resource Blocks: " << blocks << "\n";
-    EV << NOW << " LteAmc::blocks2bytes Available space: " << bits << "\n";
-    EV << NOW << " LteAmc::blocks2bytes Available space: " << bytes << "\n";
+    EV_MAC << NOW << " LteAmc::blocks2bytes Resource Blocks: " << blocks << "\n";
+    EV_MAC << NOW << " LteAmc::blocks2bytes Available space: " << bits << "\n";
+    EV_MAC << NOW << " LteAmc::blocks2bytes Available space: " << bytes << "\n";
 
     return bytes;
 }
 
 unsigned int LteAmc::computeBytesOnNRbs_MB(MacNodeId id, Band b, unsigned int blocks, const Direction dir)
 {
-    EV << NOW << " LteAmc::computeBytesOnNRbs_MB Node " << id << ", Band " << b << ",  direction " << dirToA(dir) << ", blocks " << blocks << "\n";
+    EV_MAC << NOW << " LteAmc::computeBytesOnNRbs_MB Node " << id << ", Band " << b << ",  direction " << dirToA(dir) << ", blocks " << blocks << "\n";
 
     unsigned int bits = computeBitsOnNRbs_MB(id, b, blocks, dir);
     unsigned int bytes = bits/8;
 
     // DEBUG
-    EV << NOW << " LteAmc::computeBytesOnNRbs_MB Resource Blocks: " << blocks << "\n";
-    EV << NOW << " LteAmc::computeBytesOnNRbs_MB Available space: " << bits << "\n";
-    EV << NOW << " LteAmc::computeBytesOnNRbs_MB Available space: " << bytes << "\n";
+    EV_MAC << NOW << " LteAmc::computeBytesOnNRbs_MB Resource Blocks: " << blocks << "\n";
+    EV_MAC << NOW << " LteAmc::computeBytesOnNRbs_MB Available space: " << bits << "\n";
+    EV_MAC << NOW << " LteAmc::computeBytesOnNRbs_MB Available space: " << bytes << "\n";
 
     return bytes;
 
@@ -830,40 +867,33 @@ unsigned int LteAmc::computeBitsOnNRbs_MB(MacNodeId id, Band b,  unsigned int bl
         return 0;
 
     // DEBUG
-    EV << NOW << " LteAmc::computeBitsOnNRbs_MB Node: " << id << "\n";
-    EV << NOW << " LteAmc::computeBitsOnNRbs_MB Band: " << b << "\n";
-    EV << NOW << " LteAmc::computeBitsOnNRbs_MB Direction: " << dirToA(dir) << "\n";
+    EV_MAC << NOW << " LteAmc::computeBitsOnNRbs_MB Node: " << id << "\n";
+    EV_MAC << NOW << " LteAmc::computeBitsOnNRbs_MB Band: " << b << "\n";
+    EV_MAC << NOW << " LteAmc::computeBitsOnNRbs_MB Direction: " << dirToA(dir) << "\n";
 
     Cqi cqi = readMultiBandCqi(id,dir)[b];
 
     // Acquiring current user scheduling information
-    UserTxParams info = computeTxParams(id, dir);
-
-    std::vector<unsigned char> layers = info.getLayers();
+    const UserTxParams& info = computeTxParams(id, dir);
 
     // if CQI == 0 the UE is out of range, thus return 0
     if (cqi == 0)
     {
-        EV << NOW << " LteAmc::computeBitsOnNRbs_MB - CQI equal to zero, return no blocks available" << endl;
+        EV_MAC << NOW << " LteAmc::computeBitsOnNRbs_MB - CQI equal to zero, return no blocks available" << endl;
         return 0;
     }
 
-    unsigned int iTbs = getItbsPerCqi(cqi, dir);
-    LteMod mod = cqiTable[cqi].mod_;
-    unsigned int i = (mod == _QPSK ? 0 : (mod == _16QAM ? 9 : (mod == _64QAM ? 15 : 0)));
-
     // DEBUG
-    EV << NOW << " LteAmc::computeBitsOnNRbs_MB Modulation: " << modToA(mod) << "\n";
-    EV << NOW << " LteAmc::computeBitsOnNRbs_MB iTbs: " << iTbs << "\n";
-    EV << NOW << " LteAmc::computeBitsOnNRbs_MB i: " << i << "\n";
+    EV_MAC << NOW << " LteAmc::computeBitsOnNRbs_MB Modulation: " << modToA(cqiTable[cqi].mod_) << "\n";
+    EV_MAC << NOW << " LteAmc::computeBitsOnNRbs_MB iTbs: " << getItbsPerCqi(cqi, dir) << "\n";
 
-    const unsigned int* tbsVect = itbs2tbs(mod, TRANSMIT_DIVERSITY, layers[0], iTbs - i);
+    unsigned int bits = tbsTable_->bitsOnNRbs(TRANSMIT_DIVERSITY, info.getLayers().at(0), getTbsRowPerCqi(cqi, dir), blocks);
 
     // DEBUG
-    EV << NOW << " LteAmc::computeBitsOnNRbs_MB Resource Blocks: " << blocks << "\n";
-    EV << NOW << " LteAmc::computeBitsOnNRbs_MB Available space: " << tbsVect[blocks-1] << "\n";
+    EV_MAC << NOW << " LteAmc::computeBitsOnNRbs_MB Resource Blocks: " << blocks << "\n";
+    EV_MAC << NOW << " LteAmc::computeBitsOnNRbs_MB Available space: " << bits << "\n";
 
-    return tbsVect[blocks - 1];
+    return bits;
 
 }
 
@@ -880,58 +910,29 @@ bool LteAmc::getPilotUsableBands(MacNodeId id, std::vector<unsigned short>*& usa
 
 unsigned int LteAmc::getItbsPerCqi(Cqi cqi, const Direction dir)
 {
-    // CQI threshold table selection
-    McsTable* mcsTable;
     if (dir == DL)
-        mcsTable = &dlMcsTable_;
+        return dlCqiTbs_.itbs(cqi);
     else if ((dir == UL) || (dir == D2D) || (dir == D2D_MULTI))
-        mcsTable = &ulMcsTable_;
+        return ulCqiTbs_.itbs(cqi);
     else
-    {
         throw cRuntimeError("LteAmc::getItbsPerCqi(): Unrecognized direction");
-    }
-    CQIelem entry = cqiTable[cqi];
-    LteMod mod = entry.mod_;
-    double rate = entry.rate_;
-
-    // Select the ranges for searching in the McsTable.
-    unsigned int min = 0; // _QPSK
-    unsigned int max = 9; // _QPSK
-    if (mod == _16QAM)
-    {
-        min = 10;
-        max = 16;
-    }
-    if (mod == _64QAM)
-    {
-        min = 17;
-        max = 28;
-    }
-
-    // Initialize the working variables at the minimum value.
-    MCSelem elem = mcsTable->at(min);
-    unsigned int iTbs = elem.iTbs_;
-
-    // Search in the McsTable from min to max until the rate exceeds
-    // the threshold in an entry of the table.
-    for (unsigned int i = min; i <= max; i++)
-    {
-        elem = mcsTable->at(i);
-        if (elem.threshold_ <= rate)
-            iTbs = elem.iTbs_;
-        else
-            break;
-    }
+}
 
-    // Return the iTbs found.
-    return iTbs;
+unsigned int LteAmc::getTbsRowPerCqi(Cqi cqi, const Direction dir)
+{
+    if (dir == DL)
+        return dlCqiTbs_.row(cqi);
+    else if ((dir == UL) || (dir == D2D) || (dir == D2D_MULTI))
+        return ulCqiTbs_.row(cqi);
+    else
+        throw cRuntimeError("LteAmc::getTbsRowPerCqi(): Unrecognized direction");
 }
 
 const UserTxParams& LteAmc::getTxParams(MacNodeId id, const Direction dir)
 {
     MacNodeId nh = getNextHop(id);
     if (id != nh)
-        EV << NOW << " LteAmc::getTxParams detected " << nh << " as nexthop for " << id << "\n";
+        EV_MAC << NOW << " LteAmc::getTxParams detected " << nh << " as nexthop for " << id << "\n";
     id = nh;
 
     if (dir == DL)
@@ -978,10 +979,8 @@ double LteAmc::readCoderate(MacNodeId id, Codeword cw, unsigned int bytes, const
     unsigned int codewords = layers.size();
     for (Codeword c = 0; c < codewords; ++c)
     {
-        LteMod mod = info.getCwModulation(c);
-        unsigned int iTbs = getItbsPerCqi(info.readCqiVector().at(c), dir);
-        unsigned int i = (mod == _QPSK ? 0 : (mod == _16QAM ? 9 : (mod == _64QAM ? 15 : 0)));
-        tbsVect.push_back(itbs2tbs(mod, info.readTxMode(), layers.at(c), iTbs - i));
+        unsigned int row = getTbsRowPerCqi(info.readCqiVector().at(c), dir);
+        tbsVect.push_back(tbsTable_->row(info.readTxMode(), layers.at(c), row));
     }
 
     // Computing RB occupation
@@ -1140,7 +1139,7 @@ Cqi LteAmc::readWbCqi(const CqiVector& cqi)
     unsigned int bands = cqi.size();
     for (Band b = 0; b < bands; ++b)
     {
-        EV << "LteAmc::getWbCqi - Cqi " << cqi.at(b) << " on band " << (int)b << endl;
+        EV_MAC << "LteAmc::getWbCqi - Cqi " << cqi.at(b) << " on band " << (int)b << endl;
 
         cqiCounter += cqi.at(b);
         cqiMin = cqiMin < cqi.at(b) ? cqiMin : cqi.at(b);
@@ -1152,7 +1151,7 @@ Cqi LteAmc::readWbCqi(const CqiVector& cqi)
         // is the module lower than the half of the divisor ? ceil, otherwise floor
     cqiMean = (double) (cqiCounter % bands) > (double) bands / 2.0 ? cqiCounter / bands + 1 : cqiCounter / bands;
 
-    EV << "LteAmc::getWbCqi - Cqi mean " << cqiMean << " minimum " << cqiMin << " maximum " << cqiMax << endl;
+    EV_MAC << "LteAmc::getWbCqi - Cqi mean " << cqiMean << " minimum " << cqiMin << " maximum " << cqiMax << endl;
 
     // the 0.0 weight is used in order to obtain the mean
     if (cqiComputationWeight_ == 0.0)
@@ -1184,7 +1183,7 @@ Cqi LteAmc::readWbCqi(const CqiVector& cqi)
         throw cRuntimeError("LteAmc::getWbCqi(): Unknown weight %d", cqiComputationWeight_);
     }
 
-    EV << "LteAmc::getWbCqi - Cqi " << cqiRet << " evaluated\n";
+    EV_MAC << "LteAmc::getWbCqi - Cqi " << cqiRet << " evaluated\n";
 
     return cqiRet;
 }
@@ -1259,7 +1258,7 @@ Pmi LteAmc::readWbPmi(const PmiVector& pmi)
         throw cRuntimeError("LteAmc::readWbPmi(): Unknown weight %d", pmiComputationWeight_);
     }
 
-    EV << "LteAmc::getWbPmi - Pmi " << pmiRet << " evaluated\n";
+    EV_MAC << "LteAmc::getWbPmi - Pmi " << pmiRet << " evaluated\n";
 
     return pmiRet;
 }
@@ -1270,9 +1269,9 @@ Pmi LteAmc::readWbPmi(const PmiVector& pmi)
 
 void LteAmc::detachUser(MacNodeId nodeId, Direction dir)
 {
-    EV << "##################################" << endl;
-    EV << "# LteAmc::detachUser. Id: " << nodeId << ", direction: " << dirToA(dir) << endl;
-    EV << "##################################" << endl;
+    EV_MAC << "##################################" << endl;
+    EV_MAC << "# LteAmc::detachUser. Id: " << nodeId << ", direction: " << dirToA(dir) << endl;
+    EV_MAC << "##################################" << endl;
     try
     {
         ConnectedUesMap *connectedUe;
@@ -1349,9 +1348,9 @@ void LteAmc::detachUser(MacNodeId nodeId, Direction dir)
 
 void LteAmc::attachUser(MacNodeId nodeId, Direction dir)
 {
-    EV << "##################################" << endl;
-    EV << "# LteAmc::attachUser. Id: " << nodeId << ", direction: " << dirToA(dir) << endl;
-    EV << "##################################" << endl;
+    EV_MAC << "##################################" << endl;
+    EV_MAC << "# LteAmc::attachUser. Id: " << nodeId << ", direction: " << dirToA(dir) << endl;
+    EV_MAC << "##################################" << endl;
 
     ConnectedUesMap *connectedUe;
     std::map<MacNodeId, unsigned int> *nodeIndexMap;
@@ -1407,7 +1406,7 @@ void LteAmc::attachUser(MacNodeId nodeId, Direction dir)
     // check if the UE is known (it has been here before)
     if( (*connectedUe).find(nodeId) != (*connectedUe).end() )
     {
-        EV << "LteAmc::attachUser. Id " << nodeId << " is known (he has been here before)." << endl;
+        EV_MAC << "LteAmc::attachUser. Id " << nodeId << " is known (he has been here before)." << endl;
 
         // user is known, get his index
         nodeIndex = (*nodeIndexMap).at(nodeId);
@@ -1443,7 +1442,7 @@ void LteAmc::attachUser(MacNodeId nodeId, Direction dir)
     }
     else
     {
-        EV << "LteAmc::attachUser. Id " << nodeId << " is not known (it is the first time we see him)." << endl;
+        EV_MAC << "LteAmc::attachUser. Id " << nodeId << " is not known (it is the first time we see him)." << endl;
 
         // new user: [] operator insert a new element in the map
         (*nodeIndexMap)[nodeId] = (*revIndexVec).size();
@@ -1486,8 +1485,8 @@ void LteAmc::attachUser(MacNodeId nodeId, Direction dir)
 
 void LteAmc::testUe(MacNodeId nodeId, Direction dir)
 {
-    EV << "##################################" << endl;
-    EV << "LteAmc::testUe (" << dirToA(dir) << ")" << endl;
+    EV_MAC << "##################################" << endl;
+    EV_MAC << "LteAmc::testUe (" << dirToA(dir) << ")" << endl;
 
     ConnectedUesMap *connectedUe;
     std::map<MacNodeId, unsigned int> *nodeIndexMap;
@@ -1533,10 +1532,10 @@ void LteAmc::testUe(MacNodeId nodeId, Direction dir)
     bool isConnected = (*connectedUe).at(nodeId);
     MacNodeId revIndex = (*revIndexVec).at(nodeIndex);
 
-    EV << "Id: " << nodeId << endl;
-    EV << "Index: " << nodeIndex << endl;
-    EV << "Reverse index: " << revIndex << " (should be the same of ID)" << endl;
-    EV << "Is connected: " << (isConnected?"TRUE":"FALSE") << endl;
+    EV_MAC << "Id: " << nodeId << endl;
+    EV_MAC << "Index: " << nodeIndex << endl;
+    EV_MAC << "Reverse index: " << revIndex << " (should be the same of ID)" << endl;
+    EV_MAC << "Is connected: " << (isConnected?"TRUE":"FALSE") << endl;
 
     if(!isConnected)
     return;
@@ -1544,7 +1543,7 @@ void LteAmc::testUe(MacNodeId nodeId, Direction dir)
     // If connected compute and print user transmission parameters and history
     computeTxParams(nodeId,dir);
     UserTxParams info = (*userInfoVec).at(nodeIndex);
-    EV << "UserTxParams" << endl;
+    EV_MAC << "UserTxParams" << endl;
     info.print("LteAmc::testUe");
 
     if (dir == UL || dir == DL)
@@ -1553,10 +1552,10 @@ void LteAmc::testUe(MacNodeId nodeId, Direction dir)
         RemoteSet::iterator et = remoteSet_.end();
         std::vector<LteSummaryBuffer> feedback;
 
-        EV << "History" << endl;
+        EV_MAC << "History" << endl;
         for(; it!=et; it++ )
         {
-            EV << "Remote: " << dasToA(*it) << endl;
+            EV_MAC << "Remote: " << dasToA(*it) << endl;
             feedback = (*history).at(*it).at(nodeIndex);
             for(int i=0; i<numTxModes; i++)
             {
@@ -1579,10 +1578,10 @@ void LteAmc::testUe(MacNodeId nodeId, Direction dir)
             RemoteSet::iterator et = remoteSet_.end();
             std::vector<LteSummaryBuffer> feedback;
 
-            EV << "History" << endl;
+            EV_MAC << "History" << endl;
             for(; it!=et; it++ )
             {
-                EV << "Remote: " << dasToA(*it) << endl;
+                EV_MAC << "Remote: " << dasToA(*it) << endl;
                 feedback = (*history).at(*it).at(nodeIndex);
                 for(int i=0; i<numTxModes; i++)
                 {
@@ -1596,5 +1595,5 @@ void LteAmc::testUe(MacNodeId nodeId, Direction dir)
             }
         }
     }
-    EV << "##################################" << endl;
+    EV_MAC << "##################################" << endl;
 }
@@ -37,6 +37,7 @@ class SIMULTE_API LteAmc
 {
   private:
     AmcPilot *getAmcPilot(const omnetpp::cPar& amcMode);
+    void computeCqiTables();
     MacNodeId getNextHop(MacNodeId dst);
     public:
     void printParameters();
@@ -58,6 +59,10 @@ class SIMULTE_API LteAmc
     double mcsScaleDl_;
     double mcsScaleUl_;
     double mcsScaleD2D_;
+    // CQI -> I-TBS and CQI -> TBS table row, per direction (UL is used also for D2D)
+    CqiTbsMap dlCqiTbs_;
+    CqiTbsMap ulCqiTbs_;
+    const TbsTable* tbsTable_;
     int numAntennas_;
     RemoteSet remoteSet_;
     Cqi kCqi_;
@@ -105,8 +110,11 @@ class SIMULTE_API LteAmc
     // CodeRate MCS rescaling
     void rescaleMcs(double rePerRb, Direction dir = DL);
 
-    void pushFeedback(MacNodeId id, Direction dir, LteFeedback fb);
-    void pushFeedbackD2D(MacNodeId id, LteFeedback fb, MacNodeId peerId);
+    void pushFeedback(MacNodeId id, Direction dir, const LteFeedback& fb);
+    void pushFeedbackD2D(MacNodeId id, const LteFeedback& fb, MacNodeId peerId);
+    //! Push all the non-empty feedbacks of a report (one vector of txmodes per remote)
+    void pushFeedback(MacNodeId id, Direction dir, const LteFeedbackDoubleVector& fb);
+    void pushFeedbackD2D(MacNodeId id, const LteFeedbackDoubleVector& fb, MacNodeId peerId);
     LteSummaryFeedback getFeedback(MacNodeId id, Remote antenna, TxMode txMode, const Direction dir);
     LteSummaryFeedback getFeedbackD2D(MacNodeId id, Remote antenna, TxMode txMode, MacNodeId peerId);
 
@@ -136,6 +144,9 @@ class SIMULTE_API LteAmc
     unsigned int computeBitsOnNRbs(MacNodeId id, Band b, Codeword cw, unsigned int blocks, const Direction dir);
     unsigned int computeBytesOnNRbs(MacNodeId id, Band b, unsigned int blocks, const Direction dir);
     unsigned int computeBytesOnNRbs(MacNodeId id, Band b, Codeword cw, unsigned int blocks, const Direction dir);
+    // same as above, for all the codewords of already computed tx params (avoids the tx params lookup)
+    unsigned int computeBitsOnNRbs(const UserTxParams& info, unsigned int blocks, const Direction dir);
+    unsigned int computeBytesOnNRbs(const UserTxParams& info, unsigned int blocks, const Direction dir);
 
     // multiband version of the above function. It returns the number of bytes that can fit in the given "blocks" of the given "band"
     unsigned int computeBytesOnNRbs_MB(MacNodeId id, Band b, unsigned int blocks, const Direction dir);
@@ -145,6 +156,8 @@ class SIMULTE_API LteAmc
 
     // utilities - do not involve pilot invocation
     unsigned int getItbsPerCqi(Cqi cqi, const Direction dir);
+    // row of the flat TBS table (see TbsTable) used for the given CQI
+    unsigned int getTbsRowPerCqi(Cqi cqi, const Direction dir);
 
     double readCoderate(MacNodeId id, Codeword cw, unsigned int bytes, const Direction dir);
 
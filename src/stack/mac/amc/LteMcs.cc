@@ -7,6 +7,7 @@
 // and cannot be removed from it.
 //
 
+#include <algorithm>
 #include "stack/mac/amc/LteMcs.h"
 
 using namespace omnetpp;
@@ -319,6 +320,159 @@ const unsigned int* itbs2tbs(LteMod mod, TxMode txMode, unsigned char layers, un
     return res;
 }
 
+/********************************************
+ *      FLAT TBS LOOKUP SURFACE
+ ********************************************/
+
+TbsTable::TbsTable()
+{
+    const unsigned char layers[LAYER_GROUPS] = { 1, 2, 4 };
+    const LteMod mods[3] = { _QPSK, _16QAM, _64QAM };
+    const unsigned int firstItbs[3] = { 0, 9, 15 };
+    const unsigned int rows[3] = { 10, 7, 12 };
+
+    for (unsigned int g = 0; g < LAYER_GROUPS; ++g)
+    {
+        unsigned int r = 0;
+        for (unsigned int m = 0; m < 3; ++m)
+        {
+            for (unsigned int k = 0; k < rows[m]; ++k, ++r)
+            {
+                const unsigned int* tbsVect = itbs2tbs(mods[m], OL_SPATIAL_MULTIPLEXING, layers[g], k);
+                unsigned int max = 0;
+                for (unsigned int b = 0; b < TBS_MAX_RBS; ++b)
+                {
+                    tbs_[g][r][b] = tbsVect[b];
+                    max = std::max(max, tbsVect[b]);
+                    maxTbs_[g][r][b] = max;
+                }
+                ASSERT(r == rowIndex(mods[m], firstItbs[m] + k));
+            }
+        }
+    }
+}
+
+const TbsTable& TbsTable::instance()
+{
+    static const TbsTable table;
+    return table;
+}
+
+unsigned int TbsTable::layerGroup(TxMode txMode, unsigned char layers)
+{
+    if (layers == 1 || (txMode != OL_SPATIAL_MULTIPLEXING && txMode != CL_SPATIAL_MULTIPLEXING))
+        return 0;
+    if (layers == 2)
+        return 1;
+    if (layers == 4)
+        return 2;
+    throw cRuntimeError("Illegal number of layers (%d) in TbsTable::layerGroup()", layers);
+}
+
+unsigned int TbsTable::rowIndex(LteMod mod, unsigned int iTbs)
+{
+    switch (mod)
+    {
+        case _QPSK:
+            if (iTbs <= 9)
+                return iTbs;
+            break;
+        case _16QAM:
+            if (iTbs >= 9 && iTbs <= 15)
+                return iTbs + 1;
+            break;
+        case _64QAM:
+            if (iTbs >= 15 && iTbs <= 26)
+                return iTbs + 2;
+            break;
+        default:
+            throw cRuntimeError("Unknown MCS (%d) in TbsTable::rowIndex()", mod);
+    }
+    throw cRuntimeError("Invalid I-TBS %d for modulation %s in TbsTable::rowIndex()", iTbs, modToA(mod).c_str());
+}
+
+unsigned int TbsTable::sidelinkRowIndex(unsigned int mcs)
+{
+    if (mcs <= 9)
+        return rowIndex(_QPSK, mcs);
+    if (mcs <= 16)
+        return rowIndex(_16QAM, std::min(mcs, 15u));
+    return rowIndex(_64QAM, std::min(mcs, 26u));
+}
+
+unsigned int TbsTable::bitsOnNRbs(TxMode txMode, unsigned char layers, unsigned int rowIndex, unsigned int blocks) const
+{
+    if (blocks > TBS_MAX_RBS)    // Safety check to avoid segmentation fault
+        throw cRuntimeError("TbsTable::bitsOnNRbs(): Too many blocks (%d)", blocks);
+    if (blocks == 0)
+        return 0;
+    return tbs_[layerGroup(txMode, layers)][rowIndex][blocks - 1];
+}
+
+unsigned int TbsTable::reqRbs(TxMode txMode, unsigned char layers, unsigned int rowIndex, unsigned int bits) const
+{
+    const unsigned int* max = maxTbs_[layerGroup(txMode, layers)][rowIndex];
+    return (std::lower_bound(max, max + TBS_MAX_RBS, bits) - max) + 1;
+}
+
+/********************************************
+ *      CQI TO I-TBS MAPPING
+ ********************************************/
+
+CqiTbsMap::CqiTbsMap()
+{
+    std::fill(itbs_, itbs_ + MAXCQI + 1, 0);
+    std::fill(row_, row_ + MAXCQI + 1, 0);
+}
+
+void CqiTbsMap::compute(McsTable& mcsTable)
+{
+    for (Cqi cqi = 0; cqi <= MAXCQI; ++cqi)
+    {
+        itbs_[cqi] = searchItbs(cqi, mcsTable);
+        row_[cqi] = TbsTable::rowIndex(cqiTable[cqi].mod_, itbs_[cqi]);
+    }
+}
+
+unsigned int CqiTbsMap::searchItbs(Cqi cqi, McsTable& mcsTable)
+{
+    CQIelem entry = cqiTable[cqi];
+    LteMod mod = entry.mod_;
+    double rate = entry.rate_;
+
+    // Select the ranges for searching in the McsTable.
+    unsigned int min = 0; // _QPSK
+    unsigned int max = 9; // _QPSK
+    if (mod == _16QAM)
+    {
+        min = 10;
+        max = 16;
+    }
+    if (mod == _64QAM)
+    {
+        min = 17;
+        max = 28;
+    }
+
+    // Initialize the working variables at the minimum value.
+    MCSelem elem = mcsTable.at(min);
+    unsigned int iTbs = elem.iTbs_;
+
+    // Search in the McsTable from min to max until the rate exceeds
+    // the threshold in an entry of the table.
+    for (unsigned int i = min; i <= max; i++)
+    {
+        elem = mcsTable.at(i);
+        if (elem.threshold_ <= rate)
+            iTbs = elem.iTbs_;
+        else
+            break;
+    }
+
+    // Return the iTbs found.
+    return iTbs;
+}
+
 std::vector<unsigned char> cwMapping(const TxMode& txMode, const Rank& ri, const unsigned int antennaPorts)
 {
     std::vector<unsigned char> res;
@@ -102,6 +102,103 @@ extern const unsigned int itbs2tbs_64qam8[][110];
  */
 const unsigned int* itbs2tbs(LteMod mod, TxMode txMode, unsigned char layers, unsigned char itbs);
 
+/// Number of resource blocks covered by each row of the itbs2tbs tables
+const unsigned int TBS_MAX_RBS = 110;
+
+/**
+ * Flat TBS lookup surface, indexed by [layers][row][blocks-1].
+ *
+ * A row is identified by a modulation and an I-TBS in the range covered by
+ * that modulation's itbs2tbs table (QPSK 0-9, 16QAM 9-15, 64QAM 15-26); the
+ * 29 rows laid out in this order coincide with the MCS index space (0-28).
+ * Layer groups are 1, 2 and 4 layers; as in itbs2tbs(), tx modes other than
+ * spatial multiplexing always use the single-layer rows.
+ *
+ * The table is built once from the itbs2tbs tables and shared by all modules.
+ * Besides the TBS it stores the running maximum of each row, so that the
+ * inverse lookup (blocks needed for a given size) is a binary search that
+ * returns the same result as a linear scan for the first entry not smaller
+ * than the requested size, even on the rows that are not monotone.
+ */
+class SIMULTE_API TbsTable
+{
+    /// Number of layer groups (1, 2 and 4 layers)
+    static const unsigned int LAYER_GROUPS = 3;
+
+    unsigned int tbs_[LAYER_GROUPS][CQI2ITBSSIZE][TBS_MAX_RBS];
+    unsigned int maxTbs_[LAYER_GROUPS][CQI2ITBSSIZE][TBS_MAX_RBS];
+
+    TbsTable();
+
+  public:
+    /// Returns the shared instance, building it on first use
+    static const TbsTable& instance();
+
+    /// Returns the layer group used for the given tx mode and number of layers
+    static unsigned int layerGroup(TxMode txMode, unsigned char layers);
+
+    /// Returns the row of the given I-TBS within the given modulation
+    static unsigned int rowIndex(LteMod mod, unsigned int iTbs);
+
+    /**
+     * Returns the row used by the sidelink for the given PSSCH MCS: the
+     * modulation is derived from the MCS range and the MCS itself is taken as
+     * I-TBS, clamped to the range of that modulation.
+     */
+    static unsigned int sidelinkRowIndex(unsigned int mcs);
+
+    /// Returns the TBS row (indexed by blocks-1) for the given parameters
+    const unsigned int* row(TxMode txMode, unsigned char layers, unsigned int rowIndex) const
+    {
+        return tbs_[layerGroup(txMode, layers)][rowIndex];
+    }
+
+    /// Returns the number of bits carried by the given number of blocks (0 if blocks is 0)
+    unsigned int bitsOnNRbs(TxMode txMode, unsigned char layers, unsigned int rowIndex, unsigned int blocks) const;
+
+    /**
+     * Returns the number of blocks needed to carry the given number of bits,
+     * i.e. one plus the index of the first entry of the row not smaller than
+     * bits, or TBS_MAX_RBS + 1 if the bits do not fit in any allocation.
+     */
+    unsigned int reqRbs(TxMode txMode, unsigned char layers, unsigned int rowIndex, unsigned int bits) const;
+};
+
+/**
+ * CQI -> I-TBS and CQI -> TbsTable row mapping for an MCS table.
+ *
+ * The I-TBS of a CQI is the one of the highest MCS, within the range of the
+ * CQI's modulation, whose code rate threshold does not exceed the code rate
+ * of the CQI. The mapping depends on the (possibly rescaled) MCS table only,
+ * so it is computed once per table and recomputed when the table is rescaled.
+ */
+class SIMULTE_API CqiTbsMap
+{
+    unsigned int itbs_[MAXCQI + 1];
+    unsigned int row_[MAXCQI + 1];
+
+  public:
+    CqiTbsMap();
+
+    /// Recomputes the mapping for the given MCS table
+    void compute(McsTable& mcsTable);
+
+    /// Returns the I-TBS of the given CQI
+    unsigned int itbs(Cqi cqi) const
+    {
+        return itbs_[cqi];
+    }
+
+    /// Returns the TbsTable row of the given CQI
+    unsigned int row(Cqi cqi) const
+    {
+        return row_[cqi];
+    }
+
+    /// Searches the MCS table for the I-TBS of the given CQI
+    static unsigned int searchItbs(Cqi cqi, McsTable& mcsTable);
+};
+
 /**
  * Gives the number of layers for each codeword.
  * @param txMode The transmission mode.
@@ -19,11 +19,6 @@ LteMacBuffer::LteMacBuffer()
     Queue_.clear();
 }
 
-LteMacBuffer::LteMacBuffer(const LteMacQueue& queue)
-{
-    operator=(queue);
-}
-
 LteMacBuffer::~LteMacBuffer()
 {
     Queue_.clear();
@@ -46,14 +41,14 @@ void LteMacBuffer::pushBack(PacketInfo pkt)
 {
     queueLength_++;
     queueOccupancy_ += pkt.first;
-    Queue_.push_back(pkt);
+    Queue_.pushBack(pkt);
 }
 
 void LteMacBuffer::pushFront(PacketInfo pkt)
 {
     queueLength_++;
     queueOccupancy_ += pkt.first;
-    Queue_.push_front(pkt);
+    Queue_.pushFront(pkt);
 }
 
 PacketInfo LteMacBuffer::popFront()
@@ -61,8 +56,7 @@ PacketInfo LteMacBuffer::popFront()
     if (queueLength_ <= 0)
         throw cRuntimeError("Packet queue empty");
 
-    PacketInfo pkt = Queue_.front();
-    Queue_.pop_front();
+    PacketInfo pkt = Queue_.popFront();
     processed_++;
     queueLength_--;
     queueOccupancy_ -= pkt.first;
@@ -74,13 +68,38 @@ PacketInfo LteMacBuffer::popBack()
     if (queueLength_ <= 0)
         throw cRuntimeError("Packet queue empty");
 
-    PacketInfo pkt = Queue_.back();
-    Queue_.pop_back();
+    PacketInfo pkt = Queue_.popBack();
     queueLength_--;
     queueOccupancy_ -= pkt.first;
     return pkt;
 }
 
+unsigned int LteMacBuffer::consumeFront(unsigned int bytes)
+{
+    while (queueLength_ > 0 && bytes > 0)
+    {
+        PacketInfo& pkt = Queue_.front();
+        unsigned int pktSize = pkt.first;
+        processed_++;
+        if (pktSize <= bytes)
+        {
+            // serve the entire packet
+            bytes -= pktSize;
+            queueOccupancy_ -= pktSize;
+            queueLength_--;
+            Queue_.popFront();
+        }
+        else
+        {
+            // serve the packet partially, in place
+            pkt.first = pktSize - bytes;
+            queueOccupancy_ -= bytes;
+            bytes = 0;
+        }
+    }
+    return bytes;
+}
+
 PacketInfo& LteMacBuffer::front()
 {
     if (queueLength_ <= 0)
@@ -112,12 +131,6 @@ unsigned int LteMacBuffer::getProcessed() const
     return processed_;
 }
 
-const std::list<PacketInfo>*
-LteMacBuffer::getPacketlist() const
-{
-    return &Queue_;
-}
-
 unsigned int LteMacBuffer::getQueueOccupancy() const
 {
     return queueOccupancy_;
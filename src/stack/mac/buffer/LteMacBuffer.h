@@ -12,12 +12,15 @@
 
 #include <omnetpp.h>
 #include "common/LteCommon.h"
-
-class LteMacQueue;
+#include "stack/mac/buffer/LteRingBuffer.h"
 
 /**
  * @class LteMacBuffer
  * @brief  Buffers for MAC packets
+ *
+ * Packet infos are stored in a ring buffer, so that the per-TTI
+ * operations of the schedulers (serving the head, partially or
+ * entirely) neither allocate nor free memory.
  */
 class SIMULTE_API LteMacBuffer
 {
@@ -33,7 +36,6 @@ class SIMULTE_API LteMacBuffer
      * Copy Constructors
      */
 
-    LteMacBuffer(const LteMacQueue& queue);
     LteMacBuffer& operator=(const LteMacBuffer& queue);
     LteMacBuffer* dup() const;
 
@@ -72,6 +74,21 @@ class SIMULTE_API LteMacBuffer
      */
     PacketInfo popBack();
 
+    /**
+     * consumeFront() serves the given amount of bytes
+     * starting from the front of the queue: packets that
+     * are entirely served are removed, while a partially
+     * served head packet is shrunk in place, keeping its
+     * timestamp.
+     * NOTE: This function increases the processed_ variable
+     * for each (entirely or partially) served packet.
+     *
+     * @param bytes number of bytes to serve
+     * @return number of bytes left unserved (non-zero
+     *             only if the queue has been emptied)
+     */
+    unsigned int consumeFront(unsigned int bytes);
+
     /**
      * front() returns the  packet in front
      * of the queue without performing actual extraction.
@@ -138,11 +155,6 @@ class SIMULTE_API LteMacBuffer
      */
     unsigned int getProcessed() const;
 
-    /**
-     * Get direct (readonly) access to pdu list
-     */
-    const std::list<PacketInfo>* getPacketlist() const;
-
     friend std::ostream &operator << (std::ostream &stream, const LteMacQueue* queue);
 
   private:
@@ -155,8 +167,8 @@ class SIMULTE_API LteMacBuffer
     /// Number of queued  packets
     int queueLength_;
 
-    /// List of  packets
-    std::list<PacketInfo> Queue_;
+    /// Ring of  packets
+    LteRingBuffer<PacketInfo> Queue_;
 };
 
 #endif
@@ -8,6 +8,7 @@
 //
 
 #include <climits>
+#include <sstream>
 #include "stack/mac/buffer/LteMacQueue.h"
 #include "stack/rlc/am/packet/LteRlcAmPdu.h"
 
@@ -15,21 +16,41 @@ using namespace omnetpp;
 using namespace inet;
 
 LteMacQueue::LteMacQueue(int queueSize) :
-    cPacketQueue("LteMacQueue")
+    cOwnedObject("LteMacQueue")
 {
     queueSize_ = queueSize;
+    byteLength_ = 0;
     lastUnenqueueableMainSno = UINT_MAX;
 }
 
-LteMacQueue::LteMacQueue(const LteMacQueue& queue)
+LteMacQueue::LteMacQueue(const LteMacQueue& queue) :
+    cOwnedObject(queue)
 {
+    byteLength_ = 0;
     operator=(queue);
 }
 
+LteMacQueue::~LteMacQueue()
+{
+    clear();
+}
+
 LteMacQueue& LteMacQueue::operator=(const LteMacQueue& queue)
 {
-    cPacketQueue::operator=(queue);
+    if (this == &queue)
+        return *this;
+
+    cOwnedObject::operator=(queue);
+    clear();
+    for (unsigned int i = 0; i < queue.queue_.size(); i++)
+    {
+        cPacket* pkt = queue.queue_.at(i)->dup();
+        take(pkt);
+        queue_.pushBack(pkt);
+        byteLength_ += pkt->getByteLength();
+    }
     queueSize_ = queue.queueSize_;
+    lastUnenqueueableMainSno = queue.lastUnenqueueableMainSno;
     return *this;
 }
 
@@ -38,6 +59,13 @@ LteMacQueue* LteMacQueue::dup() const
     return new LteMacQueue(*this);
 }
 
+void LteMacQueue::clear()
+{
+    while (!queue_.empty())
+        dropAndDelete(queue_.popFront());
+    byteLength_ = 0;
+}
+
 // ENQUEUE
 bool LteMacQueue::pushBack(cPacket *pkt)
 {
@@ -45,7 +73,9 @@ bool LteMacQueue::pushBack(cPacket *pkt)
     if (!isEnqueueablePacket(pktAux))
          return false; // packet queue full or we have discarded fragments for this main packet
 
-    cPacketQueue::insert(pkt);
+    take(pkt);
+    queue_.pushBack(pkt);
+    byteLength_ += pkt->getByteLength();
     return true;
 }
 
@@ -55,28 +85,42 @@ bool LteMacQueue::pushFront(cPacket *pkt)
     if (!isEnqueueablePacket(pktAux))
         return false; // packet queue full or we have discarded fragments for this main packet
 
-    cPacketQueue::insertBefore(cPacketQueue::front(), pkt);
+    take(pkt);
+    queue_.pushFront(pkt);
+    byteLength_ += pkt->getByteLength();
     return true;
 }
 
 cPacket* LteMacQueue::popFront()
 {
-    return getQueueLength() > 0 ? cPacketQueue::pop() : nullptr;
+    if (queue_.empty())
+        return nullptr;
+
+    cPacket* pkt = queue_.popFront();
+    byteLength_ -= pkt->getByteLength();
+    drop(pkt);
+    return pkt;
 }
 
 cPacket* LteMacQueue::popBack()
 {
-    return getQueueLength() > 0 ? cPacketQueue::remove(cPacketQueue::back()) : nullptr;
+    if (queue_.empty())
+        return nullptr;
+
+    cPacket* pkt = queue_.popBack();
+    byteLength_ -= pkt->getByteLength();
+    drop(pkt);
+    return pkt;
 }
 
 simtime_t LteMacQueue::getHolTimestamp() const
 {
-    return getQueueLength() > 0 ? cPacketQueue::front()->getTimestamp() : 0;
+    return !queue_.empty() ? queue_.front()->getTimestamp() : 0;
 }
 
 int64_t LteMacQueue::getQueueOccupancy() const
 {
-    return cPacketQueue::getByteLength();
+    return byteLength_;
 }
 
 int64_t LteMacQueue::getQueueSize() const
@@ -122,7 +166,20 @@ bool LteMacQueue::isEnqueueablePacket(Packet* pkt){
 
 int LteMacQueue::getQueueLength() const
 {
-    return cPacketQueue::getLength();
+    return queue_.size();
+}
+
+void LteMacQueue::forEachChild(cVisitor *v)
+{
+    for (unsigned int i = 0; i < queue_.size(); i++)
+        v->visit(queue_.at(i));
+}
+
+std::string LteMacQueue::str() const
+{
+    std::stringstream out;
+    out << "len=" << queue_.size() << " bytes=" << byteLength_;
+    return out.str();
 }
 
 std::ostream &operator << (std::ostream &stream, const LteMacQueue* queue)
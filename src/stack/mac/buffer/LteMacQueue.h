@@ -14,6 +14,7 @@
 #include "inet/common/packet/Packet.h"
 #include "common/LteCommon.h"
 #include "stack/rlc/packet/LteRlcPdu_m.h"
+#include "stack/mac/buffer/LteRingBuffer.h"
 
 /**
  * @class LteMacQueue
@@ -30,20 +31,23 @@
  * dropped if stored packets exceeds the queue size
  * A size equal to 0 means that the size is infinite.
  *
+ * Packets are owned by the queue and stored in a ring buffer,
+ * so that enqueueing and dequeueing do not allocate list nodes.
  */
-class SIMULTE_API LteMacQueue : public omnetpp::cPacketQueue
+class SIMULTE_API LteMacQueue : public omnetpp::cOwnedObject
 {
   public:
 
     /**
-     * Constructor creates a new cPacketQueue
+     * Constructor creates a new empty queue
      * with configurable maximum size
      */
     LteMacQueue(int queueSize);
 
-    virtual ~LteMacQueue()
-    {
-    }
+    /**
+     * Destructor deletes the packets still in the queue
+     */
+    virtual ~LteMacQueue();
 
     /**
      * Copy Constructors
@@ -124,6 +128,27 @@ class SIMULTE_API LteMacQueue : public omnetpp::cPacketQueue
      */
     omnetpp::simtime_t getHolTimestamp() const;
 
+    /**
+     * getByteLength() returns the total length
+     * of the packets in the queue (in bytes)
+     */
+    int64_t getByteLength() const
+    {
+        return byteLength_;
+    }
+
+    /**
+     * isEmpty()
+     * @return TRUE if the queue is empty
+     */
+    bool isEmpty() const
+    {
+        return queue_.empty();
+    }
+
+    virtual void forEachChild(omnetpp::cVisitor *v) override;
+    virtual std::string str() const override;
+
     friend std::ostream &operator << (std::ostream &stream, const LteMacQueue* queue);
 
   protected:
@@ -142,6 +167,15 @@ class SIMULTE_API LteMacQueue : public omnetpp::cPacketQueue
   private:
     /// Size of queue
     int queueSize_;
+
+    /// Total length of the queued packets (in bytes)
+    int64_t byteLength_;
+
+    /// Ring of queued packets
+    LteRingBuffer<omnetpp::cPacket*> queue_;
+
+    /// Deletes the queued packets
+    void clear();
 };
 
 #endif
@@ -0,0 +1,131 @@
+//
+//                           SimuLTE
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". This license can be also found at http://www.ltesimulator.com/
+// The above file and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#ifndef _LTE_LTERINGBUFFER_H_
+#define _LTE_LTERINGBUFFER_H_
+
+#include <vector>
+#include <omnetpp.h>
+
+/**
+ * @class LteRingBuffer
+ * @brief Double-ended queue stored in a contiguous circular array
+ *
+ * Used as storage by the MAC buffers. The capacity is a power of two and is
+ * doubled when the buffer is full, so that, once a buffer has reached its
+ * working size, insertions and extractions at both ends do not allocate.
+ */
+template<typename T>
+class LteRingBuffer
+{
+  private:
+    /// Circular storage, its size is the capacity (0 or a power of two)
+    std::vector<T> buf_;
+    /// Position of the first element
+    unsigned int head_;
+    /// Number of stored elements
+    unsigned int size_;
+
+    unsigned int index(unsigned int i) const
+    {
+        return (head_ + i) & (buf_.size() - 1);
+    }
+
+    void grow()
+    {
+        std::vector<T> buf(buf_.empty() ? 8 : buf_.size() * 2);
+        for (unsigned int i = 0; i < size_; ++i)
+            buf[i] = buf_[index(i)];
+        buf_.swap(buf);
+        head_ = 0;
+    }
+
+  public:
+    LteRingBuffer() :
+        head_(0), size_(0)
+    {
+    }
+
+    void pushBack(const T& elem)
+    {
+        if (size_ == buf_.size())
+            grow();
+        buf_[index(size_)] = elem;
+        ++size_;
+    }
+
+    void pushFront(const T& elem)
+    {
+        if (size_ == buf_.size())
+            grow();
+        head_ = (head_ + buf_.size() - 1) & (buf_.size() - 1);
+        buf_[head_] = elem;
+        ++size_;
+    }
+
+    T popFront()
+    {
+        if (size_ == 0)
+            throw omnetpp::cRuntimeError("LteRingBuffer::popFront(): buffer empty");
+        T elem = buf_[head_];
+        head_ = index(1);
+        --size_;
+        return elem;
+    }
+
+    T popBack()
+    {
+        if (size_ == 0)
+            throw omnetpp::cRuntimeError("LteRingBuffer::popBack(): buffer empty");
+        --size_;
+        return buf_[index(size_)];
+    }
+
+    T& front()
+    {
+        return buf_[head_];
+    }
+
+    const T& front() const
+    {
+        return buf_[head_];
+    }
+
+    const T& back() const
+    {
+        return buf_[index(size_ - 1)];
+    }
+
+    /// Element in position i, counted from the front
+    const T& at(unsigned int i) const
+    {
+        if (i >= size_)
+            throw omnetpp::cRuntimeError("LteRingBuffer::at(): index %u out of range", i);
+        return buf_[index(i)];
+    }
+
+    unsigned int size() const
+    {
+        return size_;
+    }
+
+    bool empty() const
+    {
+        return size_ == 0;
+    }
+
+    /// Removes all the elements, keeping the capacity
+    void clear()
+    {
+        head_ = 0;
+        size_ = 0;
+    }
+};
+
+#endif
@@ -52,6 +52,16 @@ UnitList LteHarqBufferTx::firstReadyForRtx()
     return ret;
 }
 
+bool LteHarqBufferTx::hasReadyUnits()
+{
+    for (unsigned int i = 0; i < numProc_; i++)
+    {
+        if ((*processes_)[i]->hasReadyUnits())
+            return true;
+    }
+    return false;
+}
+
 int64_t LteHarqBufferTx::pduLength(unsigned char acid, Codeword cw)
 {
     return (*processes_)[acid]->getPduLength(cw);
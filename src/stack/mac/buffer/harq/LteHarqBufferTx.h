@@ -71,6 +71,14 @@ class SIMULTE_API LteHarqBufferTx
      */
     UnitList firstReadyForRtx();
 
+    /**
+     * Checks if any process of this buffer has units ready for retransmission.
+     * The check is cheap, as every process keeps the count of its ready units.
+     *
+     * @return true if at least one unit is ready for rtx
+     */
+    bool hasReadyUnits();
+
     /**
      * Returns the identifier of the H-ARQ process containing the unit with
      * passed id.
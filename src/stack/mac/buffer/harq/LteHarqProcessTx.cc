@@ -21,6 +21,7 @@ LteHarqProcessTx::LteHarqProcessTx(unsigned char acid, unsigned int numUnits, un
     numProcesses_ = numProcesses;
     numEmptyUnits_ = numUnits; //++ @ insert, -- @ unit reset (ack or fourth nack)
     numSelected_ = 0; //++ @ markSelected and insert, -- @ extract/sendDown
+    numReadyUnits_ = 0; //++ @ nack, -- @ markSelected and unit reset
     dropped_ = false;
 
     // H-ARQ unit instances
@@ -58,7 +59,9 @@ void LteHarqProcessTx::markSelected(Codeword cw)
         throw cRuntimeError("H-ARQ TX process: cannot select another unit because they are all already selected");
 
     numSelected_++;
+    bool wasReady = (*units_)[cw]->isReady();
     (*units_)[cw]->markSelected();
+    updateReadyUnits(cw, wasReady);
 }
 
 Packet *LteHarqProcessTx::extractPdu(Codeword cw)
@@ -74,7 +77,9 @@ Packet *LteHarqProcessTx::extractPdu(Codeword cw)
 
 bool LteHarqProcessTx::pduFeedback(HarqAcknowledgment fb, Codeword cw)
 {
+    bool wasReady = (*units_)[cw]->isReady();
     bool reset = (*units_)[cw]->pduFeedback(fb);
+    updateReadyUnits(cw, wasReady);
 
     if (reset)
     {
@@ -92,7 +97,9 @@ bool LteHarqProcessTx::pduFeedback(HarqAcknowledgment fb, Codeword cw)
 
 bool LteHarqProcessTx::selfNack(Codeword cw)
 {
+    bool wasReady = (*units_)[cw]->isReady();
     bool reset = (*units_)[cw]->selfNack();
+    updateReadyUnits(cw, wasReady);
 
     if (reset)
     {
@@ -108,16 +115,6 @@ bool LteHarqProcessTx::selfNack(Codeword cw)
     return reset;
 }
 
-bool LteHarqProcessTx::hasReadyUnits()
-{
-    for (unsigned int i = 0; i < numHarqUnits_; i++)
-    {
-        if ((*units_)[i]->isReady())
-            return true;
-    }
-    return false;
-}
-
 simtime_t LteHarqProcessTx::getOldestUnitTxTime()
 {
     simtime_t oldestTxTime = NOW + 1;
@@ -200,6 +197,7 @@ void LteHarqProcessTx::forceDropProcess()
     }
     numEmptyUnits_ = numHarqUnits_;
     numSelected_ = 0;
+    numReadyUnits_ = 0;
     dropped_ = true;
 }
 
@@ -208,7 +206,9 @@ bool LteHarqProcessTx::forceDropUnit(Codeword cw)
     if ((*units_)[cw]->isMarked())
         numSelected_--;
 
+    bool wasReady = (*units_)[cw]->isReady();
     (*units_)[cw]->forceDropUnit();
+    updateReadyUnits(cw, wasReady);
     numEmptyUnits_++;
 
     // empty process?
@@ -222,10 +222,21 @@ TxHarqPduStatus LteHarqProcessTx::getUnitStatus(Codeword cw)
 
 void LteHarqProcessTx::dropPdu(Codeword cw)
 {
+    bool wasReady = (*units_)[cw]->isReady();
     (*units_)[cw]->dropPdu();
+    updateReadyUnits(cw, wasReady);
     numEmptyUnits_++;
 }
 
+void LteHarqProcessTx::updateReadyUnits(Codeword cw, bool wasReady)
+{
+    bool ready = (*units_)[cw]->isReady();
+    if (ready && !wasReady)
+        numReadyUnits_++;
+    else if (!ready && wasReady)
+        numReadyUnits_--;
+}
+
 bool LteHarqProcessTx::isUnitEmpty(Codeword cw)
 {
     return (*units_)[cw]->isEmpty();
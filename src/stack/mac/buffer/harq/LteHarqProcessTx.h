@@ -50,6 +50,9 @@ class SIMULTE_API LteHarqProcessTx
     /// Number of selected units inside this process
     unsigned int numSelected_;
 
+    /// Number of units ready for retransmission (BUFFERED) inside this process
+    unsigned char numReadyUnits_;
+
     /// Set this flag when a handover or a D2D switch occurs, so that the HARQ process was interrupted.
     /// This is useful in case the process receives a feedback after reset.
     bool dropped_;
@@ -100,7 +103,7 @@ class SIMULTE_API LteHarqProcessTx
      *
      * @return true if there is at least one unit ready for rtx, false if none
      */
-    bool hasReadyUnits();
+    bool hasReadyUnits() { return numReadyUnits_ > 0; }
 
     /**
      * Returns the tx time of the unit which is not retransmitting for
@@ -176,6 +179,9 @@ class SIMULTE_API LteHarqProcessTx
     virtual ~LteHarqProcessTx();
 
   protected:
+
+    /// Updates numReadyUnits_ after a status change of the unit, according to its previous status
+    void updateReadyUnits(Codeword cw, bool wasReady);
 };
 
 #endif
@@ -20,6 +20,8 @@ LteHarqProcessTxD2D::LteHarqProcessTxD2D(unsigned char acid, unsigned int numUni
     numProcesses_ = numProcesses;
     numEmptyUnits_ = numUnits; //++ @ insert, -- @ unit reset (ack or fourth nack)
     numSelected_ = 0; //++ @ markSelected and insert, -- @ extract/sendDown
+    numReadyUnits_ = 0; //++ @ nack, -- @ markSelected and unit reset
+    dropped_ = false;
 
     // H-ARQ unit istances
     for (unsigned int i = 0; i < numHarqUnits_; i++)
@@ -32,6 +32,7 @@
 #include "stack/mac/amc/LteMcs.h"
 #include <map>
 #include "stack/mac/packet/SPSResourcePoolMode4.h"
+#include "common/LteProfiler.h"
 Define_Module(SidelinkConfiguration);
 
 SidelinkConfiguration::SidelinkConfiguration()
@@ -58,7 +59,8 @@ void SidelinkConfiguration::initialize(int stage)
 
     if (stage == inet::INITSTAGE_LOCAL)
     {
-        EV<<"SidelinkConfiguration::initialize, stage: "<<stage<<endl;
+        EV_MAC<<"SidelinkConfiguration::initialize, stage: "<<stage<<endl;
+        tbsTable_ = &TbsTable::instance();
         parseUeTxConfig(par("txConfig").xmlValue());
         parseCbrTxConfig(par("txConfig").xmlValue());
         parseRriConfig(par("txConfig").xmlValue());
@@ -149,7 +151,7 @@ void SidelinkConfiguration::parseUeTxConfig(cXMLElement* xmlConfig)
     ParameterMap::iterator it = params.find("minMCS-PSSCH");
     if (it != params.end())
     {
-        EV<<"Parsing minMCS-PSSCH SidelinkConfiguration::parseUeTxConfig"<<endl;
+        EV_MAC<<"Parsing minMCS-PSSCH SidelinkConfiguration::parseUeTxConfig"<<endl;
         minMCSPSSCH_ = (int)it->second;
     }
     else
@@ -292,7 +294,7 @@ void SidelinkConfiguration::parseCbrTxConfig(cXMLElement* xmlConfig)
         }
 
         cbrPSSCHTxConfigList_.push_back(cbrMap);
-        EV<<"Parsing CBR"<<cbrPSSCHTxConfigList_.size()<<endl;
+        EV_MAC<<"Parsing CBR"<<cbrPSSCHTxConfigList_.size()<<endl;
     }
 }
 
@@ -360,6 +362,7 @@ UserTxParams* SidelinkConfiguration::getPreconfiguredTxParams()
 
 void SidelinkConfiguration::handleMessage(cMessage *msg)
 {
+    LTE_PROFILE_SCOPE(this, "handleMessage");
     if (msg->isSelfMessage())
     {
         //LteMacUeD2D::handleMessage(msg);
@@ -373,7 +376,7 @@ void SidelinkConfiguration::handleMessage(cMessage *msg)
 
     if (strcmp(pkt->getName(), "CBR") == 0)
     {
-        EV<<"REceived CBR message from gate: "<<incoming<<endl;
+        EV_MAC<<"REceived CBR message from gate: "<<incoming<<endl;
 
         Cbr* cbrPkt = check_and_cast<Cbr*>(pkt);
         cbr_ = cbrPkt->getCbr();
@@ -443,7 +446,7 @@ void SidelinkConfiguration::handleMessage(cMessage *msg)
 
         // calculate cr
         channelOccupancyRatio_ = subchannelsUsed /(numSubchannels_ * 1000.0);
-        EV<<"channelOccupancyRatio_: "<<channelOccupancyRatio_<<endl;
+        EV_MAC<<"channelOccupancyRatio_: "<<channelOccupancyRatio_<<endl;
         // message from PHY_to_MAC gate (from lower layer)
         //emit(receivedPacketFromLowerLayer, pkt);
         throw cRuntimeError("SLConfig CBR");
@@ -492,7 +495,7 @@ void SidelinkConfiguration::handleMessage(cMessage *msg)
             mode4Grant->setGrantedCwBytes((MAX_CODEWORDS - currentCw_), pkt->getBitLength());
             mode4Grant->setPacketId(mac->getPacketId());
             mode4Grant->setCamId(mac->getCAMId());
-            EV<<"Mode4Grant CAM Id: "<<mac->getCAMId()<<endl;
+            EV_MAC<<"Mode4Grant CAM Id: "<<mac->getCAMId()<<endl;
             slGrant = mode4Grant;
             setSidelinkGrant(slGrant);
             pkt->setControlInfo(lteInfo);
@@ -535,7 +538,7 @@ void SidelinkConfiguration::handleMessage(cMessage *msg)
             // Need to set the size of our grant to the correct size we need to ask rlc for, i.e. for the sdu size.
             mode4Grant->setGrantedCwBytes((MAX_CODEWORDS - currentCw_), pkt->getBitLength());
             mode4Grant->setPacketId(mac->getPacketId());
-            EV<<"Grant for packetId: "<<mode4Grant->getPacketId()<<endl;
+            EV_MAC<<"Grant for packetId: "<<mode4Grant->getPacketId()<<endl;
             slGrant = mode4Grant;
             setSidelinkGrant(slGrant);
             pkt->setControlInfo(lteInfo);
@@ -558,7 +561,7 @@ void SidelinkConfiguration::assignGrantToData(DataArrival* pkt, std::string rrcS
 
         FlowControlInfoNonIp* lteInfo = check_and_cast<FlowControlInfoNonIp*>(pkt->removeControlInfo());
         receivedTime_ = NOW;
-        EV<<"RRC State: "<<rrcState<<endl;
+        EV_MAC<<"RRC State: "<<rrcState<<endl;
 
         simtime_t elapsedTime = receivedTime_ - lteInfo->getCreationTime();
         simtime_t duration = SimTime(lteInfo->getDuration(), SIMTIME_MS);
@@ -605,9 +608,9 @@ void SidelinkConfiguration::assignGrantToData(DataArrival* pkt, std::string rrcS
         double dur = duration;
         remainingTime_ = pkt->getDuration() - dur;
 
-        EV<<"Remaining time: "<<remainingTime_<<endl;
-        EV<<"Priority: "<<pkt->getPriority()<<endl;
-        EV<<"bit length: "<<pkt->getDataSize()<<endl;
+        EV_MAC<<"Remaining time: "<<remainingTime_<<endl;
+        EV_MAC<<"Priority: "<<pkt->getPriority()<<endl;
+        EV_MAC<<"bit length: "<<pkt->getDataSize()<<endl;
 
         if (schedulingGrant_ != NULL && periodCounter_ > remainingTime_)
         {
@@ -634,9 +637,9 @@ void SidelinkConfiguration::assignGrantToData(DataArrival* pkt, std::string rrcS
 
         // Need to set the size of our grant to the correct size we need to ask rlc for, i.e. for the sdu size.
         mode3Grant->setGrantedCwBytes((MAX_CODEWORDS - currentCw_), pkt->getDataSize());
-        EV<<"Mode3Grant packetId: "<<lteInfo->getPktId();
+        EV_MAC<<"Mode3Grant packetId: "<<lteInfo->getPktId();
         mode3Grant->setCamId(lteInfo->getCAMId());
-        EV<<"Mode3Grant CAMId: "<<lteInfo->getCAMId();
+        EV_MAC<<"Mode3Grant CAMId: "<<lteInfo->getCAMId();
         //mode3Grant->setPacketId(lteInfo->getPktId());
         slGrant = mode3Grant;
         setSidelinkGrant(slGrant);
@@ -667,7 +670,7 @@ void SidelinkConfiguration::macHandleSps(std::vector<std::tuple<double, int, dou
     slGrant = getSidelinkGrant();
 
 
-    EV<<"Number of CSRs: "<<CSRs.size()<<endl;
+    EV_MAC<<"Number of CSRs: "<<CSRs.size()<<endl;
 
     //slGrant = check_and_cast<LteSidelinkGrant*>(schedulingGrant_);
 
@@ -676,7 +679,7 @@ void SidelinkConfiguration::macHandleSps(std::vector<std::tuple<double, int, dou
 
     if (CSRs.size()==0)
     {
-        EV<<"CSRs size: "<<CSRs.size()<<endl;
+        EV_MAC<<"CSRs size: "<<CSRs.size()<<endl;
         throw cRuntimeError("Cannot allocate CSRs");
     }
 
@@ -689,7 +692,7 @@ void SidelinkConfiguration::macHandleSps(std::vector<std::tuple<double, int, dou
     int initialSubchannel = 0;
     int finalSubchannel = initialSubchannel + slGrant->getNumSubchannels(); // Is this actually one additional subchannel?
 
-    EV<<"initial subchannel: "<<initialSubchannel<<" "<<"final subchannel: "<<finalSubchannel<<endl;
+    EV_MAC<<"initial subchannel: "<<initialSubchannel<<" "<<"final subchannel: "<<finalSubchannel<<endl;
     // Emit statistic about the use of resources, i.e. the initial subchannel and it's length.
     //emit(selectedSubchannelIndex, initialSubchannel);
     //emit(selectedNumSubchannels, slGrant->getNumSubchannels());
@@ -717,36 +720,22 @@ void SidelinkConfiguration::macHandleSps(std::vector<std::tuple<double, int, dou
     slGrant->setStartingSubchannel(initialSubchannel);
     slGrant->setMcs(maxMCSPSSCH_);
 
-    LteMod mod = _QPSK;
-    if (maxMCSPSSCH_ > 9 && maxMCSPSSCH_ < 17)
-    {
-        mod = _16QAM;
-    }
-    else if (maxMCSPSSCH_ > 16 && maxMCSPSSCH_ < 29 )
-    {
-        mod = _64QAM;
-    }
-
-
-    EV<<"totalGrantedBlocks: "<<totalGrantedBlocks<<endl;
+    EV_MAC<<"totalGrantedBlocks: "<<totalGrantedBlocks<<endl;
     setAllocatedBlocksSCIandData(totalGrantedBlocks);
-    EV<<"maxMCSPSSCH_: "<<maxMCSPSSCH_<<endl;
-
-    unsigned int i = (mod == _QPSK ? 0 : (mod == _16QAM ? 9 : (mod == _64QAM ? 15 : 0)));
+    EV_MAC<<"maxMCSPSSCH_: "<<maxMCSPSSCH_<<endl;
 
-    const unsigned int* tbsVect = itbs2tbs(mod, SINGLE_ANTENNA_PORT0, 1, maxMCSPSSCH_ - i);
-    maximumCapacity_ = tbsVect[totalGrantedBlocks-1];
+    maximumCapacity_ = tbsTable_->bitsOnNRbs(SINGLE_ANTENNA_PORT0, 1, TbsTable::sidelinkRowIndex(maxMCSPSSCH_), totalGrantedBlocks);
 
-    EV<<"maximum capacity: "<< maximumCapacity_<<endl;
+    EV_MAC<<"maximum capacity: "<< maximumCapacity_<<endl;
     slGrant->setGrantedCwBytes(currentCw_, maximumCapacity_);
     // Simply flips the codeword.
     currentCw_ = MAX_CODEWORDS - currentCw_;
     periodCounter_= slGrant->getPeriod();
     expirationCounter_= (slGrant->getResourceReselectionCounter() * periodCounter_) + 1;
 
-    EV<<"Sidelink Configuration period counter: "<<periodCounter_<<endl;
-    EV<<"Sidelink Configuration expiration counter: "<<expirationCounter_<<endl;
-    EV<<"Sidelink Configuration Granted CWBytes size: "<<slGrant->getGrantedCwBytesArraySize()<<endl;
+    EV_MAC<<"Sidelink Configuration period counter: "<<periodCounter_<<endl;
+    EV_MAC<<"Sidelink Configuration expiration counter: "<<expirationCounter_<<endl;
+    EV_MAC<<"Sidelink Configuration Granted CWBytes size: "<<slGrant->getGrantedCwBytesArraySize()<<endl;
     //Implement methods to store expiration counter and period counter
     slGrant->setPeriodCounter(periodCounter_);
     slGrant->setExpirationCounter(expirationCounter_);
@@ -768,7 +757,7 @@ LteSidelinkGrant* SidelinkConfiguration::macGenerateSchedulingGrant(double maxim
      * 4. Number of subchannels
      * 6. Send message to PHY layer looking for CSRs
      */
-    EV<<"SidelinkConfiguration::macGenerateSchedulingGrant"<<endl;
+    EV_MAC<<"SidelinkConfiguration::macGenerateSchedulingGrant"<<endl;
     if(rrcCurrentState=="RRC_CONN" ||rrcCurrentState=="RRC_INACTIVE")
     {
         slGrant = new LteSidelinkGrant("LteMode3Grant");
@@ -876,12 +865,12 @@ void SidelinkConfiguration::flushHarqBuffers(HarqTxBuffers harqTxBuffers_, LteSi
     //slGrant = dynamic_cast<LteSidelinkGrant*>(schedulingGrant_);
 
     HarqTxBuffers::iterator it2;
-    EV<<"Harq size: "<<harqTxBuffers_.size()<<endl;
-    EV<<"Scheduling grant: "<<slGrant<<endl;
+    EV_MAC<<"Harq size: "<<harqTxBuffers_.size()<<endl;
+    EV_MAC<<"Scheduling grant: "<<slGrant<<endl;
 
     for(it2 = harqTxBuffers_.begin(); it2 != harqTxBuffers_.end(); it2++)
     {
-        //EV<<"SidelinkConfiguration::flushHarqBuffers for: "<<it2->second->isSelected()<<endl;
+        //EV_MAC<<"SidelinkConfiguration::flushHarqBuffers for: "<<it2->second->isSelected()<<endl;
 
 
         std::unordered_map<std::string,double> cbrMap = cbrPSSCHTxConfigList_.at(currentCbrIndex_);
@@ -916,7 +905,7 @@ void SidelinkConfiguration::flushHarqBuffers(HarqTxBuffers harqTxBuffers_, LteSi
             {
 
                 int pduLength = selectedProcess->getPduLength(cw);
-                EV<<"PDU length: "<<pduLength<<endl;
+                EV_MAC<<"PDU length: "<<pduLength<<endl;
                 emit(dataSize,pduLength);
                 //throw cRuntimeError("debug 4");
                 if ( pduLength > 0)
@@ -954,29 +943,16 @@ void SidelinkConfiguration::flushHarqBuffers(HarqTxBuffers harqTxBuffers_, LteSi
 
                     bool foundValidMCS = false;
                     int totalGrantedBlocks =  slGrant->getTotalGrantedBlocks();
-                    EV<<"totalGrantedBlocks: "<<totalGrantedBlocks<<endl;
+                    EV_MAC<<"totalGrantedBlocks: "<<totalGrantedBlocks<<endl;
 
                     int mcsCapacity = 0;
                     for (int mcs=minMCS; mcs < maxMCS; mcs++)
                     {
-                        LteMod mod = _QPSK;
-                        if (maxMCSPSSCH_ > 9 && maxMCSPSSCH_ < 17)
-                        {
-                            mod = _16QAM;
-                        }
-                        else if (maxMCSPSSCH_ > 16 && maxMCSPSSCH_ < 29 )
-                        {
-                            mod = _64QAM;
-                        }
-
-                        unsigned int i = (mod == _QPSK ? 0 : (mod == _16QAM ? 9 : (mod == _64QAM ? 15 : 0)));
-
-                        const unsigned int* tbsVect = itbs2tbs(mod, SINGLE_ANTENNA_PORT0, 1, mcs - i);
-                        mcsCapacity = tbsVect[totalGrantedBlocks-1];
-                        EV<<" mcsCapacity: "<< mcsCapacity <<endl;
+                        mcsCapacity = tbsTable_->bitsOnNRbs(SINGLE_ANTENNA_PORT0, 1, TbsTable::sidelinkRowIndex(mcs), totalGrantedBlocks);
+                        EV_MAC<<" mcsCapacity: "<< mcsCapacity <<endl;
 
 
-                            EV<<"Valid MCS found: "<<endl;
+                            EV_MAC<<"Valid MCS found: "<<endl;
                             foundValidMCS = true;
 
                             slGrant->setMcs(mcs);
@@ -1022,7 +998,7 @@ void SidelinkConfiguration::flushHarqBuffers(HarqTxBuffers harqTxBuffers_, LteSi
                             missedTransmissions_ = 0;
 
                             //emit(selectedMCS, mcs);
-                            EV<<"VALID MCS: "<<foundValidMCS<<endl;
+                            EV_MAC<<"VALID MCS: "<<foundValidMCS<<endl;
 
 
                     }
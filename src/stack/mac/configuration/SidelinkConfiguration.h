@@ -107,6 +107,7 @@ protected:
     int minMCSPSSCH_;
     int maxMCSPSSCH_;
     int maximumCapacity_;
+    const TbsTable* tbsTable_;
     int allowedRetxNumberPSSCH_;
     int reselectAfter_;
     int defaultCbrIndex_;
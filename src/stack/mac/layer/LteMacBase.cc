@@ -20,7 +20,9 @@
 #include "stack/mac/packet/LteHarqFeedback_m.h"
 #include "stack/mac/packet/LteMacPdu.h"
 #include "stack/mac/buffer/LteMacBuffer.h"
+#include "stack/rlc/packet/LteRlcNewData_m.h"
 #include "assert.h"
+#include "common/LteProfiler.h"
 
 using namespace omnetpp;
 
@@ -245,6 +247,50 @@ bool LteMacBase::bufferizePacket(cPacket* pkt)
     return true;
 }
 
+MacCid LteMacBase::bufferizeNewData(LteRlcNewData* newData)
+{
+    newData->setTimestamp();        // Add timestamp with current time to the indication
+
+    FlowControlInfo& lteInfo = newData->getFlowInfoForUpdate();
+
+    // obtain the cid from the flow informations
+    MacCid cid = ctrlInfoToMacCid(&lteInfo);
+
+    // build the virtual packet corresponding to the new SDU
+    PacketInfo vpkt(newData->getSduLength(), newData->getTimestamp());
+
+    LteMacBufferMap::iterator it = macBuffers_.find(cid);
+    if (it == macBuffers_.end())
+    {
+        LteMacBuffer* vqueue = new LteMacBuffer();
+        vqueue->pushBack(vpkt);
+        macBuffers_[cid] = vqueue;
+
+        // make a copy of lte control info and store it to traffic descriptors map
+        connDesc_[cid] = lteInfo;
+        // register connection to lcg map.
+        LteTrafficClass tClass = (LteTrafficClass) lteInfo.getTraffic();
+
+        lcgMap_.insert(LcgPair(tClass, CidBufferPair(cid, macBuffers_[cid])));
+
+        EV_MAC << "LteMacBuffers : Using new buffer on node: " <<
+        MacCidToNodeId(cid) << " for Lcid: " << MacCidToLcid(cid) << ", Bytes in the Queue: " <<
+        vqueue->getQueueOccupancy() << "\n";
+    }
+    else
+    {
+        LteMacBuffer* vqueue = it->second;
+        vqueue->pushBack(vpkt);
+
+        EV_MAC << "LteMacBuffers : Using old buffer on node: " <<
+        MacCidToNodeId(cid) << " for Lcid: " << MacCidToLcid(cid) << ", Space left in the Queue: " <<
+        vqueue->getQueueOccupancy() << "\n";
+    }
+
+    delete newData;
+    return cid;
+}
+
 void LteMacBase::deleteQueues(MacNodeId nodeId)
 {
     LteMacBuffers::iterator mit;
@@ -371,6 +417,7 @@ void LteMacBase::initialize(int stage)
 
 void LteMacBase::handleMessage(cMessage* msg)
 {
+    LTE_PROFILE_SCOPE(this, "handleMessage");
     if (msg->isSelfMessage())
     {
         handleSelfMessage();
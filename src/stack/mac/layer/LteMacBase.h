@@ -18,6 +18,7 @@ class LteHarqBufferRx;
 class LteBinder;
 class FlowControlInfo;
 class LteMacBuffer;
+class LteRlcNewData;
 
 /**
  * Map associating a nodeId with the corresponding TX H-ARQ buffer.
@@ -328,6 +329,17 @@ public:
 	  */
 	 virtual bool bufferizePacket(omnetpp::cPacket* pkt);
 
+	 /**
+	  * bufferizeNewData() is called every time the RLC notifies
+	  * the arrival of new data in its buffers: only the virtual
+	  * buffer of the connection is updated, then the indication
+	  * is deleted
+	  *
+	  * @param newData new data indication
+	  * @return cid of the connection
+	  */
+	 MacCid bufferizeNewData(LteRlcNewData* newData);
+
 	 /**
 	  * handleUpperMessage() is called every time a packet is
 	  * received from the upper layer
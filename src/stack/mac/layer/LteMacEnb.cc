@@ -24,6 +24,8 @@
 #include "common/LteCommon.h"
 #include "stack/rlc/packet/LteRlcDataPdu.h"
 #include "stack/rlc/am/packet/LteRlcAmPdu_m.h"
+#include "stack/rlc/packet/LteRlcNewData_m.h"
+#include "common/LteProfiler.h"
 
 Define_Module( LteMacEnb);
 
@@ -42,11 +44,13 @@ LteMacEnb::LteMacEnb() :
 	enbSchedulerUl_ = nullptr;
 	numAntennas_ = 0;
 	bsrbuf_.clear();
+	bsrBacklog_.clear();
 	currentSubFrameType_ = NORMAL_FRAME_TYPE;
 	nodeType_ = ENODEB;
 	frameIndex_ = 0;
 	lastTtiAllocatedRb_ = 0;
 	scheduleListDl_ = nullptr;
+	flushHarqMsg_ = nullptr;
 }
 
 LteMacEnb::~LteMacEnb()
@@ -59,6 +63,8 @@ LteMacEnb::~LteMacEnb()
 	for (bit = bsrbuf_.begin(); bit != bsrbuf_.end(); bit++)
 		delete bit->second;
 	bsrbuf_.clear();
+
+	cancelAndDelete(flushHarqMsg_);
 }
 
 /***********************
@@ -195,19 +201,13 @@ void LteMacEnb::deleteQueues(MacNodeId nodeId)
 {
 	LteMacBase::deleteQueues(nodeId);
 
-	LteMacBufferMap::iterator bit;
-	for (bit = bsrbuf_.begin(); bit != bsrbuf_.end();)
-	{
-		if (MacCidToNodeId(bit->first) == nodeId)
-		{
-			delete bit->second; // Delete Queue
-			bsrbuf_.erase(bit++); // Delete Elem
-		}
-		else
-		{
-			++bit;
-		}
-	}
+	// the BSR buffers of a UE are contiguous in the map
+	LteMacBufferMap::iterator bit = bsrbuf_.lower_bound(idToMacCid(nodeId, 0));
+	LteMacBufferMap::iterator bet = bsrbuf_.upper_bound(idToMacCid(nodeId, 0xFFFF));
+	for (LteMacBufferMap::iterator it = bit; it != bet; ++it)
+		delete it->second; // Delete Queue
+	bsrbuf_.erase(bit, bet);
+	bsrBacklog_.erase(bsrBacklog_.lower_bound(idToMacCid(nodeId, 0)), bsrBacklog_.upper_bound(idToMacCid(nodeId, 0xFFFF)));
 
 	//update harq status in schedulers
 	//    enbSchedulerDl_->updateHarqDescs();
@@ -228,6 +228,9 @@ void LteMacEnb::initialize(int stage)
 	{
 		nodeId_ = getAncestorPar("macNodeId");
 
+		flushHarqMsg_ = new cMessage("flushHarqMsg");
+		flushHarqMsg_->setSchedulingPriority(1);        // after other messages
+
 		cellId_ = nodeId_;
 
 		// TODO: read NED parameters, when will be present
@@ -281,12 +284,12 @@ void LteMacEnb::initialize(int stage)
 
 void LteMacEnb::handleMessage(cMessage *msg)
 {
+	LTE_PROFILE_SCOPE(this, "handleMessage");
 	if (msg->isSelfMessage())
 	{
-		if (strcmp(msg->getName(), "flushHarqMsg") == 0)
+		if (msg == flushHarqMsg_)
 		{
 			flushHarqBuffers();
-			delete msg;
 			return;
 		}
 	}
@@ -295,7 +298,7 @@ void LteMacEnb::handleMessage(cMessage *msg)
 
 void LteMacEnb::macSduRequest()
 {
-	EV << "----- START LteMacEnb::macSduRequest -----\n";
+	EV_MAC << "----- START LteMacEnb::macSduRequest -----\n";
 
 	// Ask for a MAC sdu for each scheduled user on each codeword
 	LteMacScheduleList::const_iterator it;
@@ -335,7 +338,14 @@ void LteMacEnb::macSduRequest()
 		sendUpperPackets(pkt);
 	}
 
-	EV << "------ END LteMacEnb::macSduRequest ------\n";
+	EV_MAC << "------ END LteMacEnb::macSduRequest ------\n";
+}
+
+void LteMacEnb::pruneBsrBacklog(MacCid cid)
+{
+	LteMacBufferMap::iterator it = bsrbuf_.find(cid);
+	if (it == bsrbuf_.end() || it->second->isEmpty())
+		bsrBacklog_.erase(cid);
 }
 
 void LteMacEnb::bufferizeBsr(MacBsr* bsr, MacCid cid)
@@ -351,8 +361,9 @@ void LteMacEnb::bufferizeBsr(MacBsr* bsr, MacCid cid)
 			PacketInfo vpkt(bsr->getSize(), bsr->getTimestamp());
 			bsrqueue->pushBack(vpkt);
 			bsrbuf_[cid] = bsrqueue;
+			bsrBacklog_.insert(cid);
 
-			EV << "LteBsrBuffers : Added new BSR buffer for node: "
+			EV_MAC << "LteBsrBuffers : Added new BSR buffer for node: "
 					<< MacCidToNodeId(cid) << " for Lcid: " << MacCidToLcid(cid)
 					<< " Current BSR size: " << bsr->getSize() << "\n";
 
@@ -375,8 +386,9 @@ void LteMacEnb::bufferizeBsr(MacBsr* bsr, MacCid cid)
 			queuedBsr.first = bsr->getSize();
 			queuedBsr.second = bsr->getTimestamp();
 			bsrqueue->pushBack(queuedBsr);
+			bsrBacklog_.insert(cid);
 
-			EV << "LteBsrBuffers : Using old buffer for node: " << MacCidToNodeId(
+			EV_MAC << "LteBsrBuffers : Using old buffer for node: " << MacCidToNodeId(
 					cid) << " for Lcid: " << MacCidToLcid(cid)
             		   << " Current BSR size: " << bsr->getSize() << "\n";
 
@@ -388,8 +400,9 @@ void LteMacEnb::bufferizeBsr(MacBsr* bsr, MacCid cid)
 			// the UE has no backlog, remove BSR
 			if (!bsrqueue->isEmpty())
 				bsrqueue->popFront();
+			bsrBacklog_.erase(cid);
 
-			EV << "LteBsrBuffers : Using old buffer for node: " << MacCidToNodeId(
+			EV_MAC << "LteBsrBuffers : Using old buffer for node: " << MacCidToNodeId(
 					cid) << " for Lcid: " << MacCidToLcid(cid)
             		   << " - now empty" << "\n";
 		}
@@ -398,7 +411,7 @@ void LteMacEnb::bufferizeBsr(MacBsr* bsr, MacCid cid)
 
 void LteMacEnb::sendGrants(LteMacScheduleList* scheduleList)
 {
-	EV << NOW << "LteMacEnb::sendGrants " << endl;
+	EV_MAC << NOW << "LteMacEnb::sendGrants " << endl;
 
 	while (!scheduleList->empty())
 	{
@@ -442,7 +455,7 @@ void LteMacEnb::sendGrants(LteMacScheduleList* scheduleList)
 		if (granted == 0)
 			continue; // avoiding transmission of 0 grant (0 grant should not be created)
 
-		EV << NOW << " LteMacEnb::sendGrants Node[" << getMacNodeId() << "] - "
+		EV_MAC << NOW << " LteMacEnb::sendGrants Node[" << getMacNodeId() << "] - "
 				<< granted << " blocks to grant for user " << nodeId << " on "
 				<< codewords << " codewords. CW[" << cw << "\\" << otherCw << "]" << endl;
 
@@ -493,7 +506,7 @@ void LteMacEnb::sendGrants(LteMacScheduleList* scheduleList)
 			}
 
 			grant->setGrantedCwBytes(cw, grantedBytes);
-			EV << NOW << " LteMacEnb::sendGrants - granting " << grantedBytes << " on cw " << cw << endl;
+			EV_MAC << NOW << " LteMacEnb::sendGrants - granting " << grantedBytes << " on cw " << cw << endl;
 		}
 
 		RbMap map;
@@ -509,7 +522,7 @@ void LteMacEnb::sendGrants(LteMacScheduleList* scheduleList)
 
 void LteMacEnb::macHandleRac(cPacket* pktAux)
 {
-	EV << NOW << " LteMacEnb::macHandleRac" << endl;
+	EV_MAC << NOW << " LteMacEnb::macHandleRac" << endl;
 
 	auto pkt = check_and_cast<Packet *>(pktAux);
 
@@ -532,7 +545,7 @@ void LteMacEnb::macHandleRac(cPacket* pktAux)
 
 void LteMacEnb::macPduMake(MacCid cid)
 {
-	EV << "----- START LteMacEnb::macPduMake -----\n";
+	EV_MAC << "----- START LteMacEnb::macPduMake -----\n";
 	// Finalizes the scheduling decisions according to the schedule list,
 	// detaching sdus from real buffers.
 
@@ -651,12 +664,12 @@ void LteMacEnb::macPduMake(MacCid cid)
 		auto macPacket = pit->second;
 		auto header = macPacket->peekAtFront<LteMacPdu>();
 
-		EV << "LteMacBase: pduMaker created PDU: " << header->str() << endl;
+		EV_MAC << "LteMacBase: pduMaker created PDU: " << header->str() << endl;
 
 		// pdu transmission here (if any)
 		if (txList.second.empty())
 		{
-			EV << "macPduMake() : no available process for this MAC pdu in TxHarqBuffer" << endl;
+			EV_MAC << "macPduMake() : no available process for this MAC pdu in TxHarqBuffer" << endl;
 			delete macPacket;
 		}
 		else
@@ -666,7 +679,7 @@ void LteMacEnb::macPduMake(MacCid cid)
 			txBuf->insertPdu(txList.first, cw, macPacket);
 		}
 	}
-	EV << "------ END LteMacEnb::macPduMake ------\n";
+	EV_MAC << "------ END LteMacEnb::macPduMake ------\n";
 }
 
 void LteMacEnb::macPduUnmake(cPacket* pktAux)
@@ -681,7 +694,7 @@ void LteMacEnb::macPduUnmake(cPacket* pktAux)
 		take(upPkt);
 
 		// TODO: upPkt->info()
-		EV << "LteMacBase: pduUnmaker extracted SDU" << endl;
+		EV_MAC << "LteMacBase: pduUnmaker extracted SDU" << endl;
 		sendUpperPackets(upPkt);
 	}
 
@@ -753,7 +766,7 @@ bool LteMacEnb::bufferizePacket(cPacket* pktAux)
 
 			lcgMap_.insert(LcgPair(tClass, CidBufferPair(cid, macBuffers_[cid])));
 
-			EV << "LteMacBuffers : Using new buffer on node: " <<
+			EV_MAC << "LteMacBuffers : Using new buffer on node: " <<
 					MacCidToNodeId(cid) << " for Lcid: " << MacCidToLcid(cid) << ", Bytes in the Queue: " <<
 					vqueue->getQueueOccupancy() << "\n";
 		}
@@ -762,7 +775,7 @@ bool LteMacEnb::bufferizePacket(cPacket* pktAux)
 			LteMacBuffer* vqueue = macBuffers_.find(cid)->second;
 			vqueue->pushBack(vpkt);
 
-			EV << "LteMacBuffers : Using old buffer on node: " <<
+			EV_MAC << "LteMacBuffers : Using old buffer on node: " <<
 					MacCidToNodeId(cid) << " for Lcid: " << MacCidToLcid(cid) << ", Space left in the Queue: " <<
 					vqueue->getQueueOccupancy() << "\n";
 		}
@@ -783,7 +796,7 @@ bool LteMacEnb::bufferizePacket(cPacket* pktAux)
 
 		mbuf_[cid] = queue;
 
-		EV << "LteMacBuffers : Using new buffer on node: " <<
+		EV_MAC << "LteMacBuffers : Using new buffer on node: " <<
 				MacCidToNodeId(cid) << " for Lcid: " << MacCidToLcid(cid) << ", Space left in the Queue: " <<
 				queue->getQueueSize() - queue->getByteLength() << "\n";
 	}
@@ -795,7 +808,7 @@ bool LteMacEnb::bufferizePacket(cPacket* pktAux)
 		if (!queue->pushBack(pkt))
 		{
 			// unable to buffer packet (packet is not enqueued and will be dropped): update statistics
-			EV << "LteMacBuffers : queue" << cid << " is full - cannot buffer packet " << pkt->getId()<< "\n";
+			EV_MAC << "LteMacBuffers : queue" << cid << " is full - cannot buffer packet " << pkt->getId()<< "\n";
 
 			totalOverflowedBytes_ += pkt->getByteLength();
 			double sample = (double)totalOverflowedBytes_ / (NOW - getSimulation()->getWarmupPeriod());
@@ -806,7 +819,7 @@ bool LteMacEnb::bufferizePacket(cPacket* pktAux)
 				emit(macBufferOverflowUl_,sample);
 		}
 
-		EV << "LteMacBuffers : Using old buffer on node: " <<
+		EV_MAC << "LteMacBuffers : Using old buffer on node: " <<
 				MacCidToNodeId(cid) << " for Lcid: " << MacCidToLcid(cid) << ", Space left in the Queue: " <<
 				queue->getQueueSize() - queue->getByteLength() << "\n";
 	}
@@ -816,6 +829,16 @@ bool LteMacEnb::bufferizePacket(cPacket* pktAux)
 
 void LteMacEnb::handleUpperMessage(cPacket* pktAux)
 {
+	// new data in the RLC buffers: update the virtual buffer and inform scheduler of active connection
+	LteRlcNewData* newData = dynamic_cast<LteRlcNewData*>(pktAux);
+	if (newData != nullptr)
+	{
+		MacCid cid = idToMacCid(newData->getFlowInfo().getDestId(), newData->getFlowInfo().getLcid());
+		bufferizeNewData(newData);
+		enbSchedulerDl_->backlog(cid);
+		return;
+	}
+
 	auto pkt = check_and_cast<Packet *>(pktAux);
 	auto lteInfo = pkt->getTag<FlowControlInfo>();
 	MacCid cid = idToMacCid(lteInfo->getDestId(), lteInfo->getLcid());
@@ -841,7 +864,7 @@ void LteMacEnb::handleSelfMessage()
 	 *  MAIN LOOP  *
 	 ***************/
 
-	EV << "-----" << "ENB MAIN LOOP -----" << endl;
+	EV_MAC << "-----" << "ENB MAIN LOOP -----" << endl;
 
 	/*************
 	 * END DEBUG
@@ -866,7 +889,7 @@ void LteMacEnb::handleSelfMessage()
 	}
 
 	/*UPLINK*/
-	EV << "============================================== UPLINK ==============================================" << endl;
+	EV_MAC << "============================================== UPLINK ==============================================" << endl;
 	// init and reset global allocation information
 	if (binder_->getLastUpdateUlTransmissionInfo() < NOW)  // once per TTI, even in case of multicell scenarios
 		binder_->initAndResetUlTransmissionInfo();
@@ -879,9 +902,9 @@ void LteMacEnb::handleSelfMessage()
 	LteMacScheduleList* scheduleListUl = enbSchedulerUl_->schedule();
 	// send uplink grants to PHY layer
 	sendGrants(scheduleListUl);
-	EV << "============================================ END UPLINK ============================================" << endl;
+	EV_MAC << "============================================ END UPLINK ============================================" << endl;
 
-	EV << "============================================ DOWNLINK ==============================================" << endl;
+	EV_MAC << "============================================ DOWNLINK ==============================================" << endl;
 	/*DOWNLINK*/
 	// Set current available OFDM space
 	(enbSchedulerDl_->resourceBlocks()) = getNumRbDl();
@@ -901,7 +924,7 @@ void LteMacEnb::handleSelfMessage()
 		// requests SDUs to the RLC layer
 		macSduRequest();
 	}
-	EV << "========================================== END DOWNLINK ============================================" << endl;
+	EV_MAC << "========================================== END DOWNLINK ============================================" << endl;
 
 	// purge from corrupted PDUs all Rx H-HARQ buffers for all users
 	for (; hit != het; hit++)
@@ -911,11 +934,9 @@ void LteMacEnb::handleSelfMessage()
 
 	// Message that triggers flushing of Tx H-ARQ buffers for all users
 	// This way, flushing is performed after the (possible) reception of new MAC PDUs
-	cMessage* flushHarqMsg = new cMessage("flushHarqMsg");
-	flushHarqMsg->setSchedulingPriority(1);        // after other messages
-	scheduleAt(NOW, flushHarqMsg);
+	scheduleAt(NOW, flushHarqMsg_);
 
-	EV << "--- END ENB MAIN LOOP ---" << endl;
+	EV_MAC << "--- END ENB MAIN LOOP ---" << endl;
 }
 
 void LteMacEnb::flushHarqBuffers()
@@ -933,36 +954,12 @@ void LteMacEnb::macHandleFeedbackPkt(cPacket *pktAux)
 	auto fb = pkt->peekAtFront<LteFeedbackPkt>();
 
 	//LteFeedbackPkt* fb = check_and_cast<LteFeedbackPkt*>(pkt);
-	LteFeedbackDoubleVector fbMapDl = fb->getLteFeedbackDoubleVectorDl();
-	LteFeedbackDoubleVector fbMapUl = fb->getLteFeedbackDoubleVectorUl();
 	//get Source Node Id<
 	MacNodeId id = fb->getSourceNodeId();
-	LteFeedbackDoubleVector::iterator it;
-	LteFeedbackVector::iterator jt;
 
-	for (it = fbMapDl.begin(); it != fbMapDl.end(); ++it)
-	{
-		unsigned int i = 0;
-		for (jt = it->begin(); jt != it->end(); ++jt)
-		{
-			//            TxMode rx=(TxMode)i;
-			if (!jt->isEmptyFeedback())
-			{
-				amc_->pushFeedback(id, DL, (*jt));
-				// LteMacUe* macUe = check_and_cast<LteMacUe*>(getMacByMacNodeId(id));
-				//  macUe->collectCqiStatistics(id, DL, (*jt));
-			}
-			i++;
-		}
-	}
-	for (it = fbMapUl.begin(); it != fbMapUl.end(); ++it)
-	{
-		for (jt = it->begin(); jt != it->end(); ++jt)
-		{
-			if (!jt->isEmptyFeedback())
-				amc_->pushFeedback(id, UL, (*jt));
-		}
-	}
+	// only non-empty feedbacks are stored in the AMC
+	amc_->pushFeedback(id, DL, fb->getLteFeedbackDoubleVectorDl());
+	amc_->pushFeedback(id, UL, fb->getLteFeedbackDoubleVectorUl());
 	delete pkt;
 }
 
@@ -35,6 +35,9 @@ class SIMULTE_API LteMacEnb : public LteMacBase
     /// List of scheduled users - Downlink
     LteMacScheduleList* scheduleListDl_;
 
+    /// Triggers the flushing of the Tx H-ARQ buffers at the end of each TTI
+    omnetpp::cMessage* flushHarqMsg_;
+
     int eNodeBCount;
 
     /**
@@ -59,6 +62,9 @@ class SIMULTE_API LteMacEnb : public LteMacBase
     /// Buffer for the BSRs
     LteMacBufferMap bsrbuf_;
 
+    /// UL connections with a non-empty BSR buffer
+    ActiveSet bsrBacklog_;
+
     /// Lte Mac Scheduler - Downlink
     LteSchedulerEnbDl* enbSchedulerDl_;
 
@@ -176,6 +182,14 @@ class SIMULTE_API LteMacEnb : public LteMacBase
         return &bsrbuf_;
     }
 
+    /**
+     * Removes a UL connection from the BSR backlog if its BSR buffer
+     * has been emptied. Called by the schedulers after serving it.
+     *
+     * @param cid connection served by a grant
+     */
+    void pruneBsrBacklog(MacCid cid);
+
     /**
      * deleteQueues() on ENB performs actions
      * from base class and also deletes the BSR buffer
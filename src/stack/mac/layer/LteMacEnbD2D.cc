@@ -15,6 +15,7 @@
 #include "stack/mac/scheduler/LteSchedulerEnbUl.h"
 #include "stack/mac/packet/LteSchedulingGrant.h"
 #include "stack/mac/conflict_graph/DistanceBasedConflictGraph.h"
+#include "common/LteProfiler.h"
 
 Define_Module(LteMacEnbD2D);
 
@@ -91,30 +92,17 @@ void LteMacEnbD2D::macHandleFeedbackPkt(cPacket *pktAux)
         //get Source Node Id<
         MacNodeId id = fb->getSourceNodeId();
         std::map<MacNodeId, LteFeedbackDoubleVector>::iterator mapIt;
-        LteFeedbackDoubleVector::iterator it;
-        LteFeedbackVector::iterator jt;
 
         // extract feedback for D2D links
         for (mapIt = fbMapD2D.begin(); mapIt != fbMapD2D.end(); ++mapIt)
-        {
-            MacNodeId peerId = mapIt->first;
-            for (it = mapIt->second.begin(); it != mapIt->second.end(); ++it)
-            {
-                for (jt = it->begin(); jt != it->end(); ++jt)
-                {
-                    if (!jt->isEmptyFeedback())
-                    {
-                        amc_->pushFeedbackD2D(id, (*jt), peerId);
-                    }
-                }
-            }
-        }
+            amc_->pushFeedbackD2D(id, mapIt->second, mapIt->first);
     }
     LteMacEnb::macHandleFeedbackPkt(pkt);
 }
 
 void LteMacEnbD2D::handleMessage(cMessage* msg)
 {
+    LTE_PROFILE_SCOPE(this, "handleMessage");
     if (msg->isSelfMessage() && msg->isName("D2DModeSwitchNotification"))
     {
         cPacket* pkt = check_and_cast<cPacket*>(msg);
@@ -299,19 +287,17 @@ void LteMacEnbD2D::clearBsrBuffers(MacNodeId ueId)
 {
     EV << NOW << "LteMacEnbD2D::clearBsrBuffers - Clear BSR buffers of UE " << ueId << endl;
 
-    // empty all BSR buffers belonging to the UE
-    LteMacBufferMap::iterator vit = bsrbuf_.begin();
-    for (; vit != bsrbuf_.end(); ++vit)
+    // empty all the non-empty BSR buffers belonging to the UE
+    ActiveSet::iterator bt = bsrBacklog_.lower_bound(idToMacCid(ueId, 0));
+    ActiveSet::iterator et = bsrBacklog_.upper_bound(idToMacCid(ueId, 0xFFFF));
+    for (ActiveSet::iterator it = bt; it != et; ++it)
     {
-        MacCid cid = vit->first;
-        // check if this buffer is for this UE
-        if (MacCidToNodeId(cid) != ueId)
-            continue;
+        MacCid cid = *it;
 
         EV << NOW << "LteMacEnbD2D::clearBsrBuffers - Clear BSR buffer for cid " << cid << endl;
 
         // empty its BSR buffer
-        LteMacBuffer* buf = vit->second;
+        LteMacBuffer* buf = bsrbuf_.at(cid);
         EV << NOW << "LteMacEnbD2D::clearBsrBuffers - Length was " << buf->getQueueOccupancy() << endl;
 
         while (!buf->isEmpty())
@@ -320,6 +306,7 @@ void LteMacEnbD2D::clearBsrBuffers(MacNodeId ueId)
         EV << NOW << "LteMacEnbD2D::clearBsrBuffers - New length is " << buf->getQueueOccupancy() << endl;
 
     }
+    bsrBacklog_.erase(bt, et);
 }
 
 HarqBuffersMirrorD2D* LteMacEnbD2D::getHarqBuffersMirrorD2D()
@@ -25,6 +25,8 @@
 #include "common/LteCommon.h"
 #include "stack/rlc/packet/LteRlcDataPdu.h"
 #include "stack/rlc/am/packet/LteRlcAmPdu_m.h"
+#include "stack/rlc/packet/LteRlcNewData_m.h"
+#include "common/LteProfiler.h"
 
 Define_Module(LteMacUe);
 
@@ -152,6 +154,7 @@ void LteMacUe::initialize(int stage)
 
 void LteMacUe::handleMessage(cMessage* msg)
 {
+    LTE_PROFILE_SCOPE(this, "handleMessage");
     if (msg->isSelfMessage())
     {
         if (strcmp(msg->getName(), "flushHarqMsg") == 0)
@@ -166,7 +169,7 @@ void LteMacUe::handleMessage(cMessage* msg)
 
 int LteMacUe::macSduRequest()
 {
-    EV << "----- START LteMacUe::macSduRequest -----\n";
+    EV_MAC << "----- START LteMacUe::macSduRequest -----\n";
     int numRequestedSdus = 0;
 
     // get the number of granted bytes for each codeword
@@ -198,7 +201,7 @@ int LteMacUe::macSduRequest()
         // consume bytes on this codeword
         allocatedBytes[cw] -= sduSize;
 
-        EV << NOW <<" LteMacUe::macSduRequest - cid[" << destCid << "] - sdu size[" << sduSize<< "B] - " << allocatedBytes[cw] << " bytes left on codeword " << cw << endl;
+        EV_MAC << NOW <<" LteMacUe::macSduRequest - cid[" << destCid << "] - sdu size[" << sduSize<< "B] - " << allocatedBytes[cw] << " bytes left on codeword " << cw << endl;
 
         // send the request message to the upper layer
         // TODO: Replace by tag
@@ -215,7 +218,7 @@ int LteMacUe::macSduRequest()
         numRequestedSdus++;
     }
 
-    EV << "------ END LteMacUe::macSduRequest ------\n";
+    EV_MAC << "------ END LteMacUe::macSduRequest ------\n";
     return numRequestedSdus;
 }
 
@@ -260,7 +263,7 @@ bool LteMacUe::bufferizePacket(cPacket* pktAux)
 
             lcgMap_.insert(LcgPair(tClass, CidBufferPair(cid, macBuffers_[cid])));
 
-            EV << "LteMacBuffers : Using new buffer on node: " <<
+            EV_MAC << "LteMacBuffers : Using new buffer on node: " <<
             MacCidToNodeId(cid) << " for Lcid: " << MacCidToLcid(cid) << ", Bytes in the Queue: " <<
             vqueue->getQueueOccupancy() << "\n";
         }
@@ -269,7 +272,7 @@ bool LteMacUe::bufferizePacket(cPacket* pktAux)
             LteMacBuffer* vqueue = macBuffers_.find(cid)->second;
             vqueue->pushBack(vpkt);
 
-            EV << "LteMacBuffers : Using old buffer on node: " <<
+            EV_MAC << "LteMacBuffers : Using old buffer on node: " <<
             MacCidToNodeId(cid) << " for Lcid: " << MacCidToLcid(cid) << ", Space left in the Queue: " <<
             vqueue->getQueueOccupancy() << "\n";
         }
@@ -290,7 +293,7 @@ bool LteMacUe::bufferizePacket(cPacket* pktAux)
 
         mbuf_[cid] = queue;
 
-        EV << "LteMacBuffers : Using new buffer on node: " <<
+        EV_MAC << "LteMacBuffers : Using new buffer on node: " <<
         MacCidToNodeId(cid) << " for Lcid: " << MacCidToLcid(cid) << ", Space left in the Queue: " <<
         queue->getQueueSize() - queue->getByteLength() << "\n";
     }
@@ -311,12 +314,12 @@ bool LteMacUe::bufferizePacket(cPacket* pktAux)
                 emit(macBufferOverflowUl_,sample);
             }
 
-            EV << "LteMacBuffers : Dropped packet: queue" << cid << " is full\n";
+            EV_MAC << "LteMacBuffers : Dropped packet: queue" << cid << " is full\n";
             delete pkt;
             return false;
         }
 
-        EV << "LteMacBuffers : Using old buffer on node: " <<
+        EV_MAC << "LteMacBuffers : Using old buffer on node: " <<
         MacCidToNodeId(cid) << " for Lcid: " << MacCidToLcid(cid) << "(cid: " << cid << "), Space left in the Queue: " <<
         queue->getQueueSize() - queue->getByteLength() << "\n";
     }
@@ -424,7 +427,7 @@ void LteMacUe::macPduMake(MacCid cid)
 
         // search for an empty unit within current harq process
         UnitList txList = txBuf->getEmptyUnits(currentHarq_);
-        EV << "LteMacUe::macPduMake - [Used Acid=" << (unsigned int)txList.first << "] , [curr=" << (unsigned int)currentHarq_ << "]" << endl;
+        EV_MAC << "LteMacUe::macPduMake - [Used Acid=" << (unsigned int)txList.first << "] , [curr=" << (unsigned int)currentHarq_ << "]" << endl;
 
         auto macPkt = pit->second;
 
@@ -506,20 +509,20 @@ void LteMacUe::macPduMake(MacCid cid)
             header->pushCe(bsr);
 
             bsrTriggered_ = false;
-            EV << "LteMacUe::macPduMake - BSR with size " << size << "created" << endl;
+            EV_MAC << "LteMacUe::macPduMake - BSR with size " << size << "created" << endl;
         }
 
         // insert updated MacPdu
         macPkt->insertAtFront(header);
 
-        EV << "LteMacUe: pduMaker created PDU: " << macPkt->str() << endl;
+        EV_MAC << "LteMacUe: pduMaker created PDU: " << macPkt->str() << endl;
 
         // TODO: harq test
         // pdu transmission here (if any)
         // txAcid has HARQ_NONE for non-fillable codeword, acid otherwise
         if (txList.second.empty())
         {
-            EV << "macPduMake() : no available process for this MAC pdu in TxHarqBuffer" << endl;
+            EV_MAC << "macPduMake() : no available process for this MAC pdu in TxHarqBuffer" << endl;
             delete macPkt;
         }
         else
@@ -539,7 +542,7 @@ void LteMacUe::macPduUnmake(cPacket* pktAux)
         auto upPkt = macPkt->popSdu();
         take(upPkt);
 
-        EV << "LteMacBase: pduUnmaker extracted SDU" << endl;
+        EV_MAC << "LteMacBase: pduUnmaker extracted SDU" << endl;
 
         // store descriptor for the incoming connection, if not already stored
         auto lteInfo = upPkt->getTag<FlowControlInfo>();
@@ -562,6 +565,14 @@ void LteMacUe::macPduUnmake(cPacket* pktAux)
 
 void LteMacUe::handleUpperMessage(cPacket* pktAux)
 {
+    // new data in the RLC buffers: only update the virtual buffer of the connection
+    LteRlcNewData* newData = dynamic_cast<LteRlcNewData*>(pktAux);
+    if (newData != nullptr)
+    {
+        bufferizeNewData(newData);
+        return;
+    }
+
     auto pkt = check_and_cast<Packet *>(pktAux);
     bool isLteRlcPduNewDataInd = checkIfHeaderType<LteRlcPduNewData>(pkt);
 
@@ -577,7 +588,7 @@ void LteMacUe::handleUpperMessage(cPacket* pktAux)
             // make PDU and BSR (if necessary)
             macPduMake();
             // update current harq process id
-            EV << NOW << " LteMacUe::handleMessage - incrementing counter for HARQ processes " << (unsigned int)currentHarq_ << " --> " << (currentHarq_+1)%harqProcesses_ << endl;
+            EV_MAC << NOW << " LteMacUe::handleMessage - incrementing counter for HARQ processes " << (unsigned int)currentHarq_ << " --> " << (currentHarq_+1)%harqProcesses_ << endl;
             currentHarq_ = (currentHarq_+1) % harqProcesses_;
         }
     }
@@ -585,7 +596,7 @@ void LteMacUe::handleUpperMessage(cPacket* pktAux)
 
 void LteMacUe::handleSelfMessage()
 {
-    EV << "----- UE MAIN LOOP -----" << endl;
+    EV_MAC << "----- UE MAIN LOOP -----" << endl;
 
     // extract pdus from all harqrxbuffers and pass them to unmaker
     HarqRxBuffers::iterator hit = harqRxBuffers_.begin();
@@ -604,7 +615,7 @@ void LteMacUe::handleSelfMessage()
         }
     }
 
-    EV << NOW << "LteMacUe::handleSelfMessage " << nodeId_ << " - HARQ process " << (unsigned int)currentHarq_ << endl;
+    EV_MAC << NOW << "LteMacUe::handleSelfMessage " << nodeId_ << " - HARQ process " << (unsigned int)currentHarq_ << endl;
     // updating current HARQ process for next TTI
 
     // no grant available - if user has backlogged data, it will trigger scheduling request
@@ -612,7 +623,7 @@ void LteMacUe::handleSelfMessage()
 
     if (schedulingGrant_==nullptr)
     {
-        EV << NOW << " LteMacUe::handleSelfMessage " << nodeId_ << " NO configured grant" << endl;
+        EV_MAC << NOW << " LteMacUe::handleSelfMessage " << nodeId_ << " NO configured grant" << endl;
 
 //        if (!bsrTriggered_)
 //        {
@@ -649,19 +660,19 @@ void LteMacUe::handleSelfMessage()
     {
         if(!firstTx)
         {
-            EV << "\t currentHarq_ counter initialized " << endl;
+            EV_MAC << "\t currentHarq_ counter initialized " << endl;
             firstTx=true;
             // the eNb will receive the first pdu in 2 TTI, thus initializing acid to 0
             currentHarq_ = UE_TX_HARQ_PROCESSES - 2;
         }
-        EV << "\t " << schedulingGrant_ << endl;
+        EV_MAC << "\t " << schedulingGrant_ << endl;
 
 //        //! \TEST  Grant Synchronization check
 //        if (!(schedulingGrant_->getPeriodic()))
 //        {
 //            if ( false /* TODO currentHarq!=grant_->getAcid()*/)
 //            {
-//                EV << NOW << "FATAL! Ue " << nodeId_ << " Current Process is " << (int)currentHarq << " while Stored grant refers to acid " << /*(int)grant_->getAcid() << */  ". Aborting.   " << endl;
+//                EV_MAC << NOW << "FATAL! Ue " << nodeId_ << " Current Process is " << (int)currentHarq << " while Stored grant refers to acid " << /*(int)grant_->getAcid() << */  ". Aborting.   " << endl;
 //                abort();
 //            }
 //        }
@@ -675,7 +686,7 @@ void LteMacUe::handleSelfMessage()
 //        } else {
         // buffer drop should occour here.
 
-        EV << NOW << " LteMacUe::handleSelfMessage " << nodeId_ << " entered scheduling" << endl;
+        EV_MAC << NOW << " LteMacUe::handleSelfMessage " << nodeId_ << " entered scheduling" << endl;
 
         bool retx = false;
 
@@ -683,14 +694,14 @@ void LteMacUe::handleSelfMessage()
         LteHarqBufferTx * currHarq;
         for(it2 = harqTxBuffers_.begin(); it2 != harqTxBuffers_.end(); it2++)
         {
-            EV << "\t Looking for retx in acid " << (unsigned int)currentHarq_ << endl;
+            EV_MAC << "\t Looking for retx in acid " << (unsigned int)currentHarq_ << endl;
             currHarq = it2->second;
 
             // check if the current process has unit ready for retx
             retx = currHarq->getProcess(currentHarq_)->hasReadyUnits();
             CwList cwListRetx = currHarq->getProcess(currentHarq_)->readyUnitsIds();
 
-            EV << "\t [process=" << (unsigned int)currentHarq_ << "] , [retx=" << ((retx)?"true":"false")
+            EV_MAC << "\t [process=" << (unsigned int)currentHarq_ << "] , [retx=" << ((retx)?"true":"false")
                << "] , [n=" << cwListRetx.size() << "]" << endl;
 
             // if a retransmission is needed
@@ -728,7 +739,7 @@ void LteMacUe::handleSelfMessage()
         // TODO make this part optional to save computations
         HarqTxBuffers::iterator it;
 
-        EV << "\n htxbuf.size " << harqTxBuffers_.size() << endl;
+        EV_MAC << "\n htxbuf.size " << harqTxBuffers_.size() << endl;
 
         int cntOuter = 0;
         int cntInner = 0;
@@ -738,10 +749,10 @@ void LteMacUe::handleSelfMessage()
             BufferStatus harqStatus = currHarq->getBufferStatus();
             BufferStatus::iterator jt = harqStatus.begin(), jet= harqStatus.end();
 
-            EV << "\t cicloOuter " << cntOuter << " - bufferStatus.size=" << harqStatus.size() << endl;
+            EV_MAC << "\t cicloOuter " << cntOuter << " - bufferStatus.size=" << harqStatus.size() << endl;
             for(; jt != jet; ++jt)
             {
-                EV << "\t\t cicloInner " << cntInner << " - jt->size=" << jt->size()
+                EV_MAC << "\t\t cicloInner " << cntInner << " - jt->size=" << jt->size()
                    << " - statusCw(0/1)=" << jt->at(0).second << "/" << jt->at(1).second << endl;
             }
         }
@@ -754,7 +765,7 @@ void LteMacUe::handleSelfMessage()
     {
         purged += hit->second->purgeCorruptedPdus();
     }
-    EV << NOW << " LteMacUe::handleSelfMessage Purged " << purged << " PDUS" << endl;
+    EV_MAC << NOW << " LteMacUe::handleSelfMessage Purged " << purged << " PDUS" << endl;
 
     if (requestedSdus_ == 0)
     {
@@ -762,19 +773,19 @@ void LteMacUe::handleSelfMessage()
         currentHarq_ = (currentHarq_+1) % harqProcesses_;
     }
 
-    EV << "--- END UE MAIN LOOP ---" << endl;
+    EV_MAC << "--- END UE MAIN LOOP ---" << endl;
 }
 
 void
 LteMacUe::macHandleGrant(cPacket* pktAux)
 {
-    EV << NOW << " LteMacUe::macHandleGrant - UE [" << nodeId_ << "] - Grant received" << endl;
+    EV_MAC << NOW << " LteMacUe::macHandleGrant - UE [" << nodeId_ << "] - Grant received" << endl;
 
     auto pkt = check_and_cast<inet::Packet*> (pktAux);
     auto grant = pkt->popAtFront<LteSchedulingGrant>();
     delete pkt;
 
-    EV << NOW << " LteMacUe::macHandleGrant - Direction: " << dirToA(grant->getDirection()) << endl;
+    EV_MAC << NOW << " LteMacUe::macHandleGrant - Direction: " << dirToA(grant->getDirection()) << endl;
 
     // delete old grant
     if (schedulingGrant_!=nullptr)
@@ -792,7 +803,7 @@ LteMacUe::macHandleGrant(cPacket* pktAux)
         expirationCounter_=grant->getExpiration();
     }
 
-    EV << NOW << "Node " << nodeId_ << " received grant of blocks " << grant->getTotalGrantedBlocks()
+    EV_MAC << NOW << "Node " << nodeId_ << " received grant of blocks " << grant->getTotalGrantedBlocks()
        << ", bytes " << grant->getGrantedCwBytes(0) << endl;
 
     // clearing pending RAC requests
@@ -807,7 +818,7 @@ LteMacUe::macHandleRac(cPacket* pktAux)
 
     if (racPkt->getSuccess())
     {
-        EV << "LteMacUe::macHandleRac - Ue " << nodeId_ << " won RAC" << endl;
+        EV_MAC << "LteMacUe::macHandleRac - Ue " << nodeId_ << " won RAC" << endl;
         // is RAC is won, BSR has to be sent
         bsrTriggered_=true;
         // reset RAC counter
@@ -820,7 +831,7 @@ LteMacUe::macHandleRac(cPacket* pktAux)
         // RAC has failed
         if (++currentRacTry_ >= maxRacTryouts_)
         {
-            EV << NOW << " Ue " << nodeId_ << ", RAC reached max attempts : " << currentRacTry_ << endl;
+            EV_MAC << NOW << " Ue " << nodeId_ << ", RAC reached max attempts : " << currentRacTry_ << endl;
             // no more RAC allowed
             //! TODO flush all buffers here
             //reset RAC counter
@@ -832,7 +843,7 @@ LteMacUe::macHandleRac(cPacket* pktAux)
         {
             // recompute backoff timer
             racBackoffTimer_= uniform(minRacBackoff_,maxRacBackoff_);
-            EV << NOW << " Ue " << nodeId_ << " RAC attempt failed, backoff extracted : " << racBackoffTimer_ << endl;
+            EV_MAC << NOW << " Ue " << nodeId_ << " RAC attempt failed, backoff extracted : " << racBackoffTimer_ << endl;
         }
     }
     delete pkt;
@@ -841,7 +852,7 @@ LteMacUe::macHandleRac(cPacket* pktAux)
 void
 LteMacUe::checkRAC()
 {
-    EV << NOW << " LteMacUe::checkRAC , Ue  " << nodeId_ << ", racTimer : " << racBackoffTimer_ << " maxRacTryOuts : " << maxRacTryouts_
+    EV_MAC << NOW << " LteMacUe::checkRAC , Ue  " << nodeId_ << ", racTimer : " << racBackoffTimer_ << " maxRacTryOuts : " << maxRacTryouts_
        << ", raRespTimer:" << raRespTimer_ << endl;
 
     if (racBackoffTimer_>0)
@@ -854,14 +865,14 @@ LteMacUe::checkRAC()
     {
         // decrease RAC response timer
         raRespTimer_--;
-        EV << NOW << " LteMacUe::checkRAC - waiting for previous RAC requests to complete (timer=" << raRespTimer_ << ")" << endl;
+        EV_MAC << NOW << " LteMacUe::checkRAC - waiting for previous RAC requests to complete (timer=" << raRespTimer_ << ")" << endl;
         return;
     }
 
     //     Avoids double requests whithin same TTI window
     if (racRequested_)
     {
-        EV << NOW << " LteMacUe::checkRAC - double RAC request" << endl;
+        EV_MAC << NOW << " LteMacUe::checkRAC - double RAC request" << endl;
         racRequested_=false;
         return;
     }
@@ -880,7 +891,7 @@ LteMacUe::checkRAC()
     }
 
     if (!trigger)
-    EV << NOW << "Ue " << nodeId_ << ",RAC aborted, no data in queues " << endl;
+    EV_MAC << NOW << "Ue " << nodeId_ << ",RAC aborted, no data in queues " << endl;
 
     if ((racRequested_=trigger))
     {
@@ -896,7 +907,7 @@ LteMacUe::checkRAC()
 
         sendLowerPackets(pkt);
 
-        EV << NOW << " Ue  " << nodeId_ << " cell " << cellId_ << " ,RAC request sent to PHY " << endl;
+        EV_MAC << NOW << " Ue  " << nodeId_ << " cell " << cellId_ << " ,RAC request sent to PHY " << endl;
 
         // wait at least  "raRespWinStart_" TTIs before another RAC request
         raRespTimer_ = raRespWinStart_;
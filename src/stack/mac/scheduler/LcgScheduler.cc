@@ -262,22 +262,8 @@ ScheduleList& LcgScheduler::schedule(unsigned int availableBytes, Direction gran
                         elem->sentSdus_++;
 
                     // update buffer
-                    while (alloc > 0)
-                    {
-                        // update pkt info
-                        PacketInfo newPktInfo = vQueue->popFront();
-                        if (newPktInfo.first > alloc)
-                        {
-                            newPktInfo.first = newPktInfo.first - alloc;
-                            vQueue->pushFront(newPktInfo);
-                            alloc = 0;
-                        }
-                        else
-                        {
-                            alloc -= newPktInfo.first;
-                        }
-
-                    }
+                    if (alloc > 0 && vQueue->consumeFront(alloc) > 0)
+                        throw cRuntimeError("Packet queue empty");
 
                     toServe -= availableBytes;
                     availableBytes = 0;
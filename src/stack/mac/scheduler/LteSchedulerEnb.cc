@@ -20,6 +20,7 @@
 #include "stack/mac/scheduling_modules/LteAllocatorBestFit.h"
 #include "stack/mac/buffer/LteMacBuffer.h"
 #include "stack/mac/buffer/LteMacQueue.h"
+#include "common/LteProfiler.h"
 
 using namespace omnetpp;
 
@@ -76,7 +77,8 @@ void LteSchedulerEnb::initialize(Direction dir, LteMacEnb* mac)
 
 LteMacScheduleList* LteSchedulerEnb::schedule()
 {
-    EV << "LteSchedulerEnb::schedule performed by Node: " << mac_->getMacNodeId() << endl;
+    LTE_PROFILE_SCOPE(mac_, "schedule");
+    EV_MAC << "LteSchedulerEnb::schedule performed by Node: " << mac_->getMacNodeId() << endl;
 
     // clearing structures for new scheduling
     scheduleList_.clear();
@@ -86,16 +88,19 @@ LteMacScheduleList* LteSchedulerEnb::schedule()
     initAndResetAllocator();
     //reset AMC structures
     mac_->getAmc()->cleanAmcStructures(direction_,scheduler_->readActiveSet());
+    // tx params have been reset: so is the grant context
+    grantUeInfo_.clear();
+    grantUeIndex_.clear();
 
     // scheduling of retransmission and transmission
-    EV << "___________________________start RTX __________________________________" << endl;
+    EV_MAC << "___________________________start RTX __________________________________" << endl;
     if(!(scheduler_->scheduleRetransmissions()))
     {
-        EV << "____________________________ end RTX __________________________________" << endl;
-        EV << "___________________________start SCHED ________________________________" << endl;
+        EV_MAC << "____________________________ end RTX __________________________________" << endl;
+        EV_MAC << "___________________________start SCHED ________________________________" << endl;
         scheduler_->updateSchedulingInfo();
         scheduler_->schedule();
-        EV << "____________________________ end SCHED ________________________________" << endl;
+        EV_MAC << "____________________________ end SCHED ________________________________" << endl;
     }
 
     // record assigned resource blocks statistics
@@ -127,15 +132,15 @@ unsigned int LteSchedulerEnb::scheduleGrant(MacCid cid, unsigned int bytes, bool
     // else dir == DL
 
     // Get user transmission parameters
-    const UserTxParams& txParams = mac_->getAmc()->computeTxParams(nodeId, dir);
+    const GrantUeInfo& ueInfo = getGrantUeInfo(nodeId, dir);
+    const UserTxParams& txParams = *ueInfo.txParams_;
     //get the number of codewords
-    unsigned int numCodewords = txParams.getLayers().size();
+    unsigned int numCodewords = ueInfo.numCw_;
 
     // TEST: check the number of codewords
     numCodewords = 1;
 
     std::string bands_msg = "BAND_LIMIT_SPECIFIED";
-    std::vector<BandLimit> tempBandLim;
     if (bandLim == nullptr )
     {
         bands_msg = "NO_BAND_SPECIFIED";
@@ -151,29 +156,29 @@ unsigned int LteSchedulerEnb::scheduleGrant(MacCid cid, unsigned int bytes, bool
                 BandLimit elem;
                 // copy the band
                 elem.band_ = Band(i);
-                EV << "Putting band " << i << endl;
+                EV_MAC << "Putting band " << i << endl;
                 // mark as unlimited
                 for (unsigned int j = 0; j < numCodewords; j++)
                 {
-                    EV << "- Codeword " << j << endl;
+                    EV_MAC << "- Codeword " << j << endl;
                     elem.limit_.push_back(-1);
                 }
                 emptyBandLim_.push_back(elem);
             }
         }
-        tempBandLim = emptyBandLim_;
-        bandLim = &tempBandLim;
+        grantBandLim_ = emptyBandLim_;
+        bandLim = &grantBandLim_;
     }
-    EV << "LteSchedulerEnb::grant(" << cid << "," << bytes << "," << terminate << "," << active << "," << eligible << "," << bands_msg << "," << dasToA(antenna) << ")" << endl;
+    EV_MAC << "LteSchedulerEnb::grant(" << cid << "," << bytes << "," << terminate << "," << active << "," << eligible << "," << bands_msg << "," << dasToA(antenna) << ")" << endl;
 
     unsigned int totalAllocatedBytes = 0;  // total allocated data (in bytes)
     unsigned int totalAllocatedBlocks = 0; // total allocated data (in blocks)
 
     // === Perform normal operation for grant === //
 
-    EV << "LteSchedulerEnb::grant --------------------::[ START GRANT ]::--------------------" << endl;
-    EV << "LteSchedulerEnb::grant Cell: " << mac_->getMacCellId() << endl;
-    EV << "LteSchedulerEnb::grant CID: " << cid << "(UE: " << nodeId << ", Flow: " << flowId << ") current Antenna [" << dasToA(antenna) << "]" << endl;
+    EV_MAC << "LteSchedulerEnb::grant --------------------::[ START GRANT ]::--------------------" << endl;
+    EV_MAC << "LteSchedulerEnb::grant Cell: " << mac_->getMacCellId() << endl;
+    EV_MAC << "LteSchedulerEnb::grant CID: " << cid << "(UE: " << nodeId << ", Flow: " << flowId << ") current Antenna [" << dasToA(antenna) << "]" << endl;
 
     //! Multiuser MIMO support
     if (mac_->muMimo() && (txParams.readTxMode() == MULTI_USER))
@@ -185,13 +190,13 @@ unsigned int LteSchedulerEnb::scheduleGrant(MacCid cid, unsigned int bytes, bool
             // this user has a valid pairing
             //1) register pairing  - if pairing is already registered false is returned
             if (allocator_->configureMuMimoPeering(nodeId, peer))
-                EV << "LteSchedulerEnb::grant MU-MIMO pairing established: main user [" << nodeId << "], paired user [" << peer << "]" << endl;
+                EV_MAC << "LteSchedulerEnb::grant MU-MIMO pairing established: main user [" << nodeId << "], paired user [" << peer << "]" << endl;
             else
-                EV << "LteSchedulerEnb::grant MU-MIMO pairing already exists between users [" << nodeId << "] and [" << peer << "]" << endl;
+                EV_MAC << "LteSchedulerEnb::grant MU-MIMO pairing already exists between users [" << nodeId << "] and [" << peer << "]" << endl;
         }
         else
         {
-            EV << "LteSchedulerEnb::grant no MU-MIMO pairing available for user [" << nodeId << "]" << endl;
+            EV_MAC << "LteSchedulerEnb::grant no MU-MIMO pairing available for user [" << nodeId << "]" << endl;
         }
     }
 
@@ -201,8 +206,9 @@ unsigned int LteSchedulerEnb::scheduleGrant(MacCid cid, unsigned int bytes, bool
 
     // search for already allocated codeword
     unsigned int cwAlredyAllocated = 0;
-    if (allocatedCws_.find(nodeId) != allocatedCws_.end())
-        cwAlredyAllocated = allocatedCws_.at(nodeId);
+    LteMacAllocatedCws::iterator cwIt = allocatedCws_.find(nodeId);
+    if (cwIt != allocatedCws_.end())
+        cwAlredyAllocated = cwIt->second;
 
     // Check OFDM space
     // OFDM space is not zero if this if we are trying to allocate the second cw in SPMUX or
@@ -212,7 +218,7 @@ unsigned int LteSchedulerEnb::scheduleGrant(MacCid cid, unsigned int bytes, bool
         (txParams.readTxMode() != MULTI_USER || plane != MU_MIMO_PLANE)))
     {
         terminate = true; // ODFM space ended, issuing terminate flag
-        EV << "LteSchedulerEnb::grant Space ended, no schedulation." << endl;
+        EV_MAC << "LteSchedulerEnb::grant Space ended, no schedulation." << endl;
         return 0;
     }
 
@@ -230,23 +236,23 @@ unsigned int LteSchedulerEnb::scheduleGrant(MacCid cid, unsigned int bytes, bool
     if (debug)
     {
         if (limitBl)
-            EV << "LteSchedulerEnb::grant blocks: " << bytes << endl;
+            EV_MAC << "LteSchedulerEnb::grant blocks: " << bytes << endl;
         else
-            EV << "LteSchedulerEnb::grant Bytes: " << bytes << endl;
-        EV << "LteSchedulerEnb::grant Bands: {";
+            EV_MAC << "LteSchedulerEnb::grant Bytes: " << bytes << endl;
+        EV_MAC << "LteSchedulerEnb::grant Bands: {";
         unsigned int size = (*bandLim).size();
         if (size > 0)
         {
-            EV << (*bandLim).at(0).band_;
+            EV_MAC << (*bandLim).at(0).band_;
             for(unsigned int i = 1; i < size; i++)
-                EV << ", " << (*bandLim).at(i).band_;
+                EV_MAC << ", " << (*bandLim).at(i).band_;
         }
-        EV << "}\n";
+        EV_MAC << "}\n";
     }
     // ===== END DEBUG OUTPUT ===== //
 
-    EV << "LteSchedulerEnb::grant TxMode: " << txModeToA(txParams.readTxMode()) << endl;
-    EV << "LteSchedulerEnb::grant Available codewords: " << numCodewords << endl;
+    EV_MAC << "LteSchedulerEnb::grant TxMode: " << txModeToA(txParams.readTxMode()) << endl;
+    EV_MAC << "LteSchedulerEnb::grant Available codewords: " << numCodewords << endl;
 
     // Retrieve the first free codeword checking the eligibility - check eligibility could modify current cw index.
     Codeword cw = 0; // current codeword, modified by reference by the checkeligibility function
@@ -254,10 +260,10 @@ unsigned int LteSchedulerEnb::scheduleGrant(MacCid cid, unsigned int bytes, bool
     {
         eligible = false;
 
-        EV << "LteSchedulerEnb::grant @@@@@ CODEWORD " << cw << " @@@@@" << endl;
-        EV << "LteSchedulerEnb::grant Total allocation: " << totalAllocatedBytes << "bytes" << endl;
-        EV << "LteSchedulerEnb::grant NOT ELIGIBLE!!!" << endl;
-        EV << "LteSchedulerEnb::grant --------------------::[  END GRANT  ]::--------------------" << endl;
+        EV_MAC << "LteSchedulerEnb::grant @@@@@ CODEWORD " << cw << " @@@@@" << endl;
+        EV_MAC << "LteSchedulerEnb::grant Total allocation: " << totalAllocatedBytes << "bytes" << endl;
+        EV_MAC << "LteSchedulerEnb::grant NOT ELIGIBLE!!!" << endl;
+        EV_MAC << "LteSchedulerEnb::grant --------------------::[  END GRANT  ]::--------------------" << endl;
         return totalAllocatedBytes; // return the total number of served bytes
     }
 
@@ -269,8 +275,8 @@ unsigned int LteSchedulerEnb::scheduleGrant(MacCid cid, unsigned int bytes, bool
     if (queueLength == 0)
     {
         active = false;
-        EV << "LteSchedulerEnb::scheduleGrant - scheduled connection is no more active . Exiting grant " << endl;
-        EV << "LteSchedulerEnb::grant --------------------::[  END GRANT  ]::--------------------" << endl;
+        EV_MAC << "LteSchedulerEnb::scheduleGrant - scheduled connection is no more active . Exiting grant " << endl;
+        EV_MAC << "LteSchedulerEnb::grant --------------------::[  END GRANT  ]::--------------------" << endl;
         return totalAllocatedBytes;
     }
 
@@ -278,36 +284,37 @@ unsigned int LteSchedulerEnb::scheduleGrant(MacCid cid, unsigned int bytes, bool
     unsigned int toServe = 0;
     for (; cw < numCodewords; ++cw)
     {
-        EV << "LteSchedulerEnb::grant @@@@@ CODEWORD " << cw << " @@@@@" << endl;
+        EV_MAC << "LteSchedulerEnb::grant @@@@@ CODEWORD " << cw << " @@@@@" << endl;
 
         queueLength += MAC_HEADER + RLC_HEADER_UM;  // TODO RLC may be either UM or AM
         toServe = queueLength;
-        EV << "LteSchedulerEnb::scheduleGrant bytes to be allocated: " << toServe << endl;
+        EV_MAC << "LteSchedulerEnb::scheduleGrant bytes to be allocated: " << toServe << endl;
 
         unsigned int cwAllocatedBytes = 0;  // per codeword allocated bytes
         unsigned int cwAllocatedBlocks = 0; // used by uplink only, for signaling cw blocks usage to schedule list
         unsigned int vQueueItemCounter = 0; // per codeword MAC SDUs counter
 
+        // search for already allocated codeword (it does not change while looping on bands)
         unsigned int allocatedCws = 0;
+        cwIt = allocatedCws_.find(nodeId);
+        if (cwIt != allocatedCws_.end())
+            allocatedCws = cwIt->second;
+
         unsigned int size = (*bandLim).size();
         for (unsigned int i = 0; i < size; ++i) // for each band
         {
             // save the band and the relative limit
             Band b = (*bandLim).at(i).band_;
             int limit = (*bandLim).at(i).limit_.at(cw);
-            EV << "LteSchedulerEnb::grant --- BAND " << b << " LIMIT " << limit << "---" << endl;
+            EV_MAC << "LteSchedulerEnb::grant --- BAND " << b << " LIMIT " << limit << "---" << endl;
 
             // if the limit flag is set to skip, jump off
             if (limit == -2)
             {
-                EV << "LteSchedulerEnb::grant skipping logical band according to limit value" << endl;
+                EV_MAC << "LteSchedulerEnb::grant skipping logical band according to limit value" << endl;
                 continue;
             }
 
-            // search for already allocated codeword
-            if (allocatedCws_.find(nodeId) != allocatedCws_.end())
-                allocatedCws = allocatedCws_.at(nodeId);
-
             unsigned int bandAvailableBytes = 0;
             unsigned int bandAvailableBlocks = 0;
             // if there is a previous blocks allocation on the first codeword, blocks allocation is already available
@@ -317,18 +324,25 @@ unsigned int LteSchedulerEnb::scheduleGrant(MacCid cid, unsigned int bytes, bool
                 int b1 = allocator_->getBlocks(antenna, b, nodeId);
                 // limit eventually allocated blocks on other codeword to limit for current cw
                 bandAvailableBlocks = (limitBl ? (b1 > limit ? limit : b1) : b1);
-                bandAvailableBytes = mac_->getAmc()->computeBytesOnNRbs(nodeId, b, cw, bandAvailableBlocks, dir);
+                bandAvailableBytes = grantBytesOnNRbs(ueInfo, cw, bandAvailableBlocks);
             }
-            else // if limit is expressed in blocks, limit value must be passed to availableBytes function
+            else // if limit is expressed in blocks, it caps the blocks used to compute the available bytes
             {
-                bandAvailableBytes = availableBytes(nodeId, antenna, b, cw, dir, (limitBl) ? limit : -1); // available space (in bytes)
                 bandAvailableBlocks = allocator_->availableBlocks(nodeId, antenna, b);
+                int blocks = bandAvailableBlocks;
+                if (limitBl && limit != -1)
+                {
+                    if (limit > blocks)
+                        throw cRuntimeError("LteSchedulerEnb::scheduleGrant signaled limit inconsistency with available space band b %d, limit %d, available blocks %d", b, limit, blocks);
+                    blocks = limit;
+                }
+                bandAvailableBytes = grantBytesOnNRbs(ueInfo, cw, blocks); // available space (in bytes)
             }
 
             // if no allocation can be performed, notify to skip the band on next processing (if any)
             if (bandAvailableBytes == 0)
             {
-                EV << "LteSchedulerEnb::grant Band " << b << "will be skipped since it has no space left." << endl;
+                EV_MAC << "LteSchedulerEnb::grant Band " << b << "will be skipped since it has no space left." << endl;
                 (*bandLim).at(i).limit_.at(cw) = -2;
                 continue;
             }
@@ -340,7 +354,7 @@ unsigned int LteSchedulerEnb::scheduleGrant(MacCid cid, unsigned int bytes, bool
                 if (limit >= 0 && limit < (int) bandAvailableBytes)
                 {
                     bandAvailableBytes = limit;
-                    EV << "LteSchedulerEnb::grant Band space limited to " << bandAvailableBytes << " bytes according to limit cap" << endl;
+                    EV_MAC << "LteSchedulerEnb::grant Band space limited to " << bandAvailableBytes << " bytes according to limit cap" << endl;
                 }
             }
             else
@@ -349,14 +363,14 @@ unsigned int LteSchedulerEnb::scheduleGrant(MacCid cid, unsigned int bytes, bool
                 if(limit >= 0 && limit < (int) bandAvailableBlocks)
                 {
                     bandAvailableBlocks=limit;
-                    EV << "LteSchedulerEnb::grant Band space limited to " << bandAvailableBlocks << " blocks according to limit cap" << endl;
+                    EV_MAC << "LteSchedulerEnb::grant Band space limited to " << bandAvailableBlocks << " blocks according to limit cap" << endl;
                 }
             }
 
-            EV << "LteSchedulerEnb::grant Available Bytes: " << bandAvailableBytes << " available blocks " << bandAvailableBlocks << endl;
+            EV_MAC << "LteSchedulerEnb::grant Available Bytes: " << bandAvailableBytes << " available blocks " << bandAvailableBlocks << endl;
 
             unsigned int uBytes = (bandAvailableBytes > queueLength) ? queueLength : bandAvailableBytes;
-            unsigned int uBlocks = mac_->getAmc()->computeReqRbs(nodeId, b, cw, uBytes, dir);
+            unsigned int uBlocks = grantReqRbs(ueInfo, cw, uBytes);
 
             // allocate resources on this band
             if(allocatedCws == 0)
@@ -397,35 +411,16 @@ unsigned int LteSchedulerEnb::scheduleGrant(MacCid cid, unsigned int bytes, bool
 
         // number of bytes to be consumed from the virtual buffer
         unsigned int consumedBytes = cwAllocatedBytes - (MAC_HEADER + RLC_HEADER_UM);  // TODO RLC may be either UM or AM
-        while (!conn->isEmpty() && consumedBytes > 0)
-        {
-            unsigned int vPktSize = conn->front().first;
-            if (vPktSize <= consumedBytes)
-            {
-                // serve the entire vPkt, remove pkt info
-                conn->popFront();
-                consumedBytes -= vPktSize;
-                EV << "LteSchedulerEnb::grant - the first SDU/BSR is served entirely, remove it from the virtual buffer, remaining bytes to serve[" << consumedBytes << "]" << endl;
-            }
-            else
-            {
-                // serve partial vPkt, update pkt info
-                PacketInfo newPktInfo = conn->popFront();
-                newPktInfo.first = newPktInfo.first - consumedBytes;
-                conn->pushFront(newPktInfo);
-                consumedBytes = 0;
-                EV << "LteSchedulerEnb::grant - the first SDU/BSR is partially served, update its size [" << newPktInfo.first << "]" << endl;
-            }
-        }
+        conn->consumeFront(consumedBytes);
+        EV_MAC << "LteSchedulerEnb::grant - served " << consumedBytes << " bytes from the virtual buffer, remaining occupancy[" << conn->getQueueOccupancy() << "]" << endl;
+        if (dir != DL && conn->isEmpty())
+            mac_->pruneBsrBacklog(cid);
 
-        EV << "LteSchedulerEnb::grant Codeword allocation: " << cwAllocatedBytes << "bytes" << endl;
+        EV_MAC << "LteSchedulerEnb::grant Codeword allocation: " << cwAllocatedBytes << "bytes" << endl;
         if (cwAllocatedBytes > 0)
         {
             // mark codeword as used
-            if (allocatedCws_.find(nodeId) != allocatedCws_.end())
-                allocatedCws_.at(nodeId)++;
-            else
-                allocatedCws_[nodeId] = 1;
+            ++allocatedCws_[nodeId];
 
             totalAllocatedBytes += cwAllocatedBytes;
 
@@ -438,7 +433,7 @@ unsigned int LteSchedulerEnb::scheduleGrant(MacCid cid, unsigned int bytes, bool
             // otherwise it contains number of granted blocks
             scheduleList_[scListId] += ((dir == DL) ? vQueueItemCounter : cwAllocatedBlocks);
 
-            EV << "LteSchedulerEnb::grant CODEWORD IS NOW BUSY: GO TO NEXT CODEWORD." << endl;
+            EV_MAC << "LteSchedulerEnb::grant CODEWORD IS NOW BUSY: GO TO NEXT CODEWORD." << endl;
             if (allocatedCws_.at(nodeId) == MAX_CODEWORDS)
             {
                 eligible = false;
@@ -447,7 +442,7 @@ unsigned int LteSchedulerEnb::scheduleGrant(MacCid cid, unsigned int bytes, bool
         }
         else
         {
-            EV << "LteSchedulerEnb::grant CODEWORD IS FREE: NO ALLOCATION IS POSSIBLE IN NEXT CODEWORD." << endl;
+            EV_MAC << "LteSchedulerEnb::grant CODEWORD IS FREE: NO ALLOCATION IS POSSIBLE IN NEXT CODEWORD." << endl;
             eligible = false;
             stop = true;
         }
@@ -455,8 +450,8 @@ unsigned int LteSchedulerEnb::scheduleGrant(MacCid cid, unsigned int bytes, bool
             break;
     } // Closes loop on Codewords
 
-    EV << "LteSchedulerEnb::grant Total allocation: " << totalAllocatedBytes << " bytes, " << totalAllocatedBlocks << " blocks" << endl;
-    EV << "LteSchedulerEnb::grant --------------------::[  END GRANT  ]::--------------------" << endl;
+    EV_MAC << "LteSchedulerEnb::grant Total allocation: " << totalAllocatedBytes << " bytes, " << totalAllocatedBlocks << " blocks" << endl;
+    EV_MAC << "LteSchedulerEnb::grant --------------------::[  END GRANT  ]::--------------------" << endl;
 
     return totalAllocatedBytes;
 }
@@ -468,7 +463,7 @@ void LteSchedulerEnb::update()
 
 void LteSchedulerEnb::backlog(MacCid cid)
 {
-    EV << "LteSchedulerEnb::backlog - backlogged data for Logical Cid " << cid << endl;
+    EV_MAC << "LteSchedulerEnb::backlog - backlogged data for Logical Cid " << cid << endl;
     if(cid == 1)
         return;
 
@@ -521,7 +516,7 @@ void LteSchedulerEnb::initAndResetAllocator()
 unsigned int LteSchedulerEnb::availableBytes(const MacNodeId id,
     Remote antenna, Band b, Codeword cw, Direction dir, int limit)
 {
-    EV << "LteSchedulerEnb::availableBytes MacNodeId " << id << " Antenna " << dasToA(antenna) << " band " << b << " cw " << cw << endl;
+    EV_MAC << "LteSchedulerEnb::availableBytes MacNodeId " << id << " Antenna " << dasToA(antenna) << " band " << b << " cw " << cw << endl;
     // Retrieving this user available resource blocks
     int blocks = allocator_->availableBlocks(id,antenna,b);
     //Consistency Check
@@ -531,11 +526,63 @@ unsigned int LteSchedulerEnb::availableBytes(const MacNodeId id,
     if (limit!=-1)
     blocks=(blocks>limit)?limit:blocks;
     unsigned int bytes = mac_->getAmc()->computeBytesOnNRbs(id, b, cw, blocks, dir);
-    EV << "LteSchedulerEnb::availableBytes MacNodeId " << id << " blocks [" << blocks << "], bytes [" << bytes << "]" << endl;
+    EV_MAC << "LteSchedulerEnb::availableBytes MacNodeId " << id << " blocks [" << blocks << "], bytes [" << bytes << "]" << endl;
 
     return bytes;
 }
 
+const LteSchedulerEnb::GrantUeInfo& LteSchedulerEnb::getGrantUeInfo(MacNodeId nodeId, Direction dir)
+{
+    unsigned int key = ((unsigned int) dir << 16) | nodeId;
+    std::map<unsigned int, unsigned int>::iterator it = grantUeIndex_.find(key);
+    if (it != grantUeIndex_.end())
+        return grantUeInfo_[it->second];
+
+    LteAmc* amc = mac_->getAmc();
+    const UserTxParams& txParams = amc->computeTxParams(nodeId, dir);
+    const std::vector<unsigned char>& layers = txParams.getLayers();
+    if (layers.size() > MAX_CODEWORDS)
+        throw cRuntimeError("LteSchedulerEnb::getGrantUeInfo - too many codewords (%d) for node %d", (int) layers.size(), nodeId);
+
+    GrantUeInfo info;
+    info.txParams_ = &txParams;
+    info.txMode_ = txParams.readTxMode();
+    info.numCw_ = layers.size();
+    for (Codeword cw = 0; cw < info.numCw_; ++cw)
+    {
+        info.cw_[cw].cqi_ = txParams.readCqiVector().at(cw);
+        info.cw_[cw].layers_ = layers[cw];
+        info.cw_[cw].tbsRow_ = amc->getTbsRowPerCqi(info.cw_[cw].cqi_, dir);
+    }
+
+    grantUeIndex_[key] = grantUeInfo_.size();
+    grantUeInfo_.push_back(info);
+    return grantUeInfo_.back();
+}
+
+unsigned int LteSchedulerEnb::grantBytesOnNRbs(const GrantUeInfo& ue, Codeword cw, unsigned int blocks) const
+{
+    if (cw >= ue.numCw_)
+        throw cRuntimeError("LteSchedulerEnb::grantBytesOnNRbs - invalid codeword %d", cw);
+
+    // if CQI == 0 the UE is out of range, thus no bytes are available
+    const GrantCwInfo& info = ue.cw_[cw];
+    if (info.cqi_ == 0)
+        return 0;
+    return TbsTable::instance().bitsOnNRbs(ue.txMode_, info.layers_, info.tbsRow_, blocks) / 8;
+}
+
+unsigned int LteSchedulerEnb::grantReqRbs(const GrantUeInfo& ue, Codeword cw, unsigned int bytes) const
+{
+    if (bytes == 0)
+        return 0;
+    if (cw >= ue.numCw_)
+        throw cRuntimeError("LteSchedulerEnb::grantReqRbs - invalid codeword %d", cw);
+
+    const GrantCwInfo& info = ue.cw_[cw];
+    return TbsTable::instance().reqRbs(ue.txMode_, info.layers_, info.tbsRow_, bytes * 8);
+}
+
 std::set<Band> LteSchedulerEnb::getOccupiedBands()
 {
    return allocator_->getAllocatorOccupiedBands();
@@ -557,7 +604,7 @@ void LteSchedulerEnb::storeScListId(std::pair<unsigned int, Codeword> scList,uns
 
 LteScheduler* LteSchedulerEnb::getScheduler(SchedDiscipline discipline)
 {
-    EV << "Creating LteScheduler " << schedDisciplineToA(discipline) << endl;
+    EV_MAC << "Creating LteScheduler " << schedDisciplineToA(discipline) << endl;
 
     switch(discipline)
     {
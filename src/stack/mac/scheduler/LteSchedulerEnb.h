@@ -18,6 +18,7 @@
 class LteScheduler;
 class LteAllocationModule;
 class LteMacEnb;
+class UserTxParams;
 
 /**
  * @class LteSchedulerEnb
@@ -111,6 +112,38 @@ class SIMULTE_API LteSchedulerEnb
     // pre-made BandLimit structure used when the no band limit is given to the scheduler
     std::vector<BandLimit> emptyBandLim_;
 
+    /*
+     * Per-TTI grant context.
+     *
+     * Transmission parameters do not change within a TTI (the AMC resets them
+     * in cleanAmcStructures()), so the CQI, layers and TBS row of each codeword
+     * of a UE are resolved once, on its first grant in the TTI. scheduleGrant()
+     * then sizes allocations with TBS table lookups, instead of going through
+     * LteAmc::computeTxParams() twice per band.
+     */
+    struct GrantCwInfo
+    {
+        Cqi cqi_;
+        unsigned char layers_;
+        unsigned int tbsRow_;
+    };
+
+    struct GrantUeInfo
+    {
+        // valid until the end of the current schedule()
+        const UserTxParams* txParams_;
+        TxMode txMode_;
+        unsigned int numCw_;
+        GrantCwInfo cw_[MAX_CODEWORDS];
+    };
+
+    // UEs granted in the current TTI
+    std::vector<GrantUeInfo> grantUeInfo_;
+    // (direction, node id) -> index in grantUeInfo_
+    std::map<unsigned int, unsigned int> grantUeIndex_;
+    // working copy of emptyBandLim_, reused across grants
+    std::vector<BandLimit> grantBandLim_;
+
   public:
 
     /**
@@ -289,6 +322,19 @@ class SIMULTE_API LteSchedulerEnb
      */
     unsigned int availableBytes(const MacNodeId id, const Remote antenna, Band b, Codeword cw, Direction dir, int limit = -1);
 
+    /**
+     * Returns the grant context of the given UE in the current TTI, computing
+     * its transmission parameters on the first call of the TTI.
+     */
+    const GrantUeInfo& getGrantUeInfo(MacNodeId nodeId, Direction dir);
+
+    /**
+     * Same as LteAmc::computeBytesOnNRbs() and LteAmc::computeReqRbs() for a
+     * single codeword, using the grant context of the UE.
+     */
+    unsigned int grantBytesOnNRbs(const GrantUeInfo& ue, Codeword cw, unsigned int blocks) const;
+    unsigned int grantReqRbs(const GrantUeInfo& ue, Codeword cw, unsigned int bytes) const;
+
     unsigned int allocatedCws(MacNodeId nodeId)
     {
         return allocatedCws_[nodeId];
@@ -68,7 +68,7 @@ LteSchedulerEnbDl::schedulePerAcidRtx(MacNodeId nodeId, Codeword cw, unsigned ch
             BandLimit elem;
             // copy the band
             elem.band_ = Band(i);
-            EV << "Putting band " << i << endl;
+            EV_MAC << "Putting band " << i << endl;
             // mark as unlimited
             for (Codeword i = 0; i < MAX_CODEWORDS; ++i)
             {
@@ -78,7 +78,7 @@ LteSchedulerEnbDl::schedulePerAcidRtx(MacNodeId nodeId, Codeword cw, unsigned ch
         }
     }
 
-    EV << NOW << "LteSchedulerEnbDl::rtxAcid - Node [" << mac_->getMacNodeId() << "], User[" << nodeId << "],  Codeword [" << cw << "]  of [" << codewords << "] , ACID [" << (int)acid << "] " << endl;
+    EV_MAC << NOW << "LteSchedulerEnbDl::rtxAcid - Node [" << mac_->getMacNodeId() << "], User[" << nodeId << "],  Codeword [" << cw << "]  of [" << codewords << "] , ACID [" << (int)acid << "] " << endl;
     //! \test REALISTIC!!!  Multi User MIMO support
     if (mac_->muMimo() && (txParams.readTxMode() == MULTI_USER))
     {
@@ -90,16 +90,16 @@ LteSchedulerEnbDl::schedulePerAcidRtx(MacNodeId nodeId, Codeword cw, unsigned ch
             //1) register pairing  - if pairing is already registered false is returned
             if (allocator_->configureMuMimoPeering(nodeId, peer))
             {
-                EV << "LteSchedulerEnb::grant MU-MIMO pairing established: main user [" << nodeId << "], paired user [" << peer << "]" << endl;
+                EV_MAC << "LteSchedulerEnb::grant MU-MIMO pairing established: main user [" << nodeId << "], paired user [" << peer << "]" << endl;
             }
             else
             {
-                EV << "LteSchedulerEnb::grant MU-MIMO pairing already exists between users [" << nodeId << "] and [" << peer << "]" << endl;
+                EV_MAC << "LteSchedulerEnb::grant MU-MIMO pairing already exists between users [" << nodeId << "] and [" << peer << "]" << endl;
             }
         }
         else
         {
-            EV << "LteSchedulerEnb::grant no MU-MIMO pairing available for user [" << nodeId << "]" << endl;
+            EV_MAC << "LteSchedulerEnb::grant no MU-MIMO pairing available for user [" << nodeId << "]" << endl;
         }
     }
                 //!\test experimental DAS support
@@ -146,11 +146,11 @@ LteSchedulerEnbDl::schedulePerAcidRtx(MacNodeId nodeId, Codeword cw, unsigned ch
         Band b = bandLim->at(i).band_;
         int limit = bandLim->at(i).limit_.at(remappedCw);
 
-        EV << "LteSchedulerEnbDl::schedulePerAcidRtx --- BAND " << b << " LIMIT " << limit << "---" << endl;
+        EV_MAC << "LteSchedulerEnbDl::schedulePerAcidRtx --- BAND " << b << " LIMIT " << limit << "---" << endl;
         // if the limit flag is set to skip, jump off
         if (limit == -2)
         {
-            EV << "LteSchedulerEnbDl::schedulePerAcidRtx - skipping logical band according to limit value" << endl;
+            EV_MAC << "LteSchedulerEnbDl::schedulePerAcidRtx - skipping logical band according to limit value" << endl;
             continue;
         }
 
@@ -172,9 +172,9 @@ LteSchedulerEnbDl::schedulePerAcidRtx(MacNodeId nodeId, Codeword cw, unsigned ch
         if (limit >= 0 && !limitBl)
             available = limit < (int) available ? limit : available;
 
-        EV << NOW << "LteSchedulerEnbDl::rtxAcid ----- BAND " << b << "-----" << endl;
-        EV << NOW << "LteSchedulerEnbDl::rtxAcid To serve: " << bytes << " bytes" << endl;
-        EV << NOW << "LteSchedulerEnbDl::rtxAcid Available: " << available << " bytes" << endl;
+        EV_MAC << NOW << "LteSchedulerEnbDl::rtxAcid ----- BAND " << b << "-----" << endl;
+        EV_MAC << NOW << "LteSchedulerEnbDl::rtxAcid To serve: " << bytes << " bytes" << endl;
+        EV_MAC << NOW << "LteSchedulerEnbDl::rtxAcid Available: " << available << " bytes" << endl;
 
         unsigned int allocation = 0;
         if (available < bytes)
@@ -192,7 +192,7 @@ LteSchedulerEnbDl::schedulePerAcidRtx(MacNodeId nodeId, Codeword cw, unsigned ch
         {
             unsigned int blocks = mac_->getAmc()->computeReqRbs(nodeId, b, remappedCw, allocation, direction_);
 
-            EV << NOW << "LteSchedulerEnbDl::rtxAcid Assigned blocks: " << blocks << "  blocks" << endl;
+            EV_MAC << NOW << "LteSchedulerEnbDl::rtxAcid Assigned blocks: " << blocks << "  blocks" << endl;
 
             // assign only on the first codeword
             assignedBlocks.push_back(blocks);
@@ -206,7 +206,7 @@ LteSchedulerEnbDl::schedulePerAcidRtx(MacNodeId nodeId, Codeword cw, unsigned ch
     if (bytes > 0)
     {
         // process couldn't be served
-        EV << NOW << "LteSchedulerEnbDl::rtxAcid Cannot serve HARQ Process" << acid << endl;
+        EV_MAC << NOW << "LteSchedulerEnbDl::rtxAcid Cannot serve HARQ Process" << acid << endl;
         return 0;
     }
 
@@ -228,7 +228,7 @@ LteSchedulerEnbDl::schedulePerAcidRtx(MacNodeId nodeId, Codeword cw, unsigned ch
     signal.first = acid;
     signal.second.push_back(cw);
 
-    EV << NOW << " LteSchedulerEnbDl::rtxAcid HARQ Process " << (int)acid << "  codeword  " << cw << " marking for retransmission " << endl;
+    EV_MAC << NOW << " LteSchedulerEnbDl::rtxAcid HARQ Process " << (int)acid << "  codeword  " << cw << " marking for retransmission " << endl;
 
     // if allocated codewords is not MAX_CODEWORDS, then there's another allocated codeword , update the codewords variable :
 
@@ -255,7 +255,7 @@ LteSchedulerEnbDl::schedulePerAcidRtx(MacNodeId nodeId, Codeword cw, unsigned ch
 
     bytes = currHarq->pduLength(acid, cw);
 
-    EV << NOW << " LteSchedulerEnbDl::rtxAcid HARQ Process " << (int)acid << "  codeword  " << cw << ", " << bytes << " bytes served!" << endl;
+    EV_MAC << NOW << " LteSchedulerEnbDl::rtxAcid HARQ Process " << (int)acid << "  codeword  " << cw << ", " << bytes << " bytes served!" << endl;
 
     return bytes;
 }
@@ -263,9 +263,9 @@ LteSchedulerEnbDl::schedulePerAcidRtx(MacNodeId nodeId, Codeword cw, unsigned ch
 bool
 LteSchedulerEnbDl::rtxschedule()
 {
-    EV << NOW << " LteSchedulerEnbDl::rtxschedule --------------------::[ START RTX-SCHEDULE ]::--------------------" << endl;
-    EV << NOW << " LteSchedulerEnbDl::rtxschedule Cell:  " << mac_->getMacCellId() << endl;
-    EV << NOW << " LteSchedulerEnbDl::rtxschedule Direction: " << (direction_ == DL ? "DL" : "UL") << endl;
+    EV_MAC << NOW << " LteSchedulerEnbDl::rtxschedule --------------------::[ START RTX-SCHEDULE ]::--------------------" << endl;
+    EV_MAC << NOW << " LteSchedulerEnbDl::rtxschedule Cell:  " << mac_->getMacCellId() << endl;
+    EV_MAC << NOW << " LteSchedulerEnbDl::rtxschedule Direction: " << (direction_ == DL ? "DL" : "UL") << endl;
 
     // retrieving reference to HARQ entities
     HarqTxBuffers* harqQueues = mac_->getHarqTxBuffers();
@@ -291,6 +291,11 @@ LteSchedulerEnbDl::rtxschedule()
                 continue;
         }
         LteHarqBufferTx* currHarq = it->second;
+
+        // skip UEs without units waiting for retransmission
+        if (!currHarq->hasReadyUnits())
+            continue;
+
         std::vector<LteHarqProcessTx *> * processes = currHarq->getHarqProcesses();
 
         // Get user transmission parameters
@@ -298,8 +303,8 @@ LteSchedulerEnbDl::rtxschedule()
         // TODO SK Get the number of codewords - FIX with correct mapping
         unsigned int codewords = txParams.getLayers().size();// get the number of available codewords
 
-        EV << NOW << " LteSchedulerEnbDl::rtxschedule  UE: " << nodeId << endl;
-        EV << NOW << " LteSchedulerEnbDl::rtxschedule Number of codewords: " << codewords << endl;
+        EV_MAC << NOW << " LteSchedulerEnbDl::rtxschedule  UE: " << nodeId << endl;
+        EV_MAC << NOW << " LteSchedulerEnbDl::rtxschedule Number of codewords: " << codewords << endl;
 
 
         // get the number of HARQ processes
@@ -317,18 +322,18 @@ LteSchedulerEnbDl::rtxschedule()
 
                 if (allocatedCws_[nodeId]==codewords)
                     break;
-                EV << NOW << " LteSchedulerEnbDl::rtxschedule process " << process << endl;
-                EV << NOW << " LteSchedulerEnbDl::rtxschedule ------- CODEWORD " << cw << endl;
+                EV_MAC << NOW << " LteSchedulerEnbDl::rtxschedule process " << process << endl;
+                EV_MAC << NOW << " LteSchedulerEnbDl::rtxschedule ------- CODEWORD " << cw << endl;
 
                 // skip processes which are not in rtx status
                 if (currProc->getUnitStatus(cw) != TXHARQ_PDU_BUFFERED)
                 {
-                    EV << NOW << " LteSchedulerEnbDl::rtxschedule detected Acid: " << process << " in status " << currProc->getUnitStatus(cw) << endl;
+                    EV_MAC << NOW << " LteSchedulerEnbDl::rtxschedule detected Acid: " << process << " in status " << currProc->getUnitStatus(cw) << endl;
                     continue;
                 }
 
-                EV << NOW << " LteSchedulerEnbDl::rtxschedule " << endl;
-                EV << NOW << " LteSchedulerEnbDl::rtxschedule detected RTX Acid: " << process << endl;
+                EV_MAC << NOW << " LteSchedulerEnbDl::rtxschedule " << endl;
+                EV_MAC << NOW << " LteSchedulerEnbDl::rtxschedule detected RTX Acid: " << process << endl;
 
                 // Get the bandLimit for the current user
                 std::vector<BandLimit>* bandLim;
@@ -344,7 +349,7 @@ LteSchedulerEnbDl::rtxschedule()
                 // if a value different from zero is returned, there was a service
                 if(bytes > 0)
                 {
-                    EV << NOW << " LteSchedulerEnbDl::rtxschedule CODEWORD IS NOW BUSY!!!" << endl;
+                    EV_MAC << NOW << " LteSchedulerEnbDl::rtxschedule CODEWORD IS NOW BUSY!!!" << endl;
                     // do not process this HARQ process anymore
                     // go to next codeword
                     break;
@@ -354,8 +359,8 @@ LteSchedulerEnbDl::rtxschedule()
     }
 
     unsigned int availableBlocks = allocator_->computeTotalRbs();
-    EV << " LteSchedulerEnbDl::rtxschedule OFDM Space: " << availableBlocks << endl;
-    EV << "    LteSchedulerEnbDl::rtxschedule --------------------::[  END RTX-SCHEDULE  ]::-------------------- " << endl;
+    EV_MAC << " LteSchedulerEnbDl::rtxschedule OFDM Space: " << availableBlocks << endl;
+    EV_MAC << "    LteSchedulerEnbDl::rtxschedule --------------------::[  END RTX-SCHEDULE  ]::-------------------- " << endl;
 
     return (availableBlocks == 0);
 }
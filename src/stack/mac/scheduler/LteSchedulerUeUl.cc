@@ -13,6 +13,7 @@
 #include "stack/mac/packet/LteSchedulingGrant.h"
 #include "stack/mac/packet/LteMacPdu.h"
 #include "stack/mac/scheduler/LcgScheduler.h"
+#include "common/LteProfiler.h"
 
 using namespace omnetpp;
 LteSchedulerUeUl::LteSchedulerUeUl(LteMacUe * mac)
@@ -29,6 +30,7 @@ LteSchedulerUeUl::~LteSchedulerUeUl()
 LteMacScheduleList*
 LteSchedulerUeUl::schedule()
 {
+    LTE_PROFILE_SCOPE(mac_, "schedule");
     // 1) Environment Setup
 
     // clean up old scheduling decisions
@@ -486,6 +486,8 @@ void LteAllocatorBestFit::prepareSchedule()
                 // All the bytes have been served
                 byte_served = conn->front().first;
                 conn->popFront();
+                if (conn->isEmpty())
+                    eNbScheduler_->mac_->pruneBsrBacklog(cid);
             }
             else
             {
@@ -115,56 +115,63 @@ void LteDrr::commitSchedule()
 void
 LteDrr::updateSchedulingInfo()
 {
-    // Get connections.
-    LteMacBufferMap* conn;
+    // Select the minimum rate and MAC SDU size.
+    double minSize = 0;
+    double minRate = 0;
 
     if (direction_ == DL)
     {
-        conn = eNbScheduler_->mac_->getMacBuffers();
+        // Iterators to cycle through the maps of connection descriptors.
+        LteMacBufferMap* conn = eNbScheduler_->mac_->getMacBuffers();
+        LteMacBufferMap::iterator it = conn->begin(), et = conn->end();
+        for (; it != et; ++it)
+            updateDrrDesc(it->first, minSize, minRate);
     }
     else if (direction_ == UL)
     {
-        conn = eNbScheduler_->mac_->getBsrVirtualBuffers();
-    } else {
-        conn = nullptr;
+        // only the active connections can be served: skip the buffers of the idle UEs
+        // (a BSR with data notifies its connection as active, see LteMacEnb::bufferizeBsr())
+        LteMacBufferMap* conn = eNbScheduler_->mac_->getBsrVirtualBuffers();
+        ActiveSet::iterator it = activeConnectionSet_.begin(), et = activeConnectionSet_.end();
+        for (; it != et; ++it)
+        {
+            if (conn->find(*it) != conn->end())
+                updateDrrDesc(*it, minSize, minRate);
+        }
+    }
+    else
+    {
         throw cRuntimeError("LteDrr::updateSchedulingInfo invalid direction");
     }
+}
 
-    // Iterators to cycle through the maps of connection descriptors.
-
-    LteMacBufferMap::iterator it = conn->begin(), et = conn->end();
-
-    // Select the minimum rate and MAC SDU size.
-    double minSize = 0;
-    double minRate = 0;
-    for (it = conn->begin(); it != et; ++it)
+void
+LteDrr::updateDrrDesc(MacCid cid, double& minSize, double& minRate)
+{
+//    ConnectionParameters& pars = jt->second.parameters_;
+    MacNodeId nodeId = MacCidToNodeId(cid);
+    bool eligible = true;
+    const UserTxParams& info = eNbScheduler_->mac_->getAmc()->computeTxParams(nodeId, direction_);
+    unsigned int codeword = info.getLayers().size();
+    if (eNbScheduler_->allocatedCws(nodeId) == codeword)
+        eligible = false;
+
+    for (unsigned int i = 0; i < codeword; i++)
     {
-//            ConnectionParameters& pars = jt->second.parameters_;
-        MacCid cid = it->first;
-        MacNodeId nodeId = MacCidToNodeId(cid);
-        bool eligible = true;
-        const UserTxParams& info = eNbScheduler_->mac_->getAmc()->computeTxParams(nodeId, direction_);
-        unsigned int codeword = info.getLayers().size();
-        if (eNbScheduler_->allocatedCws(nodeId) == codeword)
+        if (info.readCqiVector()[i] == 0)
             eligible = false;
+    }
+    if (minRate == 0 /* || pars.minReservedRate_ < minRate*/)
+//        TODO add connections parameters and fix this value
+        minRate = 500;
+    if (minSize == 0 /*|| pars.maxBurst_ < minSize */)
+        minSize = 160; /*pars.maxBurst_;*/
 
-        for (unsigned int i = 0; i < codeword; i++)
-        {
-            if (info.readCqiVector()[i] == 0)
-                eligible = false;
-        }
-        if (minRate == 0 /* || pars.minReservedRate_ < minRate*/)
-//                TODO add connections parameters and fix this value
-            minRate = 500;
-        if (minSize == 0 /*|| pars.maxBurst_ < minSize */)
-            minSize = 160; /*pars.maxBurst_;*/
-
-        // Compute the quanta. If descriptors do not exist they are created.
-        // The values of the other fields, e.g. active status, are not changed.
+    // Compute the quanta. If descriptors do not exist they are created.
+    // The values of the other fields, e.g. active status, are not changed.
 
-        drrMap_[cid].quantum_ = (unsigned int) (ceil(( /*pars.minReservedRate_*/ 500 / minRate) * minSize));
-        drrMap_[cid].eligible_ = eligible;
-    }
+    drrMap_[cid].quantum_ = (unsigned int) (ceil(( /*pars.minReservedRate_*/ 500 / minRate) * minSize));
+    drrMap_[cid].eligible_ = eligible;
 }
 
 void
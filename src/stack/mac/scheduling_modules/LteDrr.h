@@ -74,6 +74,11 @@ class SIMULTE_API LteDrr : public LteScheduler
     void removeActiveConnection(MacCid cid);
 
     void updateSchedulingInfo();
+
+  private:
+
+    /// Updates the quantum and the eligibility of a connection
+    void updateDrrDesc(MacCid cid, double& minSize, double& minRate);
 };
 #endif
 
@@ -14,35 +14,32 @@ using namespace omnetpp;
 
 void LtePf::prepareSchedule()
 {
-    EV << NOW << "LtePf::execSchedule ############### eNodeB " << eNbScheduler_->mac_->getMacNodeId() << " ###############" << endl;
-    EV << NOW << "LtePf::execSchedule Direction: " << ( ( direction_ == DL ) ? " DL ": " UL ") << endl;
+    EV_MAC << NOW << "LtePf::execSchedule ############### eNodeB " << eNbScheduler_->mac_->getMacNodeId() << " ###############" << endl;
+    EV_MAC << NOW << "LtePf::execSchedule Direction: " << ( ( direction_ == DL ) ? " DL ": " UL ") << endl;
 
     if (binder_ == nullptr)
         binder_ = getBinder();
 
-    // Clear structures
-    grantedBytes_.clear();
+    LteAmc* amc = eNbScheduler_->mac_->getAmc();
 
-    // Create a working copy of the active set
-    activeConnectionTempSet_ = activeConnectionSet_;
+    // Reset the per-TTI state of the active flows
+    unsigned int numFlows = flowCid_.size();
+    std::fill(flowGranted_.begin(), flowGranted_.end(), 0);
+    std::fill(flowServed_.begin(), flowServed_.end(), false);
+    std::fill(flowActive_.begin(), flowActive_.end(), true);
 
-    // Build the score list by cycling through the active connections.
-    ScoreList score;
+    // Build the score heap by cycling through the active flows.
+    score_.clear();
 
-    ActiveSet::iterator cidIt = activeConnectionTempSet_.begin();
-    ActiveSet::iterator cidEt = activeConnectionTempSet_.end();
-
-    for(; cidIt != cidEt; )
+    for (unsigned int i = 0; i < numFlows; ++i)
     {
-        MacCid cid = *cidIt;
-        ++cidIt;
+        MacCid cid = flowCid_[i];
         MacNodeId nodeId = MacCidToNodeId(cid);
-        OmnetId id = binder_->getOmnetId(nodeId);
-        if(nodeId == 0 || id == 0)
+        if(nodeId == 0 || binder_->getOmnetId(nodeId) == 0)
         {
             // node has left the simulation - erase corresponding CIDs
-            activeConnectionSet_.erase(cid);
-            activeConnectionTempSet_.erase(cid);
+            flowActive_[i] = false;
+            EV_MAC << "CID " << cid << " of node "<< nodeId << " removed from active connection set - no OmnetId in Binder known.";
             continue;
         }
 
@@ -53,68 +50,59 @@ void LtePf::prepareSchedule()
         else
             dir = DL;
 
-        // check if node is still a valid node in the simulation - might have been dynamically removed
-        if(getBinder()->getOmnetId(nodeId) == 0){
-            activeConnectionTempSet_.erase(cid);
-            EV << "CID " << cid << " of node "<< nodeId << " removed from active connection set - no OmnetId in Binder known.";
-            continue;
-        }
-
         // compute available blocks for the current user
-        const UserTxParams& info = eNbScheduler_->mac_->getAmc()->computeTxParams(nodeId,dir);
+        const UserTxParams& info = amc->computeTxParams(nodeId,dir);
         const std::set<Band>& bands = info.readBands();
         unsigned int codeword=info.getLayers().size();
         if (eNbScheduler_->allocatedCws(nodeId)==codeword)
-        continue;
-        std::set<Band>::const_iterator it = bands.begin(),et=bands.end();
-
-        std::set<Remote>::iterator antennaIt = info.readAntennaSet().begin(), antennaEt=info.readAntennaSet().end();
+            continue;
 
         bool cqiNull=false;
-        for (unsigned int i=0;i<codeword;i++)
+        for (unsigned int c=0;c<codeword;c++)
         {
-            if (info.readCqiVector()[i]==0)
-            cqiNull=true;
+            if (info.readCqiVector()[c]==0)
+                cqiNull=true;
         }
         if (cqiNull)
-        continue;
+            continue;
+
         // compute score based on total available bytes
+        // (as before, the bands are accounted for the first antenna only)
         unsigned int availableBlocks=0;
         unsigned int availableBytes =0;
-        // for each antenna
-        for (;antennaIt!=antennaEt;++antennaIt)
+        if (!info.readAntennaSet().empty())
         {
-            // for each logical band
-            for (;it!=et;++it)
+            Remote antenna = *info.readAntennaSet().begin();
+            for (std::set<Band>::const_iterator it = bands.begin(); it != bands.end(); ++it)
             {
-                availableBlocks += eNbScheduler_->readAvailableRbs(nodeId,*antennaIt,*it);
-                availableBytes += eNbScheduler_->mac_->getAmc()->computeBytesOnNRbs(nodeId,*it, availableBlocks, dir);
+                availableBlocks += eNbScheduler_->readAvailableRbs(nodeId,antenna,*it);
+                availableBytes += amc->computeBytesOnNRbs(info, availableBlocks, dir);
             }
         }
 
         double s=.0;
-
-        if (pfRate_.find(cid)==pfRate_.end()) pfRate_[cid]=0;
-        if(pfRate_[cid] < scoreEpsilon_) s = 1.0 / scoreEpsilon_;
-        else if(availableBlocks > 0) s = ((availableBytes / availableBlocks) / pfRate_[cid]) + uniform(getEnvir()->getRNG(0),-scoreEpsilon_/2.0, scoreEpsilon_/2.0);
+        double rate = flowRate_[i];
+        if(rate < scoreEpsilon_) s = 1.0 / scoreEpsilon_;
+        else if(availableBlocks > 0) s = ((availableBytes / availableBlocks) / rate) + uniform(getEnvir()->getRNG(0),-scoreEpsilon_/2.0, scoreEpsilon_/2.0);
         else s = 0.0;
+
         // Create a new score descriptor for the connection, where the score is equal to the ratio between bytes per slot and long term rate
-        ScoreDesc desc(cid,s);
-        score.push(desc);
+        score_.push_back(ScoreDesc(cid,s));
+        std::push_heap(score_.begin(), score_.end());
 
-        EV << NOW << "LtePf::execSchedule CID " << cid << "- Score = " << s << endl;
+        EV_MAC << NOW << "LtePf::execSchedule CID " << cid << "- Score = " << s << endl;
     }
 
     // Schedule the connections in score order.
-    while(!score.empty())
+    while(!score_.empty())
     {
         // Pop the top connection from the list.
-        ScoreDesc current = score.top();
+        ScoreDesc current = score_.front();
         MacCid cid = current.x_;// The CID
 
-        EV << NOW << "LtePf::execSchedule @@@@@@@@@@@@@@@@@@@@@@@@@@@@@@" << endl;
-        EV << NOW << "LtePf::execSchedule CID: " << cid;
-        EV << NOW << "LtePf::execSchedule Score: " << current.score_ << endl;
+        EV_MAC << NOW << "LtePf::execSchedule @@@@@@@@@@@@@@@@@@@@@@@@@@@@@@" << endl;
+        EV_MAC << NOW << "LtePf::execSchedule CID: " << cid;
+        EV_MAC << NOW << "LtePf::execSchedule Score: " << current.score_ << endl;
 
         // Grant data to that connection.
         bool terminate = false;
@@ -122,31 +110,38 @@ void LtePf::prepareSchedule()
         bool eligible = true;
 
         unsigned int granted = eNbScheduler_->scheduleGrant(cid, 4294967295U, terminate, active, eligible);
-        grantedBytes_[cid] += granted;
+        int flow = findFlow(cid);
+        if (flow >= 0)
+        {
+            flowGranted_[flow] += granted;
+            flowServed_[flow] = true;
+        }
 
-        EV << NOW << "LtePf::execSchedule Granted: " << granted << " bytes" << endl;
+        EV_MAC << NOW << "LtePf::execSchedule Granted: " << granted << " bytes" << endl;
 
         // Exit immediately if the terminate flag is set.
         if(terminate)
         {
-            EV << NOW << "LtePf::execSchedule TERMINATE " << endl;
+            EV_MAC << NOW << "LtePf::execSchedule TERMINATE " << endl;
             break;
         }
 
         // Pop the descriptor from the score list if the active or eligible flag are clear.
         if(!active || !eligible)
         {
-            score.pop ();
+            std::pop_heap(score_.begin(), score_.end());
+            score_.pop_back();
 
             if(!eligible)
-            EV << NOW << "LtePf::execSchedule NOT ELIGIBLE " << endl;
+            EV_MAC << NOW << "LtePf::execSchedule NOT ELIGIBLE " << endl;
         }
 
         // Set the connection as inactive if indicated by the grant ().
         if(!active)
         {
-            EV << NOW << "LtePf::execSchedule NOT ACTIVE" << endl;
-            activeConnectionTempSet_.erase (current.x_);
+            EV_MAC << NOW << "LtePf::execSchedule NOT ACTIVE" << endl;
+            if (flow >= 0)
+                flowActive_[flow] = false;
         }
     }
 }
@@ -154,36 +149,71 @@ void LtePf::prepareSchedule()
 void LtePf::commitSchedule()
 {
     unsigned int total = eNbScheduler_->resourceBlocks_;
+    unsigned int numFlows = flowCid_.size();
 
-    std::map<MacCid, unsigned int>::iterator it = grantedBytes_.begin();
-    std::map<MacCid, unsigned int>::iterator et = grantedBytes_.end();
-
-    for (; it != et; ++it)
+    for (unsigned int i = 0; i < numFlows; ++i)
     {
-        MacCid cid = it->first;
-        unsigned int granted = it->second;
+        if (!flowServed_[i])
+            continue;
 
-        EV << NOW << " LtePf::storeSchedule @@@@@@@@@@@@@@@@@@@@@@@@@@@@@@" << endl;
-        EV << NOW << " LtePf::storeSchedule CID: " << cid << endl;
-        EV << NOW << " LtePf::storeSchedule Direction: " << ((direction_ == DL) ? "DL": "UL" ) << endl;
+        EV_MAC << NOW << " LtePf::storeSchedule @@@@@@@@@@@@@@@@@@@@@@@@@@@@@@" << endl;
+        EV_MAC << NOW << " LtePf::storeSchedule CID: " << flowCid_[i] << endl;
+        EV_MAC << NOW << " LtePf::storeSchedule Direction: " << ((direction_ == DL) ? "DL": "UL" ) << endl;
 
         // Computing the short term rate
         double shortTermRate;
 
         if (total > 0)
-            shortTermRate = double(granted) / double(total);
+            shortTermRate = double(flowGranted_[i]) / double(total);
         else
             shortTermRate = 0.0;
 
-        EV << NOW << " LtePf::storeSchedule Short Term Rate " << shortTermRate << endl;
+        EV_MAC << NOW << " LtePf::storeSchedule Short Term Rate " << shortTermRate << endl;
         // Updating the long term rate
-        double& longTermRate = pfRate_[cid];
+        double& longTermRate = flowRate_[i];
         longTermRate = (1.0 - pfAlpha_) * longTermRate + pfAlpha_ * shortTermRate;
 
-        EV << NOW << "LtePf::storeSchedule Long Term Rate = " << longTermRate;
+        EV_MAC << NOW << "LtePf::storeSchedule Long Term Rate = " << longTermRate;
     }
 
-    activeConnectionSet_ = activeConnectionTempSet_;
+    purgeInactiveFlows();
+}
+
+int LtePf::findFlow(MacCid cid) const
+{
+    std::vector<MacCid>::const_iterator it = std::lower_bound(flowCid_.begin(), flowCid_.end(), cid);
+    if (it == flowCid_.end() || *it != cid)
+        return -1;
+    return it - flowCid_.begin();
+}
+
+void LtePf::purgeInactiveFlows()
+{
+    unsigned int numFlows = flowCid_.size();
+    unsigned int j = 0;
+    for (unsigned int i = 0; i < numFlows; ++i)
+    {
+        if (!flowActive_[i])
+        {
+            pfRate_[flowCid_[i]] = flowRate_[i];
+            activeConnectionSet_.erase(flowCid_[i]);
+            continue;
+        }
+        if (i != j)
+        {
+            flowCid_[j] = flowCid_[i];
+            flowRate_[j] = flowRate_[i];
+            flowGranted_[j] = flowGranted_[i];
+            flowServed_[j] = flowServed_[i];
+            flowActive_[j] = flowActive_[i];
+        }
+        ++j;
+    }
+    flowCid_.resize(j);
+    flowRate_.resize(j);
+    flowGranted_.resize(j);
+    flowServed_.resize(j);
+    flowActive_.resize(j);
 }
 
 void
@@ -194,13 +224,39 @@ LtePf::updateSchedulingInfo()
 void
 LtePf::notifyActiveConnection(MacCid cid)
 {
-    EV << NOW << " LtePf::notify CID notified " << cid << endl;
-    activeConnectionSet_.insert (cid);
+    EV_MAC << NOW << " LtePf::notify CID notified " << cid << endl;
+    if (!activeConnectionSet_.insert(cid).second)
+        return;
+
+    // insert the flow keeping the arrays sorted by CID, restoring its long-term rate
+    unsigned int pos = std::lower_bound(flowCid_.begin(), flowCid_.end(), cid) - flowCid_.begin();
+    double rate = 0.0;
+    PfRate::iterator it = pfRate_.find(cid);
+    if (it != pfRate_.end())
+    {
+        rate = it->second;
+        pfRate_.erase(it);
+    }
+    flowCid_.insert(flowCid_.begin() + pos, cid);
+    flowRate_.insert(flowRate_.begin() + pos, rate);
+    flowGranted_.insert(flowGranted_.begin() + pos, 0);
+    flowServed_.insert(flowServed_.begin() + pos, false);
+    flowActive_.insert(flowActive_.begin() + pos, true);
 }
 
 void
 LtePf::removeActiveConnection(MacCid cid)
 {
-    EV << NOW << " LtePf::remove CID removed " << cid << endl;
+    EV_MAC << NOW << " LtePf::remove CID removed " << cid << endl;
     activeConnectionSet_.erase (cid);
+
+    int pos = findFlow(cid);
+    if (pos < 0)
+        return;
+    pfRate_[cid] = flowRate_[pos];
+    flowCid_.erase(flowCid_.begin() + pos);
+    flowRate_.erase(flowRate_.begin() + pos);
+    flowGranted_.erase(flowGranted_.begin() + pos);
+    flowServed_.erase(flowServed_.begin() + pos);
+    flowActive_.erase(flowActive_.begin() + pos);
 }
@@ -18,13 +18,29 @@ class SIMULTE_API LtePf : public LteScheduler
 
     typedef std::map<MacCid, double> PfRate;
     typedef SortedDesc<MacCid, double> ScoreDesc;
-    typedef std::priority_queue<ScoreDesc> ScoreList;
 
-    //! Long-term rates, used by PF scheduling.
+    /*
+     * Active flows, as a struct of arrays sorted by CID (i.e. in the same
+     * order as activeConnectionSet_). Membership is updated incrementally by
+     * notifyActiveConnection(), removeActiveConnection() and commitSchedule(),
+     * so that no set is copied per TTI.
+     */
+    //! CID of each active flow
+    std::vector<MacCid> flowCid_;
+    //! Long-term rate (EWMA of the past throughput) of each active flow
+    std::vector<double> flowRate_;
+    //! Bytes granted to each active flow in the current TTI
+    std::vector<unsigned int> flowGranted_;
+    //! Whether each active flow has been served in the current TTI
+    std::vector<bool> flowServed_;
+    //! Whether each active flow is still active at the end of the current TTI
+    std::vector<bool> flowActive_;
+
+    //! Long-term rates of the flows that are not active at the moment
     PfRate pfRate_;
 
-    //! Granted bytes
-    std::map<MacCid, unsigned int> grantedBytes_;
+    //! Heap of the scores of the current TTI (reused across TTIs)
+    std::vector<ScoreDesc> score_;
 
     //! Smoothing factor for proportional fair scheduler.
     double pfAlpha_;
@@ -32,6 +48,12 @@ class SIMULTE_API LtePf : public LteScheduler
     //! Small number to slightly blur away scores.
     const double scoreEpsilon_;
 
+    //! Returns the position of the given CID in the flow arrays, or -1
+    int findFlow(MacCid cid) const;
+
+    //! Removes the flows no longer active, storing their long-term rate
+    void purgeInactiveFlows();
+
   public:
 
     double & pfAlpha()
@@ -15,6 +15,7 @@
 #include "inet/networklayer/ipv4/Ipv4Header_m.h"
 #include "inet/transportlayer/udp/UdpHeader_m.h"
 #include "inet/transportlayer/tcp_common/TcpHeader.h"
+#include "common/LteProfiler.h"
 
 Define_Module(LtePdcpRrcUe);
 Define_Module(LtePdcpRrcEnb);
@@ -486,6 +487,7 @@ void LtePdcpRrcBase::setNodeType(std::string s)
 }
 void LtePdcpRrcBase::handleMessage(cMessage* msg)
 {
+	LTE_PROFILE_SCOPE(this, "handleMessage");
 	cPacket* pkt = check_and_cast<cPacket *>(msg);
 	EV << "LtePdcpRrcBase::handleMessage LtePdcp : Received packet " << pkt->getName() << " from port "
 			<< pkt->getArrivalGate()->getName() << endl;
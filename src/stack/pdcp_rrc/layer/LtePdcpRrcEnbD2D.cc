@@ -10,6 +10,7 @@
 #include "stack/pdcp_rrc/layer/LtePdcpRrcEnbD2D.h"
 #include "inet/networklayer/common/L3AddressResolver.h"
 #include "stack/d2dModeSelection/D2DModeSwitchNotification_m.h"
+#include "common/LteProfiler.h"
 
 Define_Module(LtePdcpRrcEnbD2D);
 
@@ -152,6 +153,7 @@ void LtePdcpRrcEnbD2D::initialize(int stage)
 
 void LtePdcpRrcEnbD2D::handleMessage(cMessage* msg)
 {
+    LTE_PROFILE_SCOPE(this, "handleMessage");
     cPacket* pkt = check_and_cast<cPacket *>(msg);
 
     // check whether the message is a notification for mode switch
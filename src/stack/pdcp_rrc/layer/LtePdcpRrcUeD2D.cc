@@ -12,6 +12,7 @@
 #include "stack/d2dModeSelection/D2DModeSwitchNotification_m.h"
 #include <vector>
 #include "apps/alert/AlertPacket_m.h"
+#include "common/LteProfiler.h"
 Define_Module(LtePdcpRrcUeD2D);
 void LtePdcpRrcUeD2D::initialize(int stage)
 {
@@ -438,6 +439,7 @@ void LtePdcpRrcUeD2D::fromDataPort(cPacket *pktAux)
 
 void LtePdcpRrcUeD2D::handleMessage(cMessage* msg)
 {
+	LTE_PROFILE_SCOPE(this, "handleMessage");
 	cPacket* pkt = check_and_cast<cPacket *>(msg);
 
 	// check whether the message is a notification for mode switch
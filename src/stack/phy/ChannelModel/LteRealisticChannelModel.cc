@@ -17,6 +17,7 @@
 #include "corenetwork/nodes/ExtCell.h"
 #include "stack/phy/layer/LtePhyUe.h"
 #include "stack/mac/layer/LteMacEnbD2D.h"
+#include "common/LteProfiler.h"
 
 // attenuation value to be returned if max. distance of a scenario has been violated
 // and tolerating the maximum distance violation is enabled
@@ -190,7 +191,7 @@ double LteRealisticChannelModel::getAttenuation(MacNodeId nodeId, Direction dir,
        updateCorrelationDistance(nodeId, coord);
    }
 
-   EV << "LteRealisticChannelModel::getAttenuation - computed attenuation at distance " << sqrDistance << " for eNb is " << attenuation << endl;
+   EV_PHY << "LteRealisticChannelModel::getAttenuation - computed attenuation at distance " << sqrDistance << " for eNb is " << attenuation << endl;
 
    return attenuation;
 }
@@ -287,7 +288,7 @@ double LteRealisticChannelModel::getAttenuation_D2D(MacNodeId nodeId, Direction
    updatePositionHistory(nodeId, coord);
    updateCorrelationDistance(nodeId, coord);
 
-   EV << "LteRealisticChannelModel::getAttenuation - computed attenuation at distance " << sqrDistance << " for UE2 is " << attenuation << endl;
+   EV_PHY << "LteRealisticChannelModel::getAttenuation - computed attenuation at distance " << sqrDistance << " for UE2 is " << attenuation << endl;
 
    return attenuation;
 }
@@ -394,7 +395,7 @@ double computeAngle(Coord center, Coord point) {
        // quadrant I
        angle = arcoSen;
 
-   //    EV << "computeAngle: angle[" << angle <<"] - arcoSen[" << arcoSen <<
+   //    EV_PHY << "computeAngle: angle[" << angle <<"] - arcoSen[" << arcoSen <<
    //          "] - relativePos[" << relx << "," << rely <<
    //          "] - siny[" << rely/dist << "] - senx[" << relx/dist <<
    //          "]" << endl;
@@ -409,7 +410,7 @@ double computeAngolarAttenuation(double angle) {
    // see TR 36.814 V9.0.0 for more details
    angolarAtt = 12 * pow(angle / 70.0, 2);
 
-   //  EV << "\t angolarAtt[" << angolarAtt << "]" << endl;
+   //  EV_PHY << "\t angolarAtt[" << angolarAtt << "]" << endl;
    // max value for angolar attenuation is 25 dB
    if (angolarAtt > angolarAttMin)
        angolarAtt = angolarAttMin;
@@ -445,7 +446,7 @@ std::vector<double> LteRealisticChannelModel::getSINR(LteAirFrame *frame, UserCo
 
    Direction dir = (Direction) lteInfo->getDirection();
 
-   EV << "------------ GET SINR ----------------" << endl;
+   EV_PHY << "------------ GET SINR ----------------" << endl;
    //===================== PARAMETERS SETUP ============================
    /*
     * if direction is DL and this is not a feedback packet,
@@ -517,7 +518,7 @@ std::vector<double> LteRealisticChannelModel::getSINR(LteAirFrame *frame, UserCo
    LteCellInfo* eNbCell = getCellInfo(eNbId);
    const char* eNbTypeString = eNbCell ? (eNbCell->getEnbType() == MACRO_ENB ? "MACRO" : "MICRO") : "NULL";
 
-   EV << "LteRealisticChannelModel::getSINR - srcId=" << lteInfo->getSourceId()
+   EV_PHY << "LteRealisticChannelModel::getSINR - srcId=" << lteInfo->getSourceId()
                       << " - destId=" << lteInfo->getDestId()
                       << " - DIR=" << (( dir==DL )?"DL" : "UL")
                       << " - frameType=" << ((lteInfo->getFrameType()==FEEDBACKPKT)?"feedback":"other")
@@ -528,7 +529,7 @@ std::vector<double> LteRealisticChannelModel::getSINR(LteAirFrame *frame, UserCo
    //=================== END PARAMETERS SETUP =======================
 
    //=============== PATH LOSS + SHADOWING + FADING =================
-   EV << "\t using parameters - noiseFigure=" << noiseFigure << " - antennaGainTx=" << antennaGainTx << " - antennaGainRx=" << antennaGainRx <<
+   EV_PHY << "\t using parameters - noiseFigure=" << noiseFigure << " - antennaGainTx=" << antennaGainTx << " - antennaGainRx=" << antennaGainRx <<
            " - txPwr=" << lteInfo->getTxPower() << " - for ueId=" << ueId << endl;
 
    // attenuation for the desired signal
@@ -614,7 +615,7 @@ std::vector<double> LteRealisticChannelModel::getSINR(LteAirFrame *frame, UserCo
            finalRecvPower -= 3;
        }
 
-       EV << " LteRealisticChannelModel::getSINR node " << ueId
+       EV_PHY << " LteRealisticChannelModel::getSINR node " << ueId
           << ((lteInfo->getFrameType() == FEEDBACKPKT) ?
            " FEEDBACK PACKET " : " NORMAL PACKET ")
           << " band " << i << " recvPower " << recvPower
@@ -671,7 +672,7 @@ std::vector<double> LteRealisticChannelModel::getSINR(LteAirFrame *frame, UserCo
 
    // denominator expressed in dBm as (N+extCell+multiCell)
    double den;
-   EV << "LteRealisticChannelModel::getSINR - distance from my eNb=" << enbCoord.distance(ueCoord) << " - DIR=" << (( dir==DL )?"DL" : "UL") << endl;
+   EV_PHY << "LteRealisticChannelModel::getSINR - distance from my eNb=" << enbCoord.distance(ueCoord) << " - DIR=" << (( dir==DL )?"DL" : "UL") << endl;
 
    // add interference for each band
    for (unsigned int i = 0; i < band_; i++)
@@ -684,7 +685,7 @@ std::vector<double> LteRealisticChannelModel::getSINR(LteAirFrame *frame, UserCo
        //               (      mW            +  mW  +        mW            )
        den = linearToDBm(extCellInterference[i] + totN + multiCellInterference[i]);
 
-       EV << "\t ext[" << extCellInterference[i] << "] - multi[" << multiCellInterference[i] << "] - recvPwr["
+       EV_PHY << "\t ext[" << extCellInterference[i] << "] - multi[" << multiCellInterference[i] << "] - recvPwr["
           << dBmToLinear(snrVector[i]) << "] - sinr[" << snrVector[i]-den << "]\n";
 
        // compute final SINR
@@ -724,7 +725,7 @@ std::vector<double> LteRealisticChannelModel::getRSRP_D2D(LteAirFrame *frame, Us
    Direction dir = (Direction) lteInfo_1->getDirection();
    dir = D2D; //todo[stsc]: dir is overriten? why?
 
-   EV << "------------ GET RSRP D2D----------------" << endl;
+   EV_PHY << "------------ GET RSRP D2D----------------" << endl;
 
    //===================== PARAMETERS SETUP ============================
 
@@ -746,7 +747,7 @@ std::vector<double> LteRealisticChannelModel::getRSRP_D2D(LteAirFrame *frame, Us
    // Compute speed
    speed = computeSpeed(sourceId, sourceCoord);
 
-   EV << "LteRealisticChannelModel::getRSRP_D2D - srcId=" << sourceId
+   EV_PHY << "LteRealisticChannelModel::getRSRP_D2D - srcId=" << sourceId
       << " - destId=" << destId
       << " - DIR=" << dirToA(dir)
       << " - frameType=" << ((lteInfo_1->getFrameType()==FEEDBACKPKT)?"feedback":"other")
@@ -757,7 +758,7 @@ std::vector<double> LteRealisticChannelModel::getRSRP_D2D(LteAirFrame *frame, Us
    //=================== END PARAMETERS SETUP =======================
 
    //=============== PATH LOSS + SHADOWING + FADING =================
-   EV << "\t using parameters - noiseFigure=" << noiseFigure << " - antennaGainTx=" << antennaGainTx << " - antennaGainRx=" << antennaGainRx <<
+   EV_PHY << "\t using parameters - noiseFigure=" << noiseFigure << " - antennaGainTx=" << antennaGainTx << " - antennaGainRx=" << antennaGainRx <<
    " - txPwr=" << recvPower << " - for ueId=" << sourceId << endl;
 
    // attenuation for the desired signal
@@ -804,7 +805,7 @@ std::vector<double> LteRealisticChannelModel::getRSRP_D2D(LteAirFrame *frame, Us
            finalRecvPower -= 3;
        }
 
-       EV << " LteRealisticChannelModel::getRSRP_D2D node " << sourceId
+       EV_PHY << " LteRealisticChannelModel::getRSRP_D2D node " << sourceId
           << ((lteInfo_1->getFrameType() == FEEDBACKPKT) ?
            " FEEDBACK PACKET " : " NORMAL PACKET ")
           << " band " << i << " recvPower " << recvPower
@@ -826,6 +827,7 @@ std::vector<double> LteRealisticChannelModel::getRSRP_D2D(LteAirFrame *frame, Us
 
 std::vector<double> LteRealisticChannelModel::getSINR_D2D(LteAirFrame *frame, UserControlInfo* lteInfo, MacNodeId destId, Coord destCoord, MacNodeId enbId)
 {
+   LTE_PROFILE_SCOPE(this, "getSINR_D2D");
    // AttenuationVector::iterator it;
    // Get Tx power
    double recvPower = lteInfo->getD2dTxPower(); // dBm
@@ -851,7 +853,7 @@ std::vector<double> LteRealisticChannelModel::getSINR_D2D(LteAirFrame *frame, Us
    // Get the direction
    Direction dir = D2D;
 
-   EV << "------------ GET SINR D2D ----------------" << endl;
+   EV_PHY << "------------ GET SINR D2D ----------------" << endl;
 
    //===================== PARAMETERS SETUP ============================
 
@@ -864,7 +866,7 @@ std::vector<double> LteRealisticChannelModel::getSINR_D2D(LteAirFrame *frame, Us
    speed = computeSpeed(sourceId, sourceCoord);
 
 
-   EV << "LteRealisticChannelModel::getSINR_d2d - srcId=" << sourceId
+   EV_PHY << "LteRealisticChannelModel::getSINR_d2d - srcId=" << sourceId
       << " - destId=" << destId
       << " - DIR=" << dirToA(dir)
       << " - frameType=" << ((lteInfo->getFrameType()==FEEDBACKPKT)?"feedback":"other")
@@ -875,7 +877,7 @@ std::vector<double> LteRealisticChannelModel::getSINR_D2D(LteAirFrame *frame, Us
    //=================== END PARAMETERS SETUP =======================
 
    //=============== PATH LOSS + SHADOWING + FADING =================
-   EV << "\t using parameters - noiseFigure=" << noiseFigure << " - antennaGainTx=" << antennaGainTx << " - antennaGainRx=" << antennaGainRx <<
+   EV_PHY << "\t using parameters - noiseFigure=" << noiseFigure << " - antennaGainTx=" << antennaGainTx << " - antennaGainRx=" << antennaGainRx <<
    " - txPwr=" << recvPower << " - for ueId=" << sourceId << endl;
 
    // attenuation for the desired signal
@@ -922,7 +924,7 @@ std::vector<double> LteRealisticChannelModel::getSINR_D2D(LteAirFrame *frame, Us
            finalRecvPower -= 3;
        }
 
-       EV << " LteRealisticChannelModel::getSINR_d2d node " << sourceId
+       EV_PHY << " LteRealisticChannelModel::getSINR_d2d node " << sourceId
           << ((lteInfo->getFrameType() == FEEDBACKPKT) ?
            " FEEDBACK PACKET " : " NORMAL PACKET ")
           << " band " << i << " recvPower " << recvPower
@@ -976,7 +978,7 @@ std::vector<double> LteRealisticChannelModel::getSINR_D2D(LteAirFrame *frame, Us
 
            // denominator expressed in dBm as (N+extCell+inCell)
            double den;
-           EV << "LteRealisticChannelModel::getSINR - distance from my Peer = " << destCoord.distance(sourceCoord) << " - DIR=" << dirToA(dir)  << endl;
+           EV_PHY << "LteRealisticChannelModel::getSINR - distance from my Peer = " << destCoord.distance(sourceCoord) << " - DIR=" << dirToA(dir)  << endl;
 
            // Add interference for each band
            for (unsigned int i = 0; i < band_; i++)
@@ -989,7 +991,7 @@ std::vector<double> LteRealisticChannelModel::getSINR_D2D(LteAirFrame *frame, Us
                //               (      mW            +  mW  +        mW            )
                den = linearToDBm(extCellInterference + totN + d2dInterference[i]);
 
-               EV << "\t ext[" << extCellInterference << "] - in[" << d2dInterference[i] << "] - recvPwr["
+               EV_PHY << "\t ext[" << extCellInterference << "] - in[" << d2dInterference[i] << "] - recvPwr["
                        << dBmToLinear(snrVector[i]) << "] - sinr[" << snrVector[i]-den << "]\n";
 
                // compute final SINR. Subtraction in dB is equivalent to linear division
@@ -1014,7 +1016,7 @@ std::vector<double> LteRealisticChannelModel::getSINR_D2D(LteAirFrame *frame, Us
            // compute final SINR
            snrVector[i] -=  (noiseFigure + thermalNoise_);
 
-           EV << "LteRealisticChannelModel::getSINR_d2d - distance from my Peer = " << destCoord.distance(sourceCoord) << " - DIR=" << dirToA(dir) << " - snr[" << snrVector[i] << "]\n";
+           EV_PHY << "LteRealisticChannelModel::getSINR_d2d - distance from my Peer = " << destCoord.distance(sourceCoord) << " - DIR=" << dirToA(dir) << " - snr[" << snrVector[i] << "]\n";
        }
    }
    //sender is an UE
@@ -1025,6 +1027,7 @@ std::vector<double> LteRealisticChannelModel::getSINR_D2D(LteAirFrame *frame, Us
 
 std::vector<double> LteRealisticChannelModel::getSINR_D2D(LteAirFrame *frame, UserControlInfo* lteInfo_1, MacNodeId destId, Coord destCoord,MacNodeId enbId,const std::vector<double>& rsrpVector)
 {
+   LTE_PROFILE_SCOPE(this, "getSINR_D2D");
    std::vector<double> snrVector = rsrpVector;
 
    MacNodeId sourceId = lteInfo_1->getSourceId();
@@ -1043,7 +1046,7 @@ std::vector<double> LteRealisticChannelModel::getSINR_D2D(LteAirFrame *frame, Us
    noiseFigure = ueNoiseFigure_;
 
 
-   EV << "------------ GET SINR D2D----------------" << endl;
+   EV_PHY << "------------ GET SINR D2D----------------" << endl;
 
    /*
     * The SINR will be calculated as follows
@@ -1082,7 +1085,7 @@ std::vector<double> LteRealisticChannelModel::getSINR_D2D(LteAirFrame *frame, Us
 
            // denominator expressed in dBm as (N+extCell+inCell)
            double den;
-           EV << "LteRealisticChannelModel::getSINR - distance from my Peer = " << destCoord.distance(sourceCoord) << " - DIR=" << dirToA(dir)  << endl;
+           EV_PHY << "LteRealisticChannelModel::getSINR - distance from my Peer = " << destCoord.distance(sourceCoord) << " - DIR=" << dirToA(dir)  << endl;
 
            // Add interference for each band
            for (unsigned int i = 0; i < band_; i++)
@@ -1095,7 +1098,7 @@ std::vector<double> LteRealisticChannelModel::getSINR_D2D(LteAirFrame *frame, Us
                //               (      mW            +  mW  +        mW            )
                den = linearToDBm(extCellInterference + totN + d2dInterference[i]);
 
-               EV << "\t ext[" << extCellInterference << "] - in[" << d2dInterference[i] << "] - recvPwr["
+               EV_PHY << "\t ext[" << extCellInterference << "] - in[" << d2dInterference[i] << "] - recvPwr["
                        << dBmToLinear(snrVector[i]) << "] - sinr[" << snrVector[i]-den << "]\n";
 
                // compute final SINR. Subtraction in dB is equivalent to linear division
@@ -1115,7 +1118,7 @@ std::vector<double> LteRealisticChannelModel::getSINR_D2D(LteAirFrame *frame, Us
            // compute final SINR
            snrVector[i] -=  (noiseFigure + thermalNoise_);
 
-           EV << "LteRealisticChannelModel::getSINR_D2D - distance from my Peer = " << destCoord.distance(sourceCoord) << " - DIR=" << dirToA(dir) << " - snr[" << snrVector[i] << "]\n";
+           EV_PHY << "LteRealisticChannelModel::getSINR_D2D - distance from my Peer = " << destCoord.distance(sourceCoord) << " - DIR=" << dirToA(dir) << " - snr[" << snrVector[i] << "]\n";
        }
    }
 
@@ -1295,7 +1298,7 @@ double LteRealisticChannelModel::jakesFading(MacNodeId nodeId, double speed,
        re_h = re_h + attenuation * cos(phi);
        im_h = im_h - attenuation * sin(phi);
 
-       //        EV << "ID=" << nodeId << " - t[" << t << "] - dopplerShift[" << doppler_shift << "] - phiD[" <<
+       //        EV_PHY << "ID=" << nodeId << " - t[" << t << "] - dopplerShift[" << doppler_shift << "] - phiD[" <<
        //                phi_d << "] - phiI[" << phi_i << "] - phi[" << phi << "] - attenuation[" << attenuation << "] - f["
        //                << f << "] - Band[" << band << "] - cos(phi)["
        //                << cos(phi) << "]" << endl;
@@ -1309,7 +1312,7 @@ double LteRealisticChannelModel::jakesFading(MacNodeId nodeId, double speed,
 bool LteRealisticChannelModel::isCorrupted(LteAirFrame *frame,
        UserControlInfo* lteInfo)
 {
-   EV << "LteRealisticChannelModel::error" << endl;
+   EV_PHY << "LteRealisticChannelModel::error" << endl;
 
    //get codeword
    unsigned char cw = lteInfo->getCw();
@@ -1418,7 +1421,7 @@ bool LteRealisticChannelModel::isCorrupted(LteAirFrame *frame,
            else
                bler = binder_->phyPisaData.getBler(itxmode, cqi - 1, snr);
 
-           EV << "\t bler computation: [itxMode=" << itxmode << "] - [cqi-1=" << cqi-1
+           EV_PHY << "\t bler computation: [itxMode=" << itxmode << "] - [cqi-1=" << cqi-1
                    << "] - [snr=" << snr << "]" << endl;
 
            double success = 1 - bler;
@@ -1427,7 +1430,7 @@ bool LteRealisticChannelModel::isCorrupted(LteAirFrame *frame,
            // compute the success probability according to the number of LB used
            finalSuccess *= successPacket;
 
-           EV << " LteRealisticChannelModel::error direction " << dirToA(dir)
+           EV_PHY << " LteRealisticChannelModel::error direction " << dirToA(dir)
                               << " node " << id << " remote unit " << dasToA((*it).first)
                               << " Band " << (*jt).first << " SNR " << snr << " CQI " << cqi
                               << " BLER " << bler << " success probability " << successPacket
@@ -1441,7 +1444,7 @@ bool LteRealisticChannelModel::isCorrupted(LteAirFrame *frame,
 
    double er = uniform(0.0, 1.0);
 
-   EV << " LteRealisticChannelModel::error direction " << dirToA(dir)
+   EV_PHY << " LteRealisticChannelModel::error direction " << dirToA(dir)
                       << " node " << id << " total ERROR probability  " << per
                       << " per with H-ARQ error reduction " << totalPer
                       << " - CQI[" << cqi << "]- random error extracted[" << er << "]" << endl;
@@ -1451,20 +1454,20 @@ bool LteRealisticChannelModel::isCorrupted(LteAirFrame *frame,
 
    if (er <= totalPer)
    {
-       EV << "This is NOT your lucky day (" << er << " < " << totalPer
+       EV_PHY << "This is NOT your lucky day (" << er << " < " << totalPer
                << ") -> do not receive." << endl;
        // Signal too weak, we can't receive it
        return false;
    }
    // Signal is strong enough, receive this Signal
-   EV << "This is your lucky day (" << er << " > " << totalPer
+   EV_PHY << "This is your lucky day (" << er << " > " << totalPer
            << ") -> Receive AirFrame." << endl;
    return true;
 }
 
 bool LteRealisticChannelModel::isCorrupted_D2D(LteAirFrame *frame, UserControlInfo* lteInfo, const std::vector<double>& rsrpVector)
 {
-   EV << "LteRealisticChannelModel::isCorrupted_D2D" << endl;
+   EV_PHY << "LteRealisticChannelModel::isCorrupted_D2D" << endl;
 
    //get codeword
    unsigned char cw = lteInfo->getCw();
@@ -1480,7 +1483,7 @@ bool LteRealisticChannelModel::isCorrupted_D2D(LteAirFrame *frame, UserControlIn
 
    // Get CQI used to transmit this cw
    Cqi cqi = lteInfo->getUserTxParams()->readCqiVector()[cw];
-   EV << "LteRealisticChannelModel:: CQI: "<< cqi << endl;
+   EV_PHY << "LteRealisticChannelModel:: CQI: "<< cqi << endl;
 
    MacNodeId id;
    Direction dir = (Direction) lteInfo->getDirection();
@@ -1491,7 +1494,7 @@ bool LteRealisticChannelModel::isCorrupted_D2D(LteAirFrame *frame, UserControlIn
    else // UL or D2D
        id = lteInfo->getSourceId();
 
-   EV<<NOW<< "LteRealisticChannelModel::FROM: "<< id << endl;
+   EV_PHY<<NOW<< "LteRealisticChannelModel::FROM: "<< id << endl;
    // Get Number of RTX
    unsigned char nTx = lteInfo->getTxNumber();
 
@@ -1580,7 +1583,7 @@ bool LteRealisticChannelModel::isCorrupted_D2D(LteAirFrame *frame, UserControlIn
                else
                    bler = binder_->phyPisaData.getBler(itxmode, cqi - 1, snr);
 
-           EV << "\t bler computation: [itxMode=" << itxmode << "] - [cqi-1=" << cqi-1
+           EV_PHY << "\t bler computation: [itxMode=" << itxmode << "] - [cqi-1=" << cqi-1
               << "] - [snr=" << snr << "]" << endl;
 
            double success = 1 - bler;
@@ -1590,7 +1593,7 @@ bool LteRealisticChannelModel::isCorrupted_D2D(LteAirFrame *frame, UserControlIn
            // compute the success probability according to the number of LB used
            finalSuccess *= successPacket;
 
-           EV << " LteRealisticChannelModel::error direction " << dirToA(dir)
+           EV_PHY << " LteRealisticChannelModel::error direction " << dirToA(dir)
               << " node " << id << " remote unit " << dasToA((*it).first)
               << " Band " << (*jt).first << " SNR " << snr << " CQI " << cqi
               << " BLER " << bler << " success probability " << successPacket
@@ -1604,7 +1607,7 @@ bool LteRealisticChannelModel::isCorrupted_D2D(LteAirFrame *frame, UserControlIn
 
    double er = uniform(0.0, 1.0);
 
-   EV << " LteRealisticChannelModel::error direction " << dirToA(dir)
+   EV_PHY << " LteRealisticChannelModel::error direction " << dirToA(dir)
       << " node " << id << " total ERROR probability  " << per
       << " per with H-ARQ error reduction " << totalPer
       << " - CQI[" << cqi << "]- random error extracted[" << er << "]" << endl;
@@ -1614,13 +1617,13 @@ bool LteRealisticChannelModel::isCorrupted_D2D(LteAirFrame *frame, UserControlIn
 
    if (er <= totalPer)
    {
-       EV << "This is NOT your lucky day (" << er << " < " << totalPer << ") -> do not receive." << endl;
+       EV_PHY << "This is NOT your lucky day (" << er << " < " << totalPer << ") -> do not receive." << endl;
 
        // Signal too weak, we can't receive it
        return false;
    }
    // Signal is strong enough, receive this Signal
-   EV << "This is your lucky day (" << er << " > " << totalPer << ") -> Receive AirFrame." << endl;
+   EV_PHY << "This is your lucky day (" << er << " > " << totalPer << ") -> Receive AirFrame." << endl;
 
    return true;
 }
@@ -1922,7 +1925,7 @@ double LteRealisticChannelModel::getStdDev(bool dist, MacNodeId nodeId)
 bool LteRealisticChannelModel::computeExtCellInterference(MacNodeId eNbId, MacNodeId nodeId, Coord coord, bool isCqi,
        std::vector<double>* interference)
 {
-   EV << "**** Ext Cell Interference **** " << endl;
+   EV_PHY << "**** Ext Cell Interference **** " << endl;
 
    // get external cell list
    ExtCellList list = binder_->getExtCellList();
@@ -1943,7 +1946,7 @@ bool LteRealisticChannelModel::computeExtCellInterference(MacNodeId eNbId, MacNo
        // computer distance between UE and the ext cell
        dist = coord.distance(c);
 
-       EV << "\t distance between UE[" << coord.x << "," << coord.y <<
+       EV_PHY << "\t distance between UE[" << coord.x << "," << coord.y <<
                "] and extCell[" << c.x << "," << c.y << "] is -> "
                << dist << "\t";
 
@@ -2008,7 +2011,7 @@ double LteRealisticChannelModel::computeExtCellPathLoss(double dist, MacNodeId n
 
    speed = computeSpeed(nodeId, phy_->getCoord());
 
-   //    EV << "LteRealisticChannelModel::computeExtCellPathLoss:" << scenario_ << "-" << shadowing_ << "\n";
+   //    EV_PHY << "LteRealisticChannelModel::computeExtCellPathLoss:" << scenario_ << "-" << shadowing_ << "\n";
 
    //compute attenuation based on selected scenario and based on LOS or NLOS
    bool los = losMap_[nodeId];
@@ -2055,7 +2058,7 @@ double LteRealisticChannelModel::computeExtCellPathLoss(double dist, MacNodeId n
        {
            att = lastComputedSF_.at(nodeId).second;
        }
-       EV << "(" << att << ")";
+       EV_PHY << "(" << att << ")";
        attenuation += att;
    }
 
@@ -2078,7 +2081,7 @@ LteRealisticChannelModel::JakesFadingMap * LteRealisticChannelModel::obtainUeJak
 bool LteRealisticChannelModel::computeDownlinkInterference(MacNodeId eNbId, MacNodeId ueId, Coord coord, bool isCqi, const RbMap& rbmap,
        std::vector<double> * interference)
 {
-   EV << "**** Downlink Interference ****" << endl;
+   EV_PHY << "**** Downlink Interference ****" << endl;
 
    // reference to the mac/phy/channel of each cell
    LtePhyBase * ltePhy;
@@ -2125,7 +2128,7 @@ bool LteRealisticChannelModel::computeDownlinkInterference(MacNodeId eNbId, MacN
 
        // compute attenuation using data structures within the cell
        att = (*it)->realChan->getAttenuation(ueId,UL,coord);
-       EV << "EnbId [" << id << "] - attenuation [" << att << "]" << endl;
+       EV_PHY << "EnbId [" << id << "] - attenuation [" << att << "]" << endl;
 
        //=============== ANGOLAR ATTENUATION =================
        double angolarAtt = 0;
@@ -2160,7 +2163,7 @@ bool LteRealisticChannelModel::computeDownlinkInterference(MacNodeId eNbId, MacN
                if(temp!=0)
                    (*interference)[i] += dBmToLinear(txPwr-att);//(dBm-dB)=dBm
 
-               EV << "\t band " << i << " occupied " << temp << "/pwr[" << txPwr << "]-int[" << (*interference)[i] << "]" << endl;
+               EV_PHY << "\t band " << i << " occupied " << temp << "/pwr[" << txPwr << "]-int[" << (*interference)[i] << "]" << endl;
            }
        }
        else // error computation. We need to check the slot occupation of the previous TTI
@@ -2177,7 +2180,7 @@ bool LteRealisticChannelModel::computeDownlinkInterference(MacNodeId eNbId, MacN
                if(temp!=0)
                    (*interference)[i] += dBmToLinear(txPwr-att);//(dBm-dB)=dBm
 
-               EV << "\t band " << i << " occupied " << temp << "/pwr[" << txPwr << "]-int[" << (*interference)[i] << "]" << endl;
+               EV_PHY << "\t band " << i << " occupied " << temp << "/pwr[" << txPwr << "]-int[" << (*interference)[i] << "]" << endl;
            }
        }
        ++it;
@@ -2188,7 +2191,7 @@ bool LteRealisticChannelModel::computeDownlinkInterference(MacNodeId eNbId, MacN
 
 bool LteRealisticChannelModel::computeUplinkInterference(MacNodeId eNbId, MacNodeId senderId, bool isCqi, const RbMap& rbmap, std::vector<double> * interference)
 {
-   EV << "**** Uplink Interference for cellId[" << eNbId << "] node["<<senderId<<"] ****" << endl;
+   EV_PHY << "**** Uplink Interference for cellId[" << eNbId << "] node["<<senderId<<"] ****" << endl;
 
 
    const std::vector<UeAllocationInfo>* allocatedUes;
@@ -2219,14 +2222,14 @@ bool LteRealisticChannelModel::computeUplinkInterference(MacNodeId eNbId, MacNod
                if (cellId == eNbId)
                    continue;
 
-               EV<<NOW<<" LteRealisticChannelModel::computeUplinkInterference - Interference from UE: "<< ueId << "(dir " << dirToA(dir) << ") on band[" << i << "]" << endl;
+               EV_PHY<<NOW<<" LteRealisticChannelModel::computeUplinkInterference - Interference from UE: "<< ueId << "(dir " << dirToA(dir) << ") on band[" << i << "]" << endl;
 
                // get tx power and attenuation from this UE
                double txPwr = uePhy->getTxPwr(dir) - cableLoss_ + antennaGainUe_ + antennaGainEnB_;
                double att = getAttenuation(ueId, UL, uePhy->getCoord());
                (*interference)[i] += dBmToLinear(txPwr-att);//(dBm-dB)=dBm
 
-               EV << "\t band " << i << "/pwr[" << txPwr-att << "]-int[" << (*interference)[i] << "]" << endl;
+               EV_PHY << "\t band " << i << "/pwr[" << txPwr-att << "]-int[" << (*interference)[i] << "]" << endl;
            }
        }
    }
@@ -2260,22 +2263,25 @@ bool LteRealisticChannelModel::computeUplinkInterference(MacNodeId eNbId, MacNod
                if (cellId == eNbId)
                    continue;
 
-               EV<<NOW<<" LteRealisticChannelModel::computeUplinkInterference - Interference from UE: "<< ueId << "(dir " << dirToA(dir) << ") on band[" << i << "]" << endl;
+               EV_PHY<<NOW<<" LteRealisticChannelModel::computeUplinkInterference - Interference from UE: "<< ueId << "(dir " << dirToA(dir) << ") on band[" << i << "]" << endl;
 
                // get tx power and attenuation from this UE
                double txPwr = uePhy->getTxPwr(dir) - cableLoss_ + antennaGainUe_ + antennaGainEnB_;
                double att = getAttenuation(ueId, UL, uePhy->getCoord());
                (*interference)[i] += dBmToLinear(txPwr-att);//(dBm-dB)=dBm
 
-               EV << "\t band " << i << "/pwr[" << txPwr-att << "]-int[" << (*interference)[i] << "]" << endl;
+               EV_PHY << "\t band " << i << "/pwr[" << txPwr-att << "]-int[" << (*interference)[i] << "]" << endl;
            }
        }
    }
 
    // Debug Output
-   EV << NOW << " LteRealisticChannelModel::computeUplinkInterference - Final Band Interference Status: "<<endl;
-   for(unsigned int i=0;i<band_;i++)
-       EV << "\t band " << i << " int[" << (*interference)[i] << "]" << endl;
+   if (LTE_TRACE_ENABLED(PHY))
+   {
+       EV_PHY << NOW << " LteRealisticChannelModel::computeUplinkInterference - Final Band Interference Status: "<<endl;
+       for(unsigned int i=0;i<band_;i++)
+           EV_PHY << "\t band " << i << " int[" << (*interference)[i] << "]" << endl;
+   }
 
    return true;
 }
@@ -2283,7 +2289,7 @@ bool LteRealisticChannelModel::computeUplinkInterference(MacNodeId eNbId, MacNod
 bool LteRealisticChannelModel::computeD2DInterference(MacNodeId eNbId, MacNodeId senderId, Coord senderCoord, MacNodeId destId, Coord destCoord, bool isCqi, const RbMap& rbmap,
    std::vector<double> * interference,Direction dir)
 {
-   EV << "**** D2D Interference for cellId[" << eNbId << "] node["<<destId<<"] ****" << endl;
+   EV_PHY << "**** D2D Interference for cellId[" << eNbId << "] node["<<destId<<"] ****" << endl;
 
    // get the reference to the MAC of the eNodeB
    LteMacEnbD2D* macEnb = check_and_cast<LteMacEnbD2D*>(binder_->getMacFromMacNodeId(eNbId));
@@ -2320,14 +2326,14 @@ bool LteRealisticChannelModel::computeD2DInterference(MacNodeId eNbId, MacNodeId
                if (cellId == eNbId && (!macEnb->isReuseD2DEnabled() && !macEnb->isReuseD2DMultiEnabled()))
                    continue;
 
-               EV<<NOW<<" LteRealisticChannelModel::computeD2DInterference - Interference from UE: "<< ueId << "(dir " << dirToA(dir) << ") on band[" << i << "]" << endl;
+               EV_PHY<<NOW<<" LteRealisticChannelModel::computeD2DInterference - Interference from UE: "<< ueId << "(dir " << dirToA(dir) << ") on band[" << i << "]" << endl;
 
                // get tx power and attenuation from this UE
                double txPwr = uePhy->getTxPwr(dir) - cableLoss_ + 2 * antennaGainUe_;
                double att = getAttenuation_D2D(ueId, D2D, uePhy->getCoord(), destId, destCoord);
                (*interference)[i] += dBmToLinear(txPwr-att);//(dBm-dB)=dBm
 
-               EV << "\t band " << i << "/pwr[" << txPwr-att << "]-int[" << (*interference)[i] << "]" << endl;
+               EV_PHY << "\t band " << i << "/pwr[" << txPwr-att << "]-int[" << (*interference)[i] << "]" << endl;
            }
        }
    }
@@ -2365,22 +2371,25 @@ bool LteRealisticChannelModel::computeD2DInterference(MacNodeId eNbId, MacNodeId
                if (cellId == eNbId && (!macEnb->isReuseD2DEnabled() && !macEnb->isReuseD2DMultiEnabled()))
                    continue;
 
-               EV<<NOW<<" LteRealisticChannelModel::computeD2DInterference - Interference from UE: "<< ueId << "(dir " << dirToA(dir) << ") on band[" << i << "]" << endl;
+               EV_PHY<<NOW<<" LteRealisticChannelModel::computeD2DInterference - Interference from UE: "<< ueId << "(dir " << dirToA(dir) << ") on band[" << i << "]" << endl;
 
                // get tx power and attenuation from this UE
                double txPwr = uePhy->getTxPwr(dir) - cableLoss_ + 2 * antennaGainUe_;
                double att = getAttenuation_D2D(ueId, D2D, uePhy->getCoord(), destId, destCoord);
                (*interference)[i] += dBmToLinear(txPwr-att);//(dBm-dB)=dBm
 
-               EV << "\t band " << i << "/pwr[" << txPwr-att << "]-int[" << (*interference)[i] << "]" << endl;
+               EV_PHY << "\t band " << i << "/pwr[" << txPwr-att << "]-int[" << (*interference)[i] << "]" << endl;
            }
        }
    }
 
    // Debug Output
-   EV << NOW << " LteRealisticChannelModel::computeD2DInterference - Final Band Interference Status: "<<endl;
-   for(unsigned int i=0;i<band_;i++)
-       EV << "\t band " << i << " int[" << (*interference)[i] << "]" << endl;
+   if (LTE_TRACE_ENABLED(PHY))
+   {
+       EV_PHY << NOW << " LteRealisticChannelModel::computeD2DInterference - Final Band Interference Status: "<<endl;
+       for(unsigned int i=0;i<band_;i++)
+           EV_PHY << "\t band " << i << " int[" << (*interference)[i] << "]" << endl;
+   }
 
    return true;
 }
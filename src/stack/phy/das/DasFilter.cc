@@ -18,6 +18,8 @@ DasFilter::DasFilter(LtePhyBase* ltePhy, LteBinder* binder,
     rssiThreshold_ = rssiThreshold;
     binder_ = binder;
     ltePhy_ = ltePhy;
+    das_ = nullptr;
+    cacheDistance_ = 0;
 }
 
 DasFilter::~DasFilter()
@@ -41,46 +43,63 @@ void DasFilter::setMasterRuSet(MacNodeId masterId)
 
     // Clear structures used with old master on handover
     reportingSet_.clear();
+    antennaRssi_.clear();
 }
 
 double DasFilter::receiveBroadcast(LteAirFrame* frame, UserControlInfo* lteInfo)
 {
     EV << "DAS Filter: Received Broadcast\n";
+
+    // equal bitrate mapping - the rssi is the same for all the antennas, compute it once
+    // (always, as it is used by the handover as the rssi of the serving cell)
+    std::vector<double> rssiV = ltePhy_->getChannelModel()->getSINR(frame,lteInfo);
+    std::vector<double>::iterator it;
+    double rssi = 0;
+    for (it=rssiV.begin();it!=rssiV.end();++it)
+        rssi+=*it;
+    rssi /= rssiV.size();
+
+    const inet::Coord& myPos = ltePhy_->getCoord();
+    if (cacheDistance_ > 0 && !antennaRssi_.empty() && myPos.distance(lastPosition_) < cacheDistance_)
+    {
+        EV << "DAS Filter: UE moved less than " << cacheDistance_ << "m, ReportingSet unchanged\n";
+        return rssi;
+    }
+    lastPosition_ = myPos;
+
     EV << "DAS Filter: ReportingSet now contains:\n";
     reportingSet_.clear();
 
-    double rssiEnb = 0;
-    for (unsigned int i=0; i<ruSet_->getAntennaSetSize(); i++)
+    antennaRssi_.assign(ruSet_->getAntennaSetSize(), rssi);
+    for (unsigned int i=0; i<antennaRssi_.size(); i++)
     {
-        // equal bitrate mapping
-        std::vector<double> rssiV = ltePhy_->getChannelModel()->getSINR(frame,lteInfo);
-        std::vector<double>::iterator it;
-        double rssi = 0;
-        for (it=rssiV.begin();it!=rssiV.end();++it)
-            rssi+=*it;
-        rssi /= rssiV.size();
-        //EV << "Sender Position: (" << senderPos.getX() << "," << senderPos.getY() << ")\n";
-        //EV << "My Position: (" << myPos.getX() << "," << myPos.getY() << ")\n";
-
-        EV << "RU" << i << " RSSI: " << rssi;
-        if (rssi > rssiThreshold_)
+        EV << "RU" << i << " RSSI: " << antennaRssi_[i];
+        if (antennaRssi_[i] > rssiThreshold_)
         {
             EV << " is associated";
             reportingSet_.insert((Remote)i);
         }
         EV << "\n";
-        if (i == 0)
-            rssiEnb = rssi;
     }
 
-    return rssiEnb;
+    return antennaRssi_.empty() ? 0 : antennaRssi_[0];
 }
 
-RemoteSet DasFilter::getReportingSet()
+const RemoteSet& DasFilter::getReportingSet() const
 {
     return reportingSet_;
 }
 
+const std::vector<double>& DasFilter::getAntennaRssi() const
+{
+    return antennaRssi_;
+}
+
+void DasFilter::setCacheDistance(double distance)
+{
+    cacheDistance_ = distance;
+}
+
 RemoteAntennaSet* DasFilter::getRemoteAntennaSet() const
 {
     return ruSet_;
@@ -71,6 +71,9 @@ class SIMULTE_API DasFilter
      *   examines the rssi between the UE and antenna.
      * - If the distance is below a threshold, it is added
      *   to the reporting set.
+     * If caching is enabled and the UE has not moved enough since
+     * the last computation, the reporting set is left unchanged;
+     * the returned rssi is always the one of the current frame.
      *
      * @param frame feedback packet received
      * @param myPos position of the UE
@@ -84,7 +87,23 @@ class SIMULTE_API DasFilter
      *
      * @return Reporting Set
      */
-    RemoteSet getReportingSet();
+    const RemoteSet& getReportingSet() const;
+
+    /**
+     * getAntennaRssi() returns the rssi measured for each antenna
+     * of the master at the last broadcast, indexed by Remote
+     *
+     * @return per-antenna rssi
+     */
+    const std::vector<double>& getAntennaRssi() const;
+
+    /**
+     * setCacheDistance() enables the reuse of the last reporting set
+     * while the UE moves less than the given distance (0 disables it)
+     *
+     * @param distance minimum movement (m) for a new computation
+     */
+    void setCacheDistance(double distance);
 
     /**
      * getRemoteAntennaSet() returns a pointer to the Remote Antenna Set:
@@ -140,6 +159,15 @@ class SIMULTE_API DasFilter
     /// Set of antennas that feedback generator needs to report
     RemoteSet reportingSet_;
 
+    /// Rssi of each antenna at the last computation of the reporting set
+    std::vector<double> antennaRssi_;
+
+    /// Position of the UE at the last computation of the reporting set
+    inet::Coord lastPosition_;
+
+    /// Minimum movement of the UE for a new computation of the reporting set
+    double cacheDistance_;
+
     /// Rssi Threshold for Antenna association
     double rssiThreshold_;
 
@@ -9,6 +9,7 @@
 
 #include "stack/phy/feedback/LteDlFeedbackGenerator.h"
 #include "stack/phy/layer/LtePhyUe.h"
+#include "common/LteProfiler.h"
 
 Define_Module(LteDlFeedbackGenerator);
 
@@ -46,6 +47,15 @@ void LteDlFeedbackGenerator::initialize(int stage)
         generatorType_ = getFeedbackGeneratorType(
             par("feedbackGeneratorType").stringValue());
 
+        // the direct channel has no airframe: deliver the feedback one TTI
+        // later, so that it has the same age as the one sent over the air
+        directFeedback_ = par("directFeedback");
+        if (directFeedback_ && generatorType_ != IDEAL)
+            error("directFeedback can only be used with IDEAL feedback generation");
+        fbTxDelay_ = directFeedback_ ? fbDelay_ + TTI : fbDelay_;
+        if (directFeedback_ && fbPeriod_ <= fbTxDelay_)
+            error("Feedback Period MUST be greater than Feedback Delay plus one TTI when using directFeedback");
+
         masterId_ = getAncestorPar("masterId");
         nodeId_ = getAncestorPar("macNodeId");
 
@@ -65,6 +75,7 @@ void LteDlFeedbackGenerator::initialize(int stage)
         WATCH(fbPeriod_);
         WATCH(fbDelay_);
         WATCH(usePeriodic_);
+        WATCH(directFeedback_);
         WATCH(currentTxMode_);
     }
     else if (stage == INITSTAGE_LINK_LAYER)
@@ -106,6 +117,7 @@ void LteDlFeedbackGenerator::initialize(int stage)
 
 void LteDlFeedbackGenerator::handleMessage(cMessage *msg)
 {
+    LTE_PROFILE_SCOPE(this, "handleMessage");
     TTimerMsg *tmsg = check_and_cast<TTimerMsg*>(msg);
     FbTimerType type = (FbTimerType) tmsg->getTimerId();
 
@@ -165,9 +177,9 @@ void LteDlFeedbackGenerator::sensing(FbPeriodicity per)
 
     // Schedule feedback transmission
     if (per == PERIODIC)
-        tPeriodicTx_->start(fbDelay_);
+        tPeriodicTx_->start(fbTxDelay_);
     else if (per == APERIODIC)
-        tAperiodicTx_->start(fbDelay_);
+        tAperiodicTx_->start(fbTxDelay_);
 }
 
         /***************************
@@ -210,10 +222,10 @@ void LteDlFeedbackGenerator::sendFeedback(LteFeedbackDoubleVector fb,
     FeedbackRequest feedbackReq;
     if (feedbackComputationPisa_)
     {
+        // feedbackGeneratorType and feedbackType are parameters of this module
         feedbackReq.request = true;
-        feedbackReq.genType = getFeedbackGeneratorType(
-            getAncestorPar("feedbackGeneratorType").stringValue());
-        feedbackReq.type = getFeedbackType(par("feedbackType").stringValue());
+        feedbackReq.genType = generatorType_;
+        feedbackReq.type = fbType_;
         feedbackReq.txMode = currentTxMode_;
         feedbackReq.rbAllocationType = rbAllocationType_;
     }
@@ -222,8 +234,11 @@ void LteDlFeedbackGenerator::sendFeedback(LteFeedbackDoubleVector fb,
         feedbackReq.request = false;
     }
     //use PHY function to send feedback
-    (dynamic_cast<LtePhyUe*>(getParentModule()->getSubmodule("phy")))->sendFeedback(
-        fb, fb, feedbackReq);
+    LtePhyUe* phy = check_and_cast<LtePhyUe*>(getParentModule()->getSubmodule("phy"));
+    if (directFeedback_ && feedbackReq.request)
+        phy->sendDirectFeedback(feedbackReq);
+    else
+        phy->sendFeedback(fb, fb, feedbackReq);
 }
 
 // TODO adjust default value
@@ -47,6 +47,9 @@ class SIMULTE_API LteDlFeedbackGenerator : public omnetpp::cSimpleModule
      */
     omnetpp::simtime_t fbPeriod_;    /// period for Periodic feedback in TTI
     omnetpp::simtime_t fbDelay_;     /// time interval between sensing and transmission in TTI
+    omnetpp::simtime_t fbTxDelay_;   /// time interval between sensing and delivery of the feedback
+
+    bool directFeedback_;   /// true if ideal feedback is written directly into the master's AMC
 
     bool usePeriodic_;      /// true if we want to use also periodic feedback
     TxMode currentTxMode_;  /// transmission mode to use in feedback generation
@@ -16,7 +16,14 @@
 using namespace omnetpp;
 
 LteFeedbackComputationRealistic::LteFeedbackComputationRealistic(double targetBler, std::map<MacNodeId, Lambda>* lambda,
-    double lambdaMinTh, double lambdaMaxTh, double lambdaRatioTh, unsigned int numBands)
+    double lambdaMinTh, double lambdaMaxTh, double lambdaRatioTh, unsigned int numBands) :
+    LteFeedbackComputationRealistic(targetBler, lambda, lambdaMinTh, lambdaMaxTh, lambdaRatioTh, numBands,
+        &(getBinder()->phyPisaData))
+{
+}
+
+LteFeedbackComputationRealistic::LteFeedbackComputationRealistic(double targetBler, std::map<MacNodeId, Lambda>* lambda,
+    double lambdaMinTh, double lambdaMaxTh, double lambdaRatioTh, unsigned int numBands, PhyPisaData* phyPisaData)
 {
     targetBler_ = targetBler;
     lambda_ = lambda;
@@ -24,9 +31,26 @@ LteFeedbackComputationRealistic::LteFeedbackComputationRealistic(double targetBl
     lambdaMinTh_ = lambdaMinTh;
     lambdaMaxTh_ = lambdaMaxTh;
     lambdaRatioTh_ = lambdaRatioTh;
-    phyPisaData_ = &(getBinder()->phyPisaData);
+    phyPisaData_ = phyPisaData;
+    txModeEnabled_.assign(DL_NUM_TXMODE, true);
+
+    cqiTable_.resize(phyPisaData_->nTxMode());
+    for (int txm = 0; txm < phyPisaData_->nTxMode(); txm++)
+    {
+        cqiTable_[txm].resize(phyPisaData_->maxSnr() + 1);
+        for (int snr = 0; snr <= phyPisaData_->maxSnr(); snr++)
+            cqiTable_[txm][snr] = searchCqi(txm, snr);
+    }
+}
 
-    baseMin_.resize(phyPisaData_->nMcs(), 2);
+void LteFeedbackComputationRealistic::setFeedbackTxModes(const std::vector<TxMode>& txModes)
+{
+    txModeEnabled_.assign(DL_NUM_TXMODE, txModes.empty());
+    for (unsigned int i = 0; i < txModes.size(); i++)
+        txModeEnabled_[txModes[i]] = true;
+    // MU-MIMO feedback is a copy of the SISO one
+    if (txModeEnabled_[MULTI_USER])
+        txModeEnabled_[SINGLE_ANTENNA_PORT0] = true;
 }
 
 LteFeedbackComputationRealistic::~LteFeedbackComputationRealistic()
@@ -35,7 +59,7 @@ LteFeedbackComputationRealistic::~LteFeedbackComputationRealistic()
 }
 
 void LteFeedbackComputationRealistic::generateBaseFeedback(int numBands, int numPreferredBands, LteFeedback& fb,
-    FeedbackType fbType, int cw, RbAllocationType rbAllocationType, TxMode txmode, std::vector<double> snr)
+    FeedbackType fbType, int cw, RbAllocationType rbAllocationType, TxMode txmode, const std::vector<double>& snr)
 {
     int layer = 1;
     std::vector<CqiVector> cqiTmp2;
@@ -106,33 +130,33 @@ unsigned int LteFeedbackComputationRealistic::computeRank(MacNodeId id)
         return 2;
 }
 
-Cqi LteFeedbackComputationRealistic::getCqi(TxMode txmode, double snr)
+Cqi LteFeedbackComputationRealistic::searchCqi(unsigned int txm, int snr)
 {
-    int newsnr = floor(snr + 0.5);
-    if (newsnr < 0)
-        return 0;
-    if (newsnr > phyPisaData_->maxSnr())
-        return 15;
-    unsigned int txm = txModeToIndex[txmode];
-    std::vector<double> min;
     int found = 0;
     double low = 2;
-
-    min = baseMin_;
     for (int i = 0; i < phyPisaData_->nMcs(); i++)
     {
-        double tmp = phyPisaData_->getBler(txm, i, newsnr);
-        double diff = targetBler_ - tmp;
-        min[i] = (diff > 0) ? diff : (diff * -1);
-        if (low >= min[i])
+        double tmp = phyPisaData_->getBler(txm, i, snr);
+        double diff = fabs(targetBler_ - tmp);
+        if (low >= diff)
         {
             found = i;
-            low = min[i];
+            low = diff;
         }
     }
     return found + 1;
 }
 
+Cqi LteFeedbackComputationRealistic::getCqi(TxMode txmode, double snr)
+{
+    int newsnr = floor(snr + 0.5);
+    if (newsnr < 0)
+        return 0;
+    if (newsnr > phyPisaData_->maxSnr())
+        return 15;
+    return cqiTable_[txModeToIndex[txmode]][newsnr];
+}
+
 LteFeedbackDoubleVector LteFeedbackComputationRealistic::computeFeedback(FeedbackType fbType,
     RbAllocationType rbAllocationType, TxMode currentTxMode,
     std::map<Remote, int> antennaCws, int numPreferredBands, FeedbackGeneratorType feedbackGeneratortype, int numRus,
@@ -153,6 +177,9 @@ LteFeedbackDoubleVector LteFeedbackComputationRealistic::computeFeedback(Feedbac
         //for each txmode we generate a feedback exclude MU_MIMO because it is threated as siso
         for (int z = 0; z < DL_NUM_TXMODE - 1; z++)
         {
+            // tx modes not in use are left empty
+            if (!txModeEnabled_[z])
+                continue;
             //reset the feedback object
             fb.reset();
             fb.setTxMode((TxMode) z);
@@ -172,9 +199,9 @@ LteFeedbackDoubleVector LteFeedbackComputationRealistic::computeFeedback(Feedbac
                     (TxMode) z, snr);
             }
             // add the feedback to the feedback structure
-            LteFeedback fb2 = fb;
-            if (z == SINGLE_ANTENNA_PORT0)
+            if (z == SINGLE_ANTENNA_PORT0 && txModeEnabled_[MULTI_USER])
             {
+                LteFeedback fb2 = fb;
                 fb2.setTxMode(MULTI_USER);
                 fbvv[j][MULTI_USER] = fb2;
             }
@@ -197,6 +224,9 @@ LteFeedbackVector LteFeedbackComputationRealistic::computeFeedback(const Remote
     //for each txmode we generate a feedback
     for (int z = 0; z < DL_NUM_TXMODE; z++)
     {
+        // tx modes not in use are left empty
+        if (!txModeEnabled_[z])
+            continue;
         fb.reset();
         fb.setTxMode((TxMode) z);
         unsigned int rank = 1;
@@ -215,9 +245,9 @@ LteFeedbackVector LteFeedbackComputationRealistic::computeFeedback(const Remote
                 snr);
         }
         // add the feedback to the feedback structure
-        LteFeedback fb2 = fb;
-        if (z == SINGLE_ANTENNA_PORT0)
+        if (z == SINGLE_ANTENNA_PORT0 && txModeEnabled_[MULTI_USER])
         {
+            LteFeedback fb2 = fb;
             fb2.setTxMode(MULTI_USER);
             fbv[MULTI_USER] = fb2;
         }
@@ -259,10 +289,10 @@ LteFeedback LteFeedbackComputationRealistic::computeFeedback(const Remote remote
     return fb;
 }
 
-double LteFeedbackComputationRealistic::meanSnr(std::vector<double> snr)
+double LteFeedbackComputationRealistic::meanSnr(const std::vector<double>& snr)
 {
     double mean = 0;
-    std::vector<double>::iterator it;
+    std::vector<double>::const_iterator it;
     for (it = snr.begin(); it != snr.end(); ++it)
         mean += *it;
     mean /= snr.size();
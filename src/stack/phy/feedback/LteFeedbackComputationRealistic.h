@@ -28,22 +28,40 @@ class SIMULTE_API LteFeedbackComputationRealistic : public LteFeedbackComputatio
     //pointer to pisadata
     PhyPisaData* phyPisaData_;
 
-    std::vector<double> baseMin_;
+    // CQI for each tx mode index and (rounded) SNR, built at construction
+    // for the target BLER
+    std::vector<std::vector<Cqi> > cqiTable_;
+
+    // Tx modes for which feedback is computed (all by default)
+    std::vector<bool> txModeEnabled_;
+
+    // Search the BLER curves for the MCS closest to the target BLER
+    Cqi searchCqi(unsigned int txm, int snr);
 
   protected:
     // Rank computation
     unsigned int computeRank(MacNodeId id);
     // Generate base feedback for all types of feedback(allbands, preferred, wideband)
     void generateBaseFeedback(int numBands, int numPreferredBabds, LteFeedback& fb, FeedbackType fbType, int cw,
-        RbAllocationType rbAllocationType, TxMode txmode, std::vector<double> snr);
-    // Get cqi from BLer Curves
+        RbAllocationType rbAllocationType, TxMode txmode, const std::vector<double>& snr);
+    // Get cqi from BLer Curves (table lookup)
     Cqi getCqi(TxMode txmode, double snr);
-    double meanSnr(std::vector<double> snr);
+    double meanSnr(const std::vector<double>& snr);
     public:
     LteFeedbackComputationRealistic(double targetBler, std::map<MacNodeId, Lambda>* lambda, double lambdaMinTh,
         double lambdaMaxTh, double lambdaRatioTh, unsigned int numBands);
+    // Same as above, using the given BLER curves instead of the binder's ones
+    LteFeedbackComputationRealistic(double targetBler, std::map<MacNodeId, Lambda>* lambda, double lambdaMinTh,
+        double lambdaMaxTh, double lambdaRatioTh, unsigned int numBands, PhyPisaData* phyPisaData);
     virtual ~LteFeedbackComputationRealistic();
 
+    /**
+     * Restricts the computation of the feedback to the given tx modes
+     * (all if empty). Feedback for the other tx modes is left empty, and
+     * thus ignored by the AMC.
+     */
+    void setFeedbackTxModes(const std::vector<TxMode>& txModes);
+
     virtual LteFeedbackDoubleVector computeFeedback(FeedbackType fbType, RbAllocationType rbAllocationType,
         TxMode currentTxMode,
         std::map<Remote, int> antennaCws, int numPreferredBands, FeedbackGeneratorType feedbackGeneratortype,
@@ -7,7 +7,7 @@
 
 #include "stack/phy/feedback/LteSummaryBuffer.h"
 
-void LteSummaryBuffer::createSummary(LteFeedback fb) {
+void LteSummaryBuffer::createSummary(const LteFeedback& fb) {
     try {
         // RI
         if (fb.hasRankIndicator()) {
@@ -26,7 +26,7 @@ class SIMULTE_API LteSummaryBuffer
     double totBands_;
     //! Cumulative summary feedback.
     LteSummaryFeedback cumulativeSummary_;
-    void createSummary(LteFeedback fb);
+    void createSummary(const LteFeedback& fb);
 
   public:
 
@@ -35,7 +35,7 @@ class SIMULTE_API LteSummaryBuffer
     { }
 
     //! Put a feedback into the buffer and update current summary feedback
-    void put(LteFeedback fb)
+    void put(const LteFeedback& fb)
     {
         if (bufferSize_ > 0)
         {
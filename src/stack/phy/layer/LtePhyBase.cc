@@ -9,6 +9,8 @@
 
 #include "stack/phy/layer/LtePhyBase.h"
 #include "common/LteCommon.h"
+#include "common/LteProfiler.h"
+#include <inet/mobility/contract/IMobility.h>
 
 using namespace omnetpp;
 
@@ -17,6 +19,8 @@ short LtePhyBase::airFramePriority_ = 10;
 LtePhyBase::LtePhyBase()
 {
     channelModel_ = nullptr;
+    nodeId_ = 0;
+    positionIndexed_ = false;
 }
 
 LtePhyBase::~LtePhyBase()
@@ -54,11 +58,29 @@ void LtePhyBase::initialize(int stage)
     {
         initializeChannelModel();
     }
+    else if (stage == inet::INITSTAGE_LAST)
+    {
+        // from now on, keep the position of the node known to the binder
+        if (nodeId_ != 0)
+        {
+            binder_->updateNodePosition(nodeId_, getRadioPosition());
+            positionIndexed_ = true;
+        }
+    }
+}
+
+void LtePhyBase::receiveSignal(cComponent *source, simsignal_t signalID, cObject *obj, cObject *details)
+{
+    ChannelAccess::receiveSignal(source, signalID, obj, details);
+
+    if (positionIndexed_ && signalID == inet::IMobility::mobilityStateChangedSignal)
+        binder_->updateNodePosition(nodeId_, getRadioPosition());
 }
 
 void LtePhyBase::handleMessage(cMessage* msg)
 {
-    EV << " LtePhyBase::handleMessage - new message received" << endl;
+    LTE_PROFILE_SCOPE(this, "handleMessage");
+    EV_PHY << " LtePhyBase::handleMessage - new message received" << endl;
 
     if (msg->isSelfMessage())
     {
@@ -78,7 +100,7 @@ void LtePhyBase::handleMessage(cMessage* msg)
     // unknown message
     else
     {
-        EV << "Unknown message received." << endl;
+        EV_PHY << "Unknown message received." << endl;
         delete msg;
     }
 }
@@ -115,7 +137,7 @@ LteAirFrame *LtePhyBase::createHandoverMessage()
 
 void LtePhyBase::handleUpperMessage(cMessage* msg)
 {
-    EV << "LtePhy: message from stack" << endl;
+    EV_PHY << "LtePhy: message from stack" << endl;
 
     auto pkt = check_and_cast<inet::Packet *>(msg);
     auto lteInfo = pkt->removeTag<UserControlInfo>();
@@ -150,7 +172,7 @@ void LtePhyBase::handleUpperMessage(cMessage* msg)
     lteInfo->setTxPower(txPower_);
     frame->setControlInfo(lteInfo.get()->dup());
 
-    EV << "LtePhy: " << nodeTypeToA(nodeType_) << " with id " << nodeId_
+    EV_PHY << "LtePhy: " << nodeTypeToA(nodeType_) << " with id " << nodeId_
        << " sending message to the air channel. Dest=" << lteInfo->getDestId() << endl;
     sendUnicast(frame);
 }
@@ -201,13 +223,34 @@ void LtePhyBase::sendMulticast(LteAirFrame *frame)
     if (groupId < 0)
         throw cRuntimeError("LtePhyBase::sendMulticast - Error. Group ID %d is not valid.", groupId);
 
+    if (enableMulticastD2DRangeCheck_ && positionIndexed_)
+    {
+        // only look at the nodes in range, in the same order as below
+        std::vector<MacNodeId> nodes;
+        binder_->getNodesInRange(getRadioPosition(), multicastD2DRange_, nodes);
+        std::vector<MacNodeId>::iterator it = nodes.begin();
+        for (; it != nodes.end(); ++it)
+        {
+            if (*it != nodeId_ && binder_->isInMulticastGroup(*it, groupId))
+            {
+                EV_PHY << NOW << " LtePhyBase::sendMulticast - sending frame to node " << *it << endl;
+
+                cModule *receiver = getSimulation()->getModule(binder_->getOmnetId(*it));
+                sendDirect(frame->dup(), 0, frame->getDuration(), receiver, getReceiverGateIndex(receiver));
+            }
+        }
+
+        delete frame;
+        return;
+    }
+
     // send the frame to nodes belonging to the multicast group only
     std::map<int, OmnetId>::const_iterator nodeIt = binder_->getNodeIdListBegin();
     for (; nodeIt != binder_->getNodeIdListEnd(); ++nodeIt)
     {
         if (nodeIt->first != nodeId_ && binder_->isInMulticastGroup(nodeIt->first, groupId))
         {
-            EV << NOW << " LtePhyBase::sendMulticast - node " << nodeIt->first << " is in the multicast group"<< endl;
+            EV_PHY << NOW << " LtePhyBase::sendMulticast - node " << nodeIt->first << " is in the multicast group"<< endl;
 
             // get a pointer to receiving module
             cModule *receiver = getSimulation()->getModule(nodeIt->second);
@@ -221,12 +264,12 @@ void LtePhyBase::sendMulticast(LteAirFrame *frame)
 
                 if( dist > multicastD2DRange_ )
                 {
-                    EV << NOW << " LtePhyBase::sendMulticast - node too far (" << dist << " > " << multicastD2DRange_ << ". skipping transmission" << endl;
+                    EV_PHY << NOW << " LtePhyBase::sendMulticast - node too far (" << dist << " > " << multicastD2DRange_ << ". skipping transmission" << endl;
                     continue;
                 }
             }
 
-            EV << NOW << " LtePhyBase::sendMulticast - sending frame to node " << nodeIt->first << endl;
+            EV_PHY << NOW << " LtePhyBase::sendMulticast - sending frame to node " << nodeIt->first << endl;
 
             sendDirect(frame->dup(), 0, frame->getDuration(), receiver, getReceiverGateIndex(receiver));
         }
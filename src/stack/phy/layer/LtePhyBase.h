@@ -98,6 +98,9 @@ class SIMULTE_API LtePhyBase : public ChannelAccess
     // used with the enableMulticastD2DRangeCheck_ parameter
     double multicastD2DRange_;
 
+    // true if the binder tracks the position of this node (see LteBinder::getNodesInRange())
+    bool positionIndexed_;
+
     /*
      * If true, UEs associate to the best serving cell at initialization
      */
@@ -193,6 +196,11 @@ class SIMULTE_API LtePhyBase : public ChannelAccess
         return std::max(inet::INITSTAGE_LAST+1, ChannelAccess::numInitStages());
     }
 
+    /**
+     * Updates the position of the node, also in the binder.
+     */
+    virtual void receiveSignal(omnetpp::cComponent *source, omnetpp::simsignal_t signalID, omnetpp::cObject *obj, omnetpp::cObject *details) override;
+
     /**
      * Processes messages received from #radioInGate_ or from the stack (#upperGateIn_).
      *
@@ -10,6 +10,7 @@
 #include "stack/phy/layer/LtePhyEnb.h"
 #include "stack/phy/packet/LteFeedbackPkt.h"
 #include "stack/phy/das/DasFilter.h"
+#include "stack/mac/amc/LteAmc.h"
 #include "common/LteCommon.h"
 
 Define_Module(LtePhyEnb);
@@ -21,6 +22,7 @@ LtePhyEnb::LtePhyEnb()
 {
     das_ = nullptr;
     bdcStarter_ = nullptr;
+    amc_ = nullptr;
 }
 
 LtePhyEnb::~LtePhyEnb()
@@ -49,7 +51,7 @@ void LtePhyEnb::initialize(int stage)
     {
         // get local id
         nodeId_ = getAncestorPar("macNodeId");
-        EV << "Local MacNodeId: " << nodeId_ << endl;
+        EV_PHY << "Local MacNodeId: " << nodeId_ << endl;
         nodeType_ = ENODEB;
         cellInfo_ = getCellInfo(nodeId_);
         cellInfo_->channelUpdate(nodeId_, intuniform(1, binder_->phyPisaData.maxChannel2()));
@@ -112,11 +114,11 @@ void LtePhyEnb::handleSelfMessage(cMessage *msg)
 
 bool LtePhyEnb::handleControlPkt(UserControlInfo* lteinfo, LteAirFrame* frame)
 {
-    EV << "Received control pkt " << endl;
+    EV_PHY << "Received control pkt " << endl;
     MacNodeId senderMacNodeId = lteinfo->getSourceId();
     if (binder_->getOmnetId(senderMacNodeId) == 0)
     {
-        EV << "Sender (" << senderMacNodeId << ") does not exist anymore!" << std::endl;
+        EV_PHY << "Sender (" << senderMacNodeId << ") does not exist anymore!" << std::endl;
         delete frame;
         return true;    // FIXME ? make sure that nodes that left the simulation do not send
     }
@@ -153,12 +155,12 @@ void LtePhyEnb::handleAirFrame(cMessage* msg)
 
     LteAirFrame* frame = static_cast<LteAirFrame*>(msg);
 
-    EV << "LtePhy: received new LteAirFrame with ID " << frame->getId() << " from channel" << endl;
+    EV_PHY << "LtePhy: received new LteAirFrame with ID " << frame->getId() << " from channel" << endl;
 
     // handle broadcast packet sent by another eNB
     if (lteInfo->getFrameType() == HANDOVERPKT)
     {
-        EV << "LtePhyEnb::handleAirFrame - received handover packet from another eNodeB. Ignore it." << endl;
+        EV_PHY << "LtePhyEnb::handleAirFrame - received handover packet from another eNodeB. Ignore it." << endl;
         delete lteInfo;
         delete frame;
         return;
@@ -174,9 +176,9 @@ void LtePhyEnb::handleAirFrame(cMessage* msg)
      */
     if (binder_->getNextHop(lteInfo->getSourceId()) != nodeId_)
     {
-        EV << "WARNING: frame from a UE that is leaving this cell (handover): deleted " << endl;
-        EV << "Source MacNodeId: " << lteInfo->getSourceId() << endl;
-        EV << "Master MacNodeId: " << nodeId_ << endl;
+        EV_PHY << "WARNING: frame from a UE that is leaving this cell (handover): deleted " << endl;
+        EV_PHY << "Source MacNodeId: " << lteInfo->getSourceId() << endl;
+        EV_PHY << "Master MacNodeId: " << nodeId_ << endl;
         delete lteInfo;
         delete frame;
         return;
@@ -198,14 +200,14 @@ void LtePhyEnb::handleAirFrame(cMessage* msg)
         return; // If frame contain a control pkt no further action is needed
 
     bool result = true;
-    RemoteSet r = lteInfo->getUserTxParams()->readAntennaSet();
+    const RemoteSet& r = lteInfo->getUserTxParams()->readAntennaSet();
     if (r.size() > 1)
     {
         // Use DAS
         // Message from ue
-        for (RemoteSet::iterator it = r.begin(); it != r.end(); it++)
+        for (RemoteSet::const_iterator it = r.begin(); it != r.end(); it++)
         {
-            EV << "LtePhy: Receiving Packet from antenna " << (*it) << "\n";
+            EV_PHY << "LtePhy: Receiving Packet from antenna " << (*it) << "\n";
 
             /*
              * On eNodeB set the current position
@@ -229,7 +231,7 @@ void LtePhyEnb::handleAirFrame(cMessage* msg)
     else
         numAirFrameNotReceived_++;
 
-    EV << "Handled LteAirframe with ID " << frame->getId() << " with result "
+    EV_PHY << "Handled LteAirframe with ID " << frame->getId() << " with result "
        << (result ? "RECEIVED" : "NOT RECEIVED") << endl;
 
     auto pkt = check_and_cast<inet::Packet *>(frame->decapsulate());
@@ -250,7 +252,7 @@ void LtePhyEnb::handleAirFrame(cMessage* msg)
 }
 void LtePhyEnb::requestFeedback(UserControlInfo* lteinfo, LteAirFrame* frame, Packet* pktAux)
 {
-    EV << NOW << " LtePhyEnb::requestFeedback " << endl;
+    EV_PHY << NOW << " LtePhyEnb::requestFeedback " << endl;
     //get UE Position
     Coord sendersPos = lteinfo->getCoord();
     cellInfo_->setUePosition(lteinfo->getSourceId(), sendersPos);
@@ -270,6 +272,7 @@ void LtePhyEnb::requestFeedback(UserControlInfo* lteinfo, LteAirFrame* frame, Pa
     RbAllocationType rbtype = req.rbAllocationType;
     std::map<Remote, int> antennaCws = cellInfo_->getAntennaCws();
     unsigned int numPreferredBand = cellInfo_->getNumPreferredBands();
+    const RemoteSet& reportingSet = das_->getReportingSet();
 
     for (Direction dir = UL; dir != UNKNOWN_DIRECTION;
         dir = ((dir == UL )? DL : UNKNOWN_DIRECTION))
@@ -283,10 +286,9 @@ void LtePhyEnb::requestFeedback(UserControlInfo* lteinfo, LteAirFrame* frame, Pa
         }
         else if (req.genType == REAL)
         {
-            RemoteSet::iterator it;
-            fb_.resize(das_->getReportingSet().size());
-            for (it = das_->getReportingSet().begin();
-                it != das_->getReportingSet().end(); ++it)
+            RemoteSet::const_iterator it;
+            fb_.resize(reportingSet.size());
+            for (it = reportingSet.begin(); it != reportingSet.end(); ++it)
             {
                 fb_[(*it)].resize((int) txmode);
                 fb_[(*it)][(int) txmode] =
@@ -298,10 +300,9 @@ void LtePhyEnb::requestFeedback(UserControlInfo* lteinfo, LteAirFrame* frame, Pa
         // the reports are computed only for the antenna in the reporting set
         else if (req.genType == DAS_AWARE)
         {
-            RemoteSet::iterator it;
-            fb_.resize(das_->getReportingSet().size());
-            for (it = das_->getReportingSet().begin();
-                it != das_->getReportingSet().end(); ++it)
+            RemoteSet::const_iterator it;
+            fb_.resize(reportingSet.size());
+            for (it = reportingSet.begin(); it != reportingSet.end(); ++it)
             {
                 fb_[(*it)] = lteFeedbackComputation_->computeFeedback(*it, type,
                     rbtype, txmode, antennaCws[*it], numPreferredBand,
@@ -323,7 +324,7 @@ void LtePhyEnb::requestFeedback(UserControlInfo* lteinfo, LteAirFrame* frame, Pa
         else
             header->setLteFeedbackDoubleVectorDl(fb_);
     }
-    EV << "LtePhyEnb::requestFeedback : Pisa Feedback Generated for nodeId: "
+    EV_PHY << "LtePhyEnb::requestFeedback : Pisa Feedback Generated for nodeId: "
        << nodeId_ << " with generator type "
        << fbGeneratorTypeToA(req.genType) << " Fb size: " << fb_.size() << endl;
 
@@ -333,7 +334,7 @@ void LtePhyEnb::requestFeedback(UserControlInfo* lteinfo, LteAirFrame* frame, Pa
 void LtePhyEnb::handleFeedbackPkt(UserControlInfo* lteinfo,
     LteAirFrame *frame)
 {
-    EV << "Handled Feedback Packet with ID " << frame->getId() << endl;
+    EV_PHY << "Handled Feedback Packet with ID " << frame->getId() << endl;
     auto pktAux = check_and_cast<Packet *>(frame->decapsulate());
     auto header =  pktAux->peekAtFront<LteFeedbackPkt>();
 
@@ -356,9 +357,9 @@ void LtePhyEnb::handleFeedbackPkt(UserControlInfo* lteinfo,
                 for (jt = it->begin(); jt != it->end(); ++jt)
                 {
                     MacNodeId id = lteinfo->getSourceId();
-                    EV << endl << "Node:" << id << endl;
+                    EV_PHY << endl << "Node:" << id << endl;
                     TxMode t = jt->getTxMode();
-                    EV << "TXMODE: " << txModeToA(t) << endl;
+                    EV_PHY << "TXMODE: " << txModeToA(t) << endl;
                     if (jt->hasBandCqi())
                     {
                         std::vector<CqiVector> vec = jt->getBandCqi();
@@ -369,7 +370,7 @@ void LtePhyEnb::handleFeedbackPkt(UserControlInfo* lteinfo,
                         {
                             for (i = 0, ht = kt->begin(); ht != kt->end();
                                 ++ht, i++)
-                            EV << "Banda " << i << " Cqi " << *ht << endl;
+                            EV_PHY << "Banda " << i << " Cqi " << *ht << endl;
                         }
                     }
                     else if (jt->hasWbCqi())
@@ -377,11 +378,11 @@ void LtePhyEnb::handleFeedbackPkt(UserControlInfo* lteinfo,
                         CqiVector v = jt->getWbCqi();
                         CqiVector::iterator ht = v.begin();
                         for (; ht != v.end(); ++ht)
-                        EV << "wb cqi " << *ht << endl;
+                        EV_PHY << "wb cqi " << *ht << endl;
                     }
                     if (jt->hasRankIndicator())
                     {
-                        EV << "Rank " << jt->getRankIndicator() << endl;
+                        EV_PHY << "Rank " << jt->getRankIndicator() << endl;
                     }
                 }
             }
@@ -392,6 +393,44 @@ void LtePhyEnb::handleFeedbackPkt(UserControlInfo* lteinfo,
     send(pktAux, upperGateOut_);
 }
 
+void LtePhyEnb::handleDirectFeedback(UserControlInfo* lteinfo)
+{
+    Enter_Method_Silent("handleDirectFeedback");
+
+    MacNodeId ueId = lteinfo->getSourceId();
+    if (binder_->getNextHop(ueId) != nodeId_)
+    {
+        // same as a feedback packet in the air while the UE changes master
+        EV_PHY << "LtePhyEnb::handleDirectFeedback - feedback from a UE that is leaving this cell (handover): ignored " << endl;
+        return;
+    }
+    if (amc_ == nullptr)
+        amc_ = getAmcModule(nodeId_);
+
+    //get UE Position
+    cellInfo_->setUePosition(ueId, lteinfo->getCoord());
+
+    const FeedbackRequest& req = lteinfo->feedbackReq;
+    if (req.genType != IDEAL)
+        throw cRuntimeError("LtePhyEnb::handleDirectFeedback - only IDEAL feedback generation can use the direct feedback channel");
+
+    // UL (channel models do not use the airframe to compute the SINR)
+    std::vector<double> snr = channelModel_->getSINR(nullptr, lteinfo);
+    fb_ = lteFeedbackComputation_->computeFeedback(req.type, req.rbAllocationType, req.txMode,
+        cellInfo_->getAntennaCws(), cellInfo_->getNumPreferredBands(), IDEAL, cellInfo_->getNumRus(), snr, ueId);
+    amc_->pushFeedback(ueId, UL, fb_);
+
+    // DL
+    lteinfo->setTxPower(txPower_);
+    lteinfo->setDirection(DL);
+    snr = channelModel_->getSINR(nullptr, lteinfo);
+    fb_ = lteFeedbackComputation_->computeFeedback(req.type, req.rbAllocationType, req.txMode,
+        cellInfo_->getAntennaCws(), cellInfo_->getNumPreferredBands(), IDEAL, cellInfo_->getNumRus(), snr, ueId);
+    amc_->pushFeedback(ueId, DL, fb_);
+
+    EV_PHY << "LtePhyEnb::handleDirectFeedback : Pisa Feedback Generated for nodeId: " << ueId << endl;
+}
+
 // TODO adjust default value
 LteFeedbackComputation* LtePhyEnb::getFeedbackComputationFromName(
     std::string name, ParameterMap& params)
@@ -444,10 +483,24 @@ void LtePhyEnb::initializeFeedbackComputation()
     double lambdaMaxTh = par("lambdaMaxTh");
     double lambdaRatioTh = par("lambdaRatioTh");
 
-    lteFeedbackComputation_ = new LteFeedbackComputationRealistic(
+    LteFeedbackComputationRealistic* fbcomp = new LteFeedbackComputationRealistic(
         targetBler, cellInfo_->getLambda(), lambdaMinTh, lambdaMaxTh,
         lambdaRatioTh, cellInfo_->getNumBands());
 
-    EV << "Feedback Computation \"" << name << "\" loaded." << endl;
+    // restrict the feedback to the tx modes in use, if configured
+    std::vector<TxMode> txModes;
+    cStringTokenizer tokenizer(par("feedbackTxModes"));
+    while (tokenizer.hasMoreTokens())
+    {
+        const char* token = tokenizer.nextToken();
+        TxMode txMode = aToTxMode(token);
+        if (txMode == UNKNOWN_TX_MODE)
+            throw cRuntimeError("LtePhyEnb::initializeFeedbackComputation - unknown tx mode \"%s\" in feedbackTxModes", token);
+        txModes.push_back(txMode);
+    }
+    fbcomp->setFeedbackTxModes(txModes);
+    lteFeedbackComputation_ = fbcomp;
+
+    EV_PHY << "Feedback Computation \"" << name << "\" loaded." << endl;
 }
 
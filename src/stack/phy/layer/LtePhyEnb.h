@@ -34,6 +34,8 @@ class SIMULTE_API LtePhyEnb : public LtePhyBase
     DasFilter* das_;
     //Used for PisaPhy feedback generator
     LteFeedbackDoubleVector fb_;
+    //AMC of this eNB, target of the direct feedback channel (resolved on first use)
+    LteAmc* amc_;
 
     virtual void initialize(int stage);
 
@@ -54,6 +56,18 @@ class SIMULTE_API LtePhyEnb : public LtePhyBase
     LtePhyEnb();
     virtual ~LtePhyEnb();
 
+    /**
+     * Direct feedback channel, used by UEs with ideal feedback generation
+     * and directFeedback enabled. Computes the UL and DL feedback as on the
+     * reception of a feedback packet and stores it straight into the AMC,
+     * without airframe, packet and MAC round trip.
+     *
+     * @param lteinfo control info describing the feedback "transmission"
+     *        (source, destination, position, tx power, feedback request).
+     *        It is modified as in requestFeedback()
+     */
+    virtual void handleDirectFeedback(UserControlInfo* lteinfo);
+
 };
 
 #endif  /* _LTE_AIRPHYENB_H_ */
@@ -11,6 +11,7 @@
 #include "stack/phy/packet/LteFeedbackPkt.h"
 #include "common/LteCommon.h"
 #include "stack/phy/das/DasFilter.h"
+#include "stack/mac/amc/LteAmc.h"
 
 Define_Module(LtePhyEnbD2D);
 
@@ -30,7 +31,7 @@ void LtePhyEnbD2D::initialize(int stage)
 
 void LtePhyEnbD2D::requestFeedback(UserControlInfo* lteinfo, LteAirFrame* frame, Packet* pktAux)
 {
-    EV << NOW << " LtePhyEnbD2D::requestFeedback " << endl;
+    EV_PHY << NOW << " LtePhyEnbD2D::requestFeedback " << endl;
 
     auto header = pktAux->removeAtFront<LteFeedbackPkt>();
 
@@ -134,24 +135,53 @@ void LtePhyEnbD2D::requestFeedback(UserControlInfo* lteinfo, LteAirFrame* frame,
             dir = UNKNOWN_DIRECTION;
         }
     }
-    EV << "LtePhyEnbD2D::requestFeedback : Pisa Feedback Generated for nodeId: "
+    EV_PHY << "LtePhyEnbD2D::requestFeedback : Pisa Feedback Generated for nodeId: "
        << nodeId_ << " with generator type "
        << fbGeneratorTypeToA(req.genType) << " Fb size: " << fb_.size() << endl;
 
     pktAux->insertAtFront(header);
 }
 
+void LtePhyEnbD2D::handleDirectFeedback(UserControlInfo* lteinfo)
+{
+    Enter_Method_Silent("handleDirectFeedback");
+
+    // UL and DL feedback, leaves lteinfo set up for the DL direction
+    LtePhyEnb::handleDirectFeedback(lteinfo);
+
+    MacNodeId ueId = lteinfo->getSourceId();
+    if (!enableD2DCqiReporting_ || binder_->getNextHop(ueId) != nodeId_)
+        return;
+
+    const FeedbackRequest& req = lteinfo->feedbackReq;
+
+    // compute D2D feedback for all possible peering UEs (only in-cell D2D)
+    std::vector<UeInfo*>* ueList = binder_->getUeList();
+    std::vector<UeInfo*>::iterator it = ueList->begin();
+    for (; it != ueList->end(); ++it)
+    {
+        MacNodeId peerId = (*it)->id;
+        if (peerId != ueId && binder_->getD2DCapability(ueId, peerId) && binder_->getNextHop(peerId) == nodeId_)
+        {
+            std::vector<double> snr = channelModel_->getSINR_D2D(nullptr, lteinfo, peerId, (*it)->phy->getCoord(), nodeId_);
+            fb_ = lteFeedbackComputation_->computeFeedback(req.type, req.rbAllocationType, req.txMode,
+                cellInfo_->getAntennaCws(), cellInfo_->getNumPreferredBands(), IDEAL, cellInfo_->getNumRus(), snr, ueId);
+            amc_->pushFeedbackD2D(ueId, fb_, peerId);
+        }
+    }
+}
+
 void LtePhyEnbD2D::handleAirFrame(cMessage* msg)
 {
     UserControlInfo* lteInfo = check_and_cast<UserControlInfo*>(msg->removeControlInfo());
     LteAirFrame* frame = static_cast<LteAirFrame*>(msg);
 
-    EV << "LtePhyEnbD2D::handleAirFrame - received new LteAirFrame with ID " << frame->getId() << " from channel" << endl;
+    EV_PHY << "LtePhyEnbD2D::handleAirFrame - received new LteAirFrame with ID " << frame->getId() << " from channel" << endl;
 
     // handle broadcast packet sent by another eNB
     if (lteInfo->getFrameType() == HANDOVERPKT)
     {
-        EV << "LtePhyEnb::handleAirFrame - received handover packet from another eNodeB. Ignore it." << endl;
+        EV_PHY << "LtePhyEnb::handleAirFrame - received handover packet from another eNodeB. Ignore it." << endl;
         delete lteInfo;
         delete frame;
         return;
@@ -160,10 +190,10 @@ void LtePhyEnbD2D::handleAirFrame(cMessage* msg)
     // Check if the frame is for us ( MacNodeId matches or - if this is a multicast communication - enrolled in multicast group)
     if (lteInfo->getDestId() != nodeId_)
     {
-        EV << "ERROR: Frame is not for us. Delete it." << endl;
-        EV << "Packet Type: " << phyFrameTypeToA((LtePhyFrameType)lteInfo->getFrameType()) << endl;
-        EV << "Frame MacNodeId: " << lteInfo->getDestId() << endl;
-        EV << "Local MacNodeId: " << nodeId_ << endl;
+        EV_PHY << "ERROR: Frame is not for us. Delete it." << endl;
+        EV_PHY << "Packet Type: " << phyFrameTypeToA((LtePhyFrameType)lteInfo->getFrameType()) << endl;
+        EV_PHY << "Frame MacNodeId: " << lteInfo->getDestId() << endl;
+        EV_PHY << "Local MacNodeId: " << nodeId_ << endl;
         delete lteInfo;
         delete frame;
         return;
@@ -171,10 +201,10 @@ void LtePhyEnbD2D::handleAirFrame(cMessage* msg)
 
     if (lteInfo->getMulticastGroupId() != -1 && !(binder_->isInMulticastGroup(nodeId_, lteInfo->getMulticastGroupId())))
     {
-        EV << "Frame is for a multicast group, but we do not belong to that group. Delete the frame." << endl;
-        EV << "Packet Type: " << phyFrameTypeToA((LtePhyFrameType)lteInfo->getFrameType()) << endl;
-        EV << "Frame MacNodeId: " << lteInfo->getDestId() << endl;
-        EV << "Local MacNodeId: " << nodeId_ << endl;
+        EV_PHY << "Frame is for a multicast group, but we do not belong to that group. Delete the frame." << endl;
+        EV_PHY << "Packet Type: " << phyFrameTypeToA((LtePhyFrameType)lteInfo->getFrameType()) << endl;
+        EV_PHY << "Frame MacNodeId: " << lteInfo->getDestId() << endl;
+        EV_PHY << "Local MacNodeId: " << nodeId_ << endl;
         delete lteInfo;
         delete frame;
         return;
@@ -190,9 +220,9 @@ void LtePhyEnbD2D::handleAirFrame(cMessage* msg)
      */
     if (binder_->getNextHop(lteInfo->getSourceId()) != nodeId_)
     {
-        EV << "WARNING: frame from a UE that is leaving this cell (handover): deleted " << endl;
-        EV << "Source MacNodeId: " << lteInfo->getSourceId() << endl;
-        EV << "Master MacNodeId: " << nodeId_ << endl;
+        EV_PHY << "WARNING: frame from a UE that is leaving this cell (handover): deleted " << endl;
+        EV_PHY << "Source MacNodeId: " << lteInfo->getSourceId() << endl;
+        EV_PHY << "Master MacNodeId: " << nodeId_ << endl;
         delete lteInfo;
         delete frame;
         return;
@@ -221,7 +251,7 @@ void LtePhyEnbD2D::handleAirFrame(cMessage* msg)
         // Message from ue
         for (RemoteSet::iterator it = r.begin(); it != r.end(); it++)
         {
-            EV << "LtePhy: Receiving Packet from antenna " << (*it) << "\n";
+            EV_PHY << "LtePhy: Receiving Packet from antenna " << (*it) << "\n";
 
             /*
              * On eNodeB set the current position
@@ -246,7 +276,7 @@ void LtePhyEnbD2D::handleAirFrame(cMessage* msg)
     else
         numAirFrameNotReceived_++;
 
-    EV << "Handled LteAirframe with ID " << frame->getId() << " with result "
+    EV_PHY << "Handled LteAirframe with ID " << frame->getId() << " with result "
        << (result ? "RECEIVED" : "NOT RECEIVED") << endl;
 
     auto pkt = check_and_cast<inet::Packet *>(frame->decapsulate());
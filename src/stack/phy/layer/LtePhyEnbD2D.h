@@ -27,6 +27,8 @@ class SIMULTE_API LtePhyEnbD2D : public LtePhyEnb
   public:
     virtual ~LtePhyEnbD2D();
 
+    virtual void handleDirectFeedback(UserControlInfo* lteinfo) override;
+
 };
 
 #endif  /* _LTE_AIRPHYENBD2D_H_ */
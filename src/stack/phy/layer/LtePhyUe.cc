@@ -12,6 +12,7 @@
 #include "stack/phy/packet/LteFeedbackPkt.h"
 #include "corenetwork/lteip/IP2lte.h"
 #include "stack/phy/feedback/LteDlFeedbackGenerator.h"
+#include "stack/phy/layer/LtePhyEnb.h"
 
 Define_Module(LtePhyUe);
 
@@ -21,11 +22,17 @@ LtePhyUe::LtePhyUe()
 {
     handoverStarter_ = nullptr;
     handoverTrigger_ = nullptr;
+    handoverMeasurement_ = nullptr;
+    measurementFrame_ = nullptr;
+    measurementInfo_ = nullptr;
 }
 
 LtePhyUe::~LtePhyUe()
 {
     cancelAndDelete(handoverStarter_);
+    cancelAndDelete(handoverMeasurement_);
+    delete measurementInfo_;
+    delete measurementFrame_;
     delete das_;
 }
 
@@ -46,8 +53,21 @@ void LtePhyUe::initialize(int stage)
         hysteresisFactor_ = 10;
         handoverDelta_ = 0.00001;
 
+        handoverMeasurementPeriod_ = par("handoverMeasurementPeriod").doubleValue();
+        handoverMeasurementRange_ = par("handoverMeasurementRange").doubleValue();
+        int filterCoefficient = par("handoverFilterCoefficient");
+        if (filterCoefficient < 0)
+            throw cRuntimeError("LtePhyUe::initialize - handoverFilterCoefficient must not be negative");
+        l3FilterWeight_ = pow(0.5, filterCoefficient / 4.0);
+        measurementMinDistance_ = par("handoverMeasurementMinDistance").doubleValue();
+        measurementMinRssiChange_ = par("handoverMeasurementMinRssiChange").doubleValue();
+        lastMeasurementMasterRssi_ = 0;
+        neighboursMeasured_ = false;
+        measurementRound_ = 0;
+
         dasRssiThreshold_ = 1.0e-5;
         das_ = new DasFilter(this, binder_, nullptr, dasRssiThreshold_);
+        das_->setCacheDistance(par("dasCacheDistance").doubleValue());
 
         servingCell_ = registerSignal("servingCell");
         averageCqiDl_ = registerSignal("averageCqiDl");
@@ -86,6 +106,17 @@ void LtePhyUe::initialize(int stage)
         lastFeedback_ = 0;
 
         handoverStarter_ = new cMessage("handoverStarter");
+        if (enableHandover_ && handoverMeasurementPeriod_ > 0)
+        {
+            measurementFrame_ = new LteAirFrame("handoverMeasurementFrame");
+            measurementInfo_ = new UserControlInfo();
+            measurementInfo_->setIsBroadcast(true);
+            measurementInfo_->setIsCorruptible(false);
+            measurementInfo_->setFrameType(HANDOVERPKT);
+
+            // scheduled once the serving cell is known
+            handoverMeasurement_ = new cMessage("handoverMeasurement");
+        }
         mac_ = check_and_cast<LteMacUe *>(
             getParentModule()-> // nic
             getSubmodule("mac"));
@@ -127,7 +158,7 @@ void LtePhyUe::initialize(int stage)
                     rssi += *it;
                 rssi /= rssiV.size();   // compute the mean over all RBs
 
-                EV << "LtePhyUe::initialize - RSSI from eNodeB " << cellId << ": " << rssi << " dB (current candidate eNodeB " << candidateMasterId_ << ": " << candidateMasterRssi_ << " dB" << endl;
+                EV_PHY << "LtePhyUe::initialize - RSSI from eNodeB " << cellId << ": " << rssi << " dB (current candidate eNodeB " << candidateMasterId_ << ": " << candidateMasterRssi_ << " dB" << endl;
 
                 if (rssi > candidateMasterRssi_)
                 {
@@ -150,16 +181,20 @@ void LtePhyUe::initialize(int stage)
             masterId_ = getAncestorPar("masterId");
             candidateMasterId_ = masterId_;
         }
-        EV << "LtePhyUe::initialize - Attaching to eNodeB " << masterId_ << endl;
+        EV_PHY << "LtePhyUe::initialize - Attaching to eNodeB " << masterId_ << endl;
 
         das_->setMasterRuSet(masterId_);
         emit(servingCell_, (long)masterId_);
+
+        // periodic measurements need a serving cell
+        if (handoverMeasurement_ != nullptr && masterId_ != 0)
+            scheduleAt(NOW + handoverMeasurementPeriod_, handoverMeasurement_);
     }
     else if (stage == inet::INITSTAGE_NETWORK_CONFIGURATION)
     {
         // get local id
         nodeId_ = getAncestorPar("macNodeId");
-        EV << "Local MacNodeId: " << nodeId_ << endl;
+        EV_PHY << "Local MacNodeId: " << nodeId_ << endl;
 
         // get cellInfo at this stage because the next hop of the node is registered in the IP2Lte module at the INITSTAGE_NETWORK_LAYER
         cellInfo_ = getCellInfo(nodeId_);
@@ -179,15 +214,24 @@ void LtePhyUe::handleSelfMessage(cMessage *msg)
         delete msg;
         handoverTrigger_ = nullptr;
     }
+    else if (msg->isName("handoverMeasurement"))
+    {
+        // skip the round if handover is already in process
+        if (handoverTrigger_ == nullptr || !handoverTrigger_->isScheduled())
+            doHandoverMeasurement();
+        // stop measuring if the UE has no serving cell
+        if (masterId_ != 0)
+            scheduleAt(NOW + handoverMeasurementPeriod_, msg);
+    }
 }
 
 void LtePhyUe::handoverHandler(LteAirFrame* frame, UserControlInfo* lteInfo)
 {
     lteInfo->setDestId(nodeId_);
-    if (!enableHandover_)
+    if (!enableHandover_ || handoverMeasurement_ != nullptr)
     {
-        // Even if handover is not enabled, this call is necessary
-        // to allow Reporting Set computation.
+        // Even if handover is not enabled (or it is driven by periodic
+        // measurements), this call is necessary to allow Reporting Set computation.
         if (getNodeTypeById(lteInfo->getSourceId()) == ENODEB && lteInfo->getSourceId() == masterId_)
         {
             // Broadcast message from my master enb
@@ -218,11 +262,18 @@ void LtePhyUe::handoverHandler(LteAirFrame* frame, UserControlInfo* lteInfo)
         rssi /= rssiV.size();
     }
 
-    EV << "UE " << nodeId_ << " broadcast frame from " << lteInfo->getSourceId() << " with RSSI: " << rssi << " at " << simTime() << endl;
+    EV_PHY << "UE " << nodeId_ << " broadcast frame from " << lteInfo->getSourceId() << " with RSSI: " << rssi << " at " << simTime() << endl;
+
+    evaluateHandoverRssi(lteInfo->getSourceId(), rssi);
 
+    delete frame;
+}
+
+void LtePhyUe::evaluateHandoverRssi(MacNodeId cellId, double rssi)
+{
     if (rssi > candidateMasterRssi_ + hysteresisTh_)
     {
-        if (lteInfo->getSourceId() == masterId_)
+        if (cellId == masterId_)
         {
             // receiving even stronger broadcast from current master
             currentMasterRssi_ = rssi;
@@ -234,7 +285,7 @@ void LtePhyUe::handoverHandler(LteAirFrame* frame, UserControlInfo* lteInfo)
         else
         {
             // broadcast from another master with higher rssi
-            candidateMasterId_ = lteInfo->getSourceId();
+            candidateMasterId_ = cellId;
             candidateMasterRssi_ = rssi;
             hysteresisTh_ = updateHysteresisTh(rssi);
             // schedule self message to evaluate handover parameters after
@@ -249,29 +300,141 @@ void LtePhyUe::handoverHandler(LteAirFrame* frame, UserControlInfo* lteInfo)
     }
     else
     {
-        if (lteInfo->getSourceId() == masterId_)
+        if (cellId == masterId_)
         {
             currentMasterRssi_ = rssi;
             candidateMasterRssi_ = rssi;
             hysteresisTh_ = updateHysteresisTh(rssi);
         }
     }
+}
 
-    delete frame;
+void LtePhyUe::doHandoverMeasurement()
+{
+    measurementRound_++;
+
+    // the serving cell is measured at every round
+    double masterRssi;
+    if (!measureRssi(masterId_, masterRssi))
+    {
+        EV_PHY << "LtePhyUe::doHandoverMeasurement - UE " << nodeId_ << " cannot measure its serving cell " << masterId_ << ", round skipped" << endl;
+        return;
+    }
+    masterRssi = filterRssi(masterId_, masterRssi);
+
+    // neighbour cells are measured again only if the UE moved or the serving cell RSSI changed enough
+    inet::Coord pos = getRadioPosition();
+    if (!neighboursMeasured_ || pos.distance(lastMeasurementPos_) >= measurementMinDistance_
+        || fabs(masterRssi - lastMeasurementMasterRssi_) >= measurementMinRssiChange_)
+    {
+        lastMeasurementPos_ = pos;
+        lastMeasurementMasterRssi_ = masterRssi;
+        neighboursMeasured_ = true;
+
+        measuredCells_.clear();
+        binder_->getEnbsInRange(pos, handoverMeasurementRange_, measuredCells_);
+        std::vector<EnbInfo*>::iterator it = measuredCells_.begin();
+        while (it != measuredCells_.end())
+        {
+            double rssi;
+            if ((*it)->id == masterId_)
+                ++it;
+            else if (measureRssi((*it)->id, rssi))
+            {
+                filterRssi((*it)->id, rssi);
+                ++it;
+            }
+            else
+                it = measuredCells_.erase(it);  // the cell cannot be resolved, do not evaluate it
+        }
+    }
+    else
+    {
+        EV_PHY << "LtePhyUe::doHandoverMeasurement - UE " << nodeId_ << " reuses the last neighbour measurements" << endl;
+        std::vector<EnbInfo*>::iterator it = measuredCells_.begin();
+        while (it != measuredCells_.end())
+        {
+            if ((*it)->id != masterId_ && binder_->getOmnetId((*it)->id) == 0)
+            {
+                // the cell has been removed since it was measured
+                it = measuredCells_.erase(it);
+                continue;
+            }
+            if ((*it)->id != masterId_)
+                l3Rssi_[(*it)->id].round = measurementRound_;
+            ++it;
+        }
+    }
+
+    // evaluate handover, starting from the serving cell
+    evaluateHandoverRssi(masterId_, masterRssi);
+    std::vector<EnbInfo*>::iterator it = measuredCells_.begin();
+    for (; it != measuredCells_.end(); ++it)
+    {
+        if ((*it)->id != masterId_)
+            evaluateHandoverRssi((*it)->id, l3Rssi_[(*it)->id].rssi);
+    }
+}
+
+bool LtePhyUe::measureRssi(MacNodeId cellId, double& rssi)
+{
+    // the cell may be unknown (no serving cell) or have been removed from the simulation
+    OmnetId omnetId = binder_->getOmnetId(cellId);
+    cModule* cell = (omnetId == 0) ? nullptr : getSimulation()->getModule(omnetId);
+    if (cell == nullptr)
+    {
+        EV_PHY << "LtePhyUe::measureRssi - UE " << nodeId_ << " cannot resolve cell " << cellId << endl;
+        return false;
+    }
+    LtePhyBase* cellPhy = check_and_cast<LtePhyBase*>(cell->getSubmodule("lteNic")->getSubmodule("phy"));
+
+    measurementInfo_->setSourceId(cellId);
+    measurementInfo_->setDestId(nodeId_);
+    measurementInfo_->setTxPower(cellPhy->getTxPwr());
+    measurementInfo_->setCoord(cellPhy->getCoord());
+
+    rssi = 0;
+    std::vector<double> rssiV = channelModel_->getSINR(measurementFrame_, measurementInfo_);
+    std::vector<double>::iterator it;
+    for (it = rssiV.begin(); it != rssiV.end(); ++it)
+        rssi += *it;
+    rssi /= rssiV.size();   // compute the mean over all RBs
+
+    EV_PHY << "LtePhyUe::measureRssi - UE " << nodeId_ << " measured RSSI " << rssi << " dB from cell " << cellId << endl;
+    return true;
+}
+
+double LtePhyUe::filterRssi(MacNodeId cellId, double rssi)
+{
+    std::map<MacNodeId, L3Measurement>::iterator it = l3Rssi_.find(cellId);
+    if (it == l3Rssi_.end())
+        it = l3Rssi_.insert(std::make_pair(cellId, L3Measurement())).first;
+    else if (it->second.round + 1 == measurementRound_)
+    {
+        // the cell was measured at the previous round too
+        it->second.rssi = (1 - l3FilterWeight_) * it->second.rssi + l3FilterWeight_ * rssi;
+        it->second.round = measurementRound_;
+        return it->second.rssi;
+    }
+
+    // first sample, or the cell was not measured at the previous round: restart the filter
+    it->second.rssi = rssi;
+    it->second.round = measurementRound_;
+    return rssi;
 }
 
 void LtePhyUe::triggerHandover()
 {
     ASSERT(masterId_ != candidateMasterId_);
 
-    EV << "####Handover starting:####" << endl;
-    EV << "current master: " << masterId_ << endl;
-    EV << "current rssi: " << currentMasterRssi_ << endl;
-    EV << "candidate master: " << candidateMasterId_ << endl;
-    EV << "candidate rssi: " << candidateMasterRssi_ << endl;
-    EV << "############" << endl;
+    EV_PHY << "####Handover starting:####" << endl;
+    EV_PHY << "current master: " << masterId_ << endl;
+    EV_PHY << "current rssi: " << currentMasterRssi_ << endl;
+    EV_PHY << "candidate master: " << candidateMasterId_ << endl;
+    EV_PHY << "candidate rssi: " << candidateMasterRssi_ << endl;
+    EV_PHY << "############" << endl;
 
-    EV << NOW << " LtePhyUe::triggerHandover - UE " << nodeId_ << " is starting handover to eNB " << candidateMasterId_ << "... " << endl;
+    EV_PHY << NOW << " LtePhyUe::triggerHandover - UE " << nodeId_ << " is starting handover to eNB " << candidateMasterId_ << "... " << endl;
 
     binder_->addUeHandoverTriggered(nodeId_);
 
@@ -317,6 +480,10 @@ void LtePhyUe::doHandover()
     currentMasterRssi_ = candidateMasterRssi_;
     hysteresisTh_ = updateHysteresisTh(currentMasterRssi_);
 
+    // resume the periodic measurements, if they were stopped for lack of a serving cell
+    if (handoverMeasurement_ != nullptr && masterId_ != 0 && !handoverMeasurement_->isScheduled())
+        scheduleAt(NOW + handoverMeasurementPeriod_, handoverMeasurement_);
+
     // update cellInfo
     LteMacEnb* newMacEnb =  check_and_cast<LteMacEnb*>(getSimulation()->getModule(binder_->getOmnetId(candidateMasterId_))->getSubmodule("lteNic")->getSubmodule("mac"));
     LteCellInfo* newCellInfo = newMacEnb->getCellInfo();
@@ -331,7 +498,7 @@ void LtePhyUe::doHandover()
     // collect stat
     emit(servingCell_, (long)masterId_);
 
-    EV << NOW << " LtePhyUe::doHandover - UE " << nodeId_ << " has completed handover to eNB " << masterId_ << "... " << endl;
+    EV_PHY << NOW << " LtePhyUe::doHandover - UE " << nodeId_ << " has completed handover to eNB " << masterId_ << "... " << endl;
     binder_->removeUeHandoverTriggered(nodeId_);
 
     // inform the UE's IP2lte module to forward held packets
@@ -355,7 +522,7 @@ void LtePhyUe::handleAirFrame(cMessage* msg)
     }
     connectedNodeId_ = masterId_;
     LteAirFrame* frame = check_and_cast<LteAirFrame*>(msg);
-    EV << "LtePhy: received new LteAirFrame with ID " << frame->getId() << " from channel" << endl;
+    EV_PHY << "LtePhy: received new LteAirFrame with ID " << frame->getId() << " from channel" << endl;
 
     int sourceId = binder_->getOmnetId(lteInfo->getSourceId());
     if(sourceId == 0 )
@@ -383,10 +550,10 @@ void LtePhyUe::handleAirFrame(cMessage* msg)
     // Check if the frame is for us ( MacNodeId matches )
     if (lteInfo->getDestId() != nodeId_)
     {
-        EV << "ERROR: Frame is not for us. Delete it." << endl;
-        EV << "Packet Type: " << phyFrameTypeToA((LtePhyFrameType)lteInfo->getFrameType()) << endl;
-        EV << "Frame MacNodeId: " << lteInfo->getDestId() << endl;
-        EV << "Local MacNodeId: " << nodeId_ << endl;
+        EV_PHY << "ERROR: Frame is not for us. Delete it." << endl;
+        EV_PHY << "Packet Type: " << phyFrameTypeToA((LtePhyFrameType)lteInfo->getFrameType()) << endl;
+        EV_PHY << "Frame MacNodeId: " << lteInfo->getDestId() << endl;
+        EV_PHY << "Local MacNodeId: " << nodeId_ << endl;
         delete lteInfo;
         delete frame;
         return;
@@ -401,9 +568,9 @@ void LtePhyUe::handleAirFrame(cMessage* msg)
          */
     if (lteInfo->getSourceId() != masterId_)
     {
-        EV << "WARNING: frame from an old master during handover: deleted " << endl;
-        EV << "Source MacNodeId: " << lteInfo->getSourceId() << endl;
-        EV << "Master MacNodeId: " << masterId_ << endl;
+        EV_PHY << "WARNING: frame from an old master during handover: deleted " << endl;
+        EV_PHY << "Source MacNodeId: " << lteInfo->getSourceId() << endl;
+        EV_PHY << "Master MacNodeId: " << masterId_ << endl;
         delete frame;
         return;
     }
@@ -424,13 +591,13 @@ void LtePhyUe::handleAirFrame(cMessage* msg)
     }
     // apply decider to received packet
     bool result = true;
-    RemoteSet r = lteInfo->getUserTxParams()->readAntennaSet();
+    const RemoteSet& r = lteInfo->getUserTxParams()->readAntennaSet();
     if (r.size() > 1)
     {
         // DAS
-        for (RemoteSet::iterator it = r.begin(); it != r.end(); it++)
+        for (RemoteSet::const_iterator it = r.begin(); it != r.end(); it++)
         {
-            EV << "LtePhy: Receiving Packet from antenna " << (*it) << "\n";
+            EV_PHY << "LtePhy: Receiving Packet from antenna " << (*it) << "\n";
 
             /*
              * On UE set the sender position
@@ -461,7 +628,7 @@ void LtePhyUe::handleAirFrame(cMessage* msg)
     else
         numAirFrameNotReceived_++;
 
-    EV << "Handled LteAirframe with ID " << frame->getId() << " with result "
+    EV_PHY << "Handled LteAirframe with ID " << frame->getId() << " with result "
        << ( result ? "RECEIVED" : "NOT RECEIVED" ) << endl;
 
     auto pkt = check_and_cast<inet::Packet *>(frame->decapsulate());
@@ -558,7 +725,7 @@ DasFilter* LtePhyUe::getDasFilter()
 void LtePhyUe::sendFeedback(LteFeedbackDoubleVector fbDl, LteFeedbackDoubleVector fbUl, FeedbackRequest req)
 {
     Enter_Method("SendFeedback");
-    EV << "LtePhyUe: feedback from Feedback Generator" << endl;
+    EV_PHY << "LtePhyUe: feedback from Feedback Generator" << endl;
 
     //Create a feedback packet
     auto fbPkt = makeShared<LteFeedbackPkt>();
@@ -596,11 +763,39 @@ void LtePhyUe::sendFeedback(LteFeedbackDoubleVector fbDl, LteFeedbackDoubleVecto
 //        cellInfo_->lambdaIncrease(nodeId_,1);
 //    }
     lastFeedback_ = NOW;
-    EV << "LtePhy: " << nodeTypeToA(nodeType_) << " with id "
+    EV_PHY << "LtePhy: " << nodeTypeToA(nodeType_) << " with id "
        << nodeId_ << " sending feedback to the air channel" << endl;
     sendUnicast(frame);
 }
 
+void LtePhyUe::sendDirectFeedback(const FeedbackRequest& req)
+{
+    Enter_Method_Silent("sendDirectFeedback");
+    EV_PHY << "LtePhyUe: direct feedback from Feedback Generator" << endl;
+
+    // the master might have left the simulation
+    OmnetId masterOmnetId = binder_->getOmnetId(masterId_);
+    if (masterOmnetId == 0)
+        return;
+    LtePhyEnb* masterPhy = check_and_cast<LtePhyEnb*>(
+        getSimulation()->getModule(masterOmnetId)->getSubmodule("lteNic")->getSubmodule("phy"));
+
+    // same control info as the one carried by the feedback airframe
+    UserControlInfo uinfo;
+    uinfo.setSourceId(nodeId_);
+    uinfo.setDestId(masterId_);
+    uinfo.setFrameType(FEEDBACKPKT);
+    uinfo.setIsCorruptible(false);
+    uinfo.feedbackReq = req;
+    uinfo.setDirection(UL);
+    uinfo.setTxPower(txPower_);
+    uinfo.setD2dTxPower(getTxPwr(D2D));
+    uinfo.setCoord(getRadioPosition());
+
+    lastFeedback_ = NOW;
+    masterPhy->handleDirectFeedback(&uinfo);
+}
+
 void LtePhyUe::finish()
 {
     if (getSimulation()->getSimulationStage() != CTX_FINISH)
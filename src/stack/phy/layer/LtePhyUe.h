@@ -73,6 +73,44 @@ class SIMULTE_API LtePhyUe : public LtePhyBase
      */
     bool enableHandover_;
 
+    /**
+     * Periodic L3 handover measurements (enabled if handoverMeasurementPeriod_ > 0).
+     * At each period the UE measures its serving cell and the eNBs within
+     * handoverMeasurementRange_ (taken from the binder's spatial index), and
+     * handover broadcasts are only used for the DAS reporting set.
+     */
+    struct L3Measurement
+    {
+        /// L3-filtered RSSI
+        double rssi;
+        /// Measurement round of the last update
+        unsigned long round;
+    };
+
+    /** Self message to trigger a measurement round */
+    omnetpp::cMessage *handoverMeasurement_;
+    double handoverMeasurementPeriod_;
+    /** Range of the measured cells (all the eNBs if not positive) */
+    double handoverMeasurementRange_;
+    /** Weight of the new sample in the L3 filter */
+    double l3FilterWeight_;
+    /** Neighbour measurements are reused while the UE moves less than this... */
+    double measurementMinDistance_;
+    /** ...and the serving cell RSSI changes less than this */
+    double measurementMinRssiChange_;
+    /** Position and serving cell RSSI at the last neighbour measurement */
+    inet::Coord lastMeasurementPos_;
+    double lastMeasurementMasterRssi_;
+    bool neighboursMeasured_;
+    unsigned long measurementRound_;
+    /** L3-filtered RSSI of the measured cells */
+    std::map<MacNodeId, L3Measurement> l3Rssi_;
+    /** Cells measured at the last neighbour measurement */
+    std::vector<EnbInfo*> measuredCells_;
+    /** Fictitious broadcast used to compute the RSSI of a cell */
+    LteAirFrame* measurementFrame_;
+    UserControlInfo* measurementInfo_;
+
     /**
      * Pointer to the DAS Filter: used to call das function
      * when receiving broadcasts and to retrieve physical
@@ -109,6 +147,19 @@ class SIMULTE_API LtePhyUe : public LtePhyBase
 
     void handoverHandler(LteAirFrame* frame, UserControlInfo* lteInfo);
 
+    /**
+     * Updates the handover candidate with the RSSI received from a cell
+     */
+    void evaluateHandoverRssi(MacNodeId cellId, double rssi);
+
+    /**
+     * Runs a periodic measurement round and evaluates the handover
+     */
+    void doHandoverMeasurement();
+    // returns false if the cell cannot be resolved
+    bool measureRssi(MacNodeId cellId, double& rssi);
+    double filterRssi(MacNodeId cellId, double rssi);
+
     void deleteOldBuffers(MacNodeId masterId);
 
     virtual void triggerHandover();
@@ -122,6 +173,12 @@ class SIMULTE_API LtePhyUe : public LtePhyBase
      * Send Feedback, called by feedback generator in DL
      */
     virtual void sendFeedback(LteFeedbackDoubleVector fbDl, LteFeedbackDoubleVector fbUl, FeedbackRequest req);
+    /**
+     * Send ideal feedback through the direct channel of the master:
+     * the master's PHY computes it and stores it into its AMC at once.
+     * Called by feedback generator in DL when directFeedback is enabled
+     */
+    void sendDirectFeedback(const FeedbackRequest& req);
     MacNodeId getMasterId() const
     {
         return masterId_;
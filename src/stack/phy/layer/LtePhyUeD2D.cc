@@ -83,7 +83,7 @@ void LtePhyUeD2D::handleAirFrame(cMessage* msg)
     }
     connectedNodeId_ = masterId_;
     LteAirFrame* frame = check_and_cast<LteAirFrame*>(msg);
-    EV << "LtePhyUeD2D: received new LteAirFrame with ID " << frame->getId() << " from channel" << endl;
+    EV_PHY << "LtePhyUeD2D: received new LteAirFrame with ID " << frame->getId() << " from channel" << endl;
 
     int sourceId = binder_->getOmnetId(lteInfo->getSourceId());
     if(sourceId == 0 )
@@ -111,10 +111,10 @@ void LtePhyUeD2D::handleAirFrame(cMessage* msg)
     // Check if the frame is for us ( MacNodeId matches or - if this is a multicast communication - enrolled in multicast group)
     if (lteInfo->getDestId() != nodeId_ && !(binder_->isInMulticastGroup(nodeId_, lteInfo->getMulticastGroupId())))
     {
-        EV << "ERROR: Frame is not for us. Delete it." << endl;
-        EV << "Packet Type: " << phyFrameTypeToA((LtePhyFrameType)lteInfo->getFrameType()) << endl;
-        EV << "Frame MacNodeId: " << lteInfo->getDestId() << endl;
-        EV << "Local MacNodeId: " << nodeId_ << endl;
+        EV_PHY << "ERROR: Frame is not for us. Delete it." << endl;
+        EV_PHY << "Packet Type: " << phyFrameTypeToA((LtePhyFrameType)lteInfo->getFrameType()) << endl;
+        EV_PHY << "Frame MacNodeId: " << lteInfo->getDestId() << endl;
+        EV_PHY << "Local MacNodeId: " << nodeId_ << endl;
         delete lteInfo;
         delete frame;
         return;
@@ -170,7 +170,7 @@ void LtePhyUeD2D::handleAirFrame(cMessage* msg)
         // DAS
         for (RemoteSet::iterator it = r.begin(); it != r.end(); it++)
         {
-            EV << "LtePhyUeD2D: Receiving Packet from antenna " << (*it) << endl;
+            EV_PHY << "LtePhyUeD2D: Receiving Packet from antenna " << (*it) << endl;
 
             /*
              * On UE set the sender position
@@ -201,7 +201,7 @@ void LtePhyUeD2D::handleAirFrame(cMessage* msg)
     else
         numAirFrameNotReceived_++;
 
-    EV << "Handled LteAirframe with ID " << frame->getId() << " with result "
+    EV_PHY << "Handled LteAirframe with ID " << frame->getId() << " with result "
        << ( result ? "RECEIVED" : "NOT RECEIVED" ) << endl;
 
     auto pkt = check_and_cast<inet::Packet *>(frame->decapsulate());
@@ -278,7 +278,7 @@ void LtePhyUeD2D::handleUpperMessage(cMessage* msg)
             emit(averageCqiD2D_, cqi);
     }
 
-    EV << NOW << " LtePhyUeD2D::handleUpperMessage - message from stack" << endl;
+    EV_PHY << NOW << " LtePhyUeD2D::handleUpperMessage - message from stack" << endl;
     LteAirFrame* frame = nullptr;
 
     if (lteInfo->getFrameType() == HARQPKT || lteInfo->getFrameType() == GRANTPKT || lteInfo->getFrameType() == RACPKT)
@@ -304,7 +304,7 @@ void LtePhyUeD2D::handleUpperMessage(cMessage* msg)
     lteInfo->setD2dTxPower(d2dTxPower_);
     frame->setControlInfo(lteInfo.get()->dup());
 
-    EV << "LtePhyUeD2D::handleUpperMessage - " << nodeTypeToA(nodeType_) << " with id " << nodeId_
+    EV_PHY << "LtePhyUeD2D::handleUpperMessage - " << nodeTypeToA(nodeType_) << " with id " << nodeId_
        << " sending message to the air channel. Dest=" << lteInfo->getDestId() << endl;
 
     // if this is a multicast/broadcast connection, send the frame to all neighbors in the hearing range
@@ -353,13 +353,13 @@ void LtePhyUeD2D::storeAirFrame(LteAirFrame* newFrame)
             }
         }
         rsrpMean = sum / allocatedRbs;
-        EV << "LtePhyUeD2D::storeAirFrame - Average RSRP from node " << newInfo->getSourceId() << ": " << rsrpMean << endl;
+        EV_PHY << "LtePhyUeD2D::storeAirFrame - Average RSRP from node " << newInfo->getSourceId() << ": " << rsrpMean << endl;
     }
     else  // distance
     {
         Coord newSenderCoord = newInfo->getCoord();
         distance = myCoord.distance(newSenderCoord);
-        EV << NOW << " LtePhyUeD2D::storeAirFrame - Distance from node " << newInfo->getSourceId() << ": " << distance << endl;
+        EV_PHY << NOW << " LtePhyUeD2D::storeAirFrame - Distance from node " << newInfo->getSourceId() << ": " << distance << endl;
     }
 
     if (!d2dReceivedFrames_.empty())
@@ -367,7 +367,7 @@ void LtePhyUeD2D::storeAirFrame(LteAirFrame* newFrame)
         LteAirFrame* prevFrame = d2dReceivedFrames_.front();
         if (!useRsrp && distance < nearestDistance_)
         {
-            EV << "[ < nearestDistance: " << nearestDistance_ << "]" << endl;
+            EV_PHY << "[ < nearestDistance: " << nearestDistance_ << "]" << endl;
 
             // remove the previous frame
             d2dReceivedFrames_.pop_back();
@@ -378,7 +378,7 @@ void LtePhyUeD2D::storeAirFrame(LteAirFrame* newFrame)
         }
         else if (rsrpMean > bestRsrpMean_)
         {
-            EV << "[ > bestRsrp: " << bestRsrpMean_ << "]" << endl;
+            EV_PHY << "[ > bestRsrp: " << bestRsrpMean_ << "]" << endl;
 
             // remove the previous frame
             d2dReceivedFrames_.pop_back();
@@ -420,7 +420,7 @@ LteAirFrame* LtePhyUeD2D::extractAirFrame()
 
 void LtePhyUeD2D::decodeAirFrame(LteAirFrame* frame, UserControlInfo* lteInfo)
 {
-    EV << NOW << " LtePhyUeD2D::decodeAirFrame - Start decoding..." << endl;
+    EV_PHY << NOW << " LtePhyUeD2D::decodeAirFrame - Start decoding..." << endl;
 
     // apply decider to received packet
     bool result = true;
@@ -431,7 +431,7 @@ void LtePhyUeD2D::decodeAirFrame(LteAirFrame* frame, UserControlInfo* lteInfo)
         // DAS
         for (RemoteSet::iterator it = r.begin(); it != r.end(); it++)
         {
-            EV << "LtePhyUeD2D::decodeAirFrame: Receiving Packet from antenna " << (*it) << endl;
+            EV_PHY << "LtePhyUeD2D::decodeAirFrame: Receiving Packet from antenna " << (*it) << endl;
 
             /*
              * On UE set the sender position
@@ -465,7 +465,7 @@ void LtePhyUeD2D::decodeAirFrame(LteAirFrame* frame, UserControlInfo* lteInfo)
     else
         numAirFrameNotReceived_++;
 
-    EV << "Handled LteAirframe with ID " << frame->getId() << " with result "
+    EV_PHY << "Handled LteAirframe with ID " << frame->getId() << " with result "
        << ( result ? "RECEIVED" : "NOT RECEIVED" ) << endl;
 
     auto pkt = check_and_cast<inet::Packet *>(frame->decapsulate());
@@ -489,7 +489,7 @@ void LtePhyUeD2D::decodeAirFrame(LteAirFrame* frame, UserControlInfo* lteInfo)
 void LtePhyUeD2D::sendFeedback(LteFeedbackDoubleVector fbDl, LteFeedbackDoubleVector fbUl, FeedbackRequest req)
 {
     Enter_Method("SendFeedback");
-    EV << "LtePhyUeD2D: feedback from Feedback Generator" << endl;
+    EV_PHY << "LtePhyUeD2D: feedback from Feedback Generator" << endl;
 
     //Create a feedback packet
     auto fbPkt = makeShared<LteFeedbackPkt>();
@@ -528,7 +528,7 @@ void LtePhyUeD2D::sendFeedback(LteFeedbackDoubleVector fbDl, LteFeedbackDoubleVe
 //        cellInfo_->lambdaIncrease(nodeId_,1);
 //    }
     lastFeedback_ = NOW;
-    EV << "LtePhy: " << nodeTypeToA(nodeType_) << " with id "
+    EV_PHY << "LtePhy: " << nodeTypeToA(nodeType_) << " with id "
        << nodeId_ << " sending feedback to the air channel" << endl;
     sendUnicast(frame);
 }
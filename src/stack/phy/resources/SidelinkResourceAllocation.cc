@@ -14,6 +14,7 @@
 #include <unordered_map>
 #include "common/LteControlInfo.h"
 #include "stack/mac/configuration/SidelinkConfiguration.h"
+#include "common/LteProfiler.h"
 
 Define_Module(SidelinkResourceAllocation);
 
@@ -32,9 +33,10 @@ SidelinkResourceAllocation::~SidelinkResourceAllocation()
 }
 void SidelinkResourceAllocation::handleMessage(cMessage* msg)
 {
+    LTE_PROFILE_SCOPE(this, "handleMessage");
     if (msg->isSelfMessage())
     {
-        EV<<"SidelinkResourceAllocation::handleMessage()"<<endl;
+        EV_RES<<"SidelinkResourceAllocation::handleMessage()"<<endl;
         handleSelfMessage(msg);
 
         //updateCBR();
@@ -45,7 +47,7 @@ void SidelinkResourceAllocation::initialize(int stage)
 
     if (stage == inet::INITSTAGE_LOCAL)
     {
-        EV<<"SidelinkResourceAllocation::initialize, stage: "<<stage<<endl;
+        EV_RES<<"SidelinkResourceAllocation::initialize, stage: "<<stage<<endl;
         adjacencyPSCCHPSSCH_ = par("adjacencyPSCCHPSSCH");
         pStep_ = par("pStep");
         selectionWindowStartingSubframe_ = par("selectionWindowStartingSubframe");
@@ -212,14 +214,14 @@ void SidelinkResourceAllocation::handleSelfMessage(cMessage *msg)
     else if (msg->isName("SLSS"))
     {
         //Start sidelink synchronization
-        EV<<"SLSS self"<<endl;
+        EV_RES<<"SLSS self"<<endl;
         sidelinkSynchronization();
     }
     else if (msg->isName("SIB21PreConfigured"))
     {
 
         // LtePhyUe::handleSelfMessage(msg);
-        EV<<"SidelinkResourceAllocation::handleSelfMessage() SIB 21"<<endl;
+        EV_RES<<"SidelinkResourceAllocation::handleSelfMessage() SIB 21"<<endl;
         //initialiseSensingWindow();
         //updateSubframe();
         //updateCBR();
@@ -233,7 +235,7 @@ void SidelinkResourceAllocation::handleSelfMessage(cMessage *msg)
 
 void SidelinkResourceAllocation::handleUpperMessage(cMessage* msg)
 {
-    EV<<"SidelinkResourceAllocation::handleUpperMessage: "<<msg->getName()<<endl;
+    EV_RES<<"SidelinkResourceAllocation::handleUpperMessage: "<<msg->getName()<<endl;
     UserControlInfo* lteInfo = check_and_cast<UserControlInfo*>(msg->removeControlInfo());
 
     if (msg->isName("LteMode4Grant") )
@@ -254,7 +256,7 @@ void SidelinkResourceAllocation::handleUpperMessage(cMessage* msg)
                 sensingWindow_[sensingWindowFront_][i]->setSensed(false);
             }*/
 
-        EV<<"Number of previously granted blocks: "<<getAllocatedBlocksPrevious()<<"previous cResel: "<<getReselectionCounter()<<endl;
+        EV_RES<<"Number of previously granted blocks: "<<getAllocatedBlocksPrevious()<<"previous cResel: "<<getReselectionCounter()<<endl;
 
         //Mode 4
         if (nodeType_ ==UE)
@@ -272,7 +274,7 @@ void SidelinkResourceAllocation::handleUpperMessage(cMessage* msg)
                 {
                     //Use previous subchannels for the current subframes
                     RBIndicesData =  getPreviousSubchannelsData();
-                    EV<<"Using previously allocated subchannels for data and SCI"<<  RBIndicesData.size()<<endl;
+                    EV_RES<<"Using previously allocated subchannels for data and SCI"<<  RBIndicesData.size()<<endl;
                     //determine the subframe
                     computeCSRs(grant,nodeType_);
 
@@ -280,7 +282,7 @@ void SidelinkResourceAllocation::handleUpperMessage(cMessage* msg)
                 }
                 if (numberPRBNeeded>getAllocatedBlocksPrevious()-2) //" RBs for SCI
                 {
-                    EV<<"Data size does not fit into previous allocation, need for re-allocation"<<endl;
+                    EV_RES<<"Data size does not fit into previous allocation, need for re-allocation"<<endl;
 
                     //Reset counter and previous allocations
                     cResel=0;
@@ -295,7 +297,7 @@ void SidelinkResourceAllocation::handleUpperMessage(cMessage* msg)
               if (getAllocatedBlocksPrevious() == 0 || getReselectionCounter()==0)
               {
                   // Generate a vector of CSRs and send it to the MAC layer
-                  EV<<"Calling computeSCRs()"<<grant->getTransmitBlockSize()<<endl;
+                  EV_RES<<"Calling computeSCRs()"<<grant->getTransmitBlockSize()<<endl;
                   computeCSRs(grant,nodeType_);
                   //delete lteInfo;
                   //delete grant;
@@ -310,7 +312,7 @@ void SidelinkResourceAllocation::handleUpperMessage(cMessage* msg)
         //Mode 3
         if (nodeType_==ENODEB)
         {
-            EV<<"Sidelink resource allocation according to mode 3"<<endl;
+            EV_RES<<"Sidelink resource allocation according to mode 3"<<endl;
             computeCSRs(grant,nodeType_);
             return;
         }
@@ -333,7 +335,7 @@ void SidelinkResourceAllocation::handleUpperMessage(cMessage* msg)
 
 LteAirFrame* SidelinkResourceAllocation::createSCIMessage(cMessage* msg, LteSidelinkGrant* grant)
 {
-    EV << NOW << " SidelinkResourceAllocation::createSCIMessage - Start creating SCI..." << endl;
+    EV_RES << NOW << " SidelinkResourceAllocation::createSCIMessage - Start creating SCI..." << endl;
 
     SidelinkControlInformation* sci = new SidelinkControlInformation("SCI Message");
 
@@ -380,9 +382,9 @@ LteAirFrame* SidelinkResourceAllocation::createSCIMessage(cMessage* msg, LteSide
      *         RIV = numSubchannels(numSubchannels-SubchannelLength+1) + (numSubchannels-1-subchannelIndex)
      */
 
-    EV<<"numSubchannels_ : "<<numSubchannels_<<endl;
-    EV<<"Lch: "<<grant->getNumSubchannels()<<endl; // SCI+TB size e.g. 9PRBs means two contiguous subchannels (write the logic )
-    EV<<"starting subchannel: "<<grant->getStartingSubchannel()<<endl;
+    EV_RES<<"numSubchannels_ : "<<numSubchannels_<<endl;
+    EV_RES<<"Lch: "<<grant->getNumSubchannels()<<endl; // SCI+TB size e.g. 9PRBs means two contiguous subchannels (write the logic )
+    EV_RES<<"starting subchannel: "<<grant->getStartingSubchannel()<<endl;
 
     unsigned  int riv;
     //
@@ -434,12 +436,12 @@ LteAirFrame* SidelinkResourceAllocation::createSCIMessage(cMessage* msg, LteSide
     sci->setBitLength(32);
 
     //Print all SCI values
-    EV<<"Priority: "<<grant->getSpsPriority()<<endl;
-    EV<<"resource Reservation Interval: "<<(grant->getPeriod()/100)<<endl;
-    EV<<"Frequency resource location of initial transmission and re-transmission (RIV): "<<riv<<endl;
-    EV<<"Subframe gap: "<<grant->getTimeGapTransRetrans()<<endl;
-    EV<<"Modulation and Coding Scheme: "<<grant->getMcs()<<endl;
-    EV<<"Re-transmission index: "<<sci->getRetransmissionIndex()<<endl;
+    EV_RES<<"Priority: "<<grant->getSpsPriority()<<endl;
+    EV_RES<<"resource Reservation Interval: "<<(grant->getPeriod()/100)<<endl;
+    EV_RES<<"Frequency resource location of initial transmission and re-transmission (RIV): "<<riv<<endl;
+    EV_RES<<"Subframe gap: "<<grant->getTimeGapTransRetrans()<<endl;
+    EV_RES<<"Modulation and Coding Scheme: "<<grant->getMcs()<<endl;
+    EV_RES<<"Re-transmission index: "<<sci->getRetransmissionIndex()<<endl;
     UserControlInfo* lteInfo = new UserControlInfo();
     lteInfo->setGrantStartTime(grant->getStartTime());
     LteAirFrame* sciFrame = prepareAirFrame(sci, lteInfo);
@@ -450,7 +452,7 @@ LteAirFrame* SidelinkResourceAllocation::createSCIMessage(cMessage* msg, LteSide
 LteAirFrame* SidelinkResourceAllocation::prepareAirFrame(cMessage* msg, UserControlInfo* lteInfo){
     // Helper function to prepare airframe for sending.
 
-    EV<<"SidelinkResourceAllocation::prepareAirFrame"<<nodeId_<<endl;
+    EV_RES<<"SidelinkResourceAllocation::prepareAirFrame"<<nodeId_<<endl;
     LteAirFrame* frame = new LteAirFrame("SCIframe");
     frame->encapsulate(check_and_cast<cPacket*>(msg));
     frame->setSchedulingPriority(10); //Airframe priority = 10 as defined in LtePhyBase
@@ -481,14 +483,14 @@ std::vector<int> SidelinkResourceAllocation::getallocationTBIndex(int bitLength,
 
     int startSubChTB = subChSCI.at(1)+1;
     int beta = 2;
-    EV<<"startSubChTB"<<subChSCI[0]<<" "<<subChSCI[1]<<endl;
+    EV_RES<<"startSubChTB"<<subChSCI[0]<<" "<<subChSCI[1]<<endl;
 
-    EV<<" numberPRBTransmitBlock: "<< numberPRBTransmitBlock<<endl;
+    EV_RES<<" numberPRBTransmitBlock: "<< numberPRBTransmitBlock<<endl;
     for (int j=0; j<numberPRBTransmitBlock; j++)
     {
 
 
-        EV<<"TB indices: "<<startSubChTB+j<<endl;
+        EV_RES<<"TB indices: "<<startSubChTB+j<<endl;
         allocatedPRBTBIndex.push_back(startSubChTB+j);
 
         if (!adjacencyPSCCHPSSCH_)
@@ -517,7 +519,7 @@ std::vector<int>  SidelinkResourceAllocation::getallocationSciIndex(int subChRBS
     //Allocate twp PRBS for SCI
     for (int j=0; j<2; j++)
     {
-        EV<<"SCI indices: "<<subChRBStart_ + j<<endl;
+        EV_RES<<"SCI indices: "<<subChRBStart_ + j<<endl;
         allocatedPRBSciIndex.push_back(subChRBStart_ + j);
     }
 
@@ -525,6 +527,7 @@ std::vector<int>  SidelinkResourceAllocation::getallocationSciIndex(int subChRBS
 }
 
 void SidelinkResourceAllocation::computeCSRs(LteSidelinkGrant* grant, LteNodeType nodeType_) {
+    LTE_PROFILE_SCOPE(this, "computeCSRs");
     candidateSubframes.clear();
 
     if ((nodeType_==ENODEB) || (getAllocatedBlocksPrevious() == 0 && getReselectionCounter()==0 && nodeType_ == UE))
@@ -536,10 +539,10 @@ void SidelinkResourceAllocation::computeCSRs(LteSidelinkGrant* grant, LteNodeTyp
         //Allocating subchannels
         int cResel = grant->getResourceReselectionCounter();
         setReselectionCounter(cResel);
-        EV<<"Retrieve cResel: "<<getReselectionCounter()<<endl;
+        EV_RES<<"Retrieve cResel: "<<getReselectionCounter()<<endl;
         subChRBStart_ = intuniform(0,std::ceil((numSubchannels_*subchannelSize_)/2)-1);
 
-        EV<<"Start of subchannel: "<<subChRBStart_<<endl;
+        EV_RES<<"Start of subchannel: "<<subChRBStart_<<endl;
 
         RBIndicesSCI=getallocationSciIndex(subChRBStart_);
         RBIndicesData=getallocationTBIndex(grant->getTransmitBlockSize(),  RBIndicesSCI);
@@ -550,18 +553,18 @@ void SidelinkResourceAllocation::computeCSRs(LteSidelinkGrant* grant, LteNodeTyp
 
 
 
-    EV<<"Allocating CSRs for : "<<nodeTypeToA(nodeType_)<<endl;
+    EV_RES<<"Allocating CSRs for : "<<nodeTypeToA(nodeType_)<<endl;
 
 
     int totalPRBsPerSubframe = 0;
     totalPRBsPerSubframe = RBIndicesSCI.size()+RBIndicesData.size();
     grant->setTotalGrantedBlocks(totalPRBsPerSubframe);
-    EV<<"Total number of RBs for SCI+Data: "<<totalPRBsPerSubframe<<endl;
+    EV_RES<<"Total number of RBs for SCI+Data: "<<totalPRBsPerSubframe<<endl;
 
     binder_ = getBinder();
     std::map<MacNodeId,inet::Coord> broadcastUeMap = binder_->getBroadcastUeInfo();
 
-    EV<<"broadcastUeMap: "<<broadcastUeMap.size()<<endl;
+    EV_RES<<"broadcastUeMap: "<<broadcastUeMap.size()<<endl;
 
     std::map<MacNodeId,inet::Coord>::iterator itb = broadcastUeMap.begin();
 
@@ -571,11 +574,11 @@ void SidelinkResourceAllocation::computeCSRs(LteSidelinkGrant* grant, LteNodeTyp
     int endSubFrame = startSubFrame+maxLatency;
     int selectionWindow =  maxLatency - startSubFrame;
     int possibleCSRSSelWindow;
-    EV<<"Start subframe: "<<startSubFrame<<endl;
-    EV<<"End subframe: "<<endSubFrame<<endl;
+    EV_RES<<"Start subframe: "<<startSubFrame<<endl;
+    EV_RES<<"End subframe: "<<endSubFrame<<endl;
 
     //Discarding subframes where sync information appears - PSSS,SSSS,DMRS
-    EV<<"Next SLSS: "<<nextSLSS<<endl;
+    EV_RES<<"Next SLSS: "<<nextSLSS<<endl;
     simtime_t selStartTime;
     simtime_t selEndTime;
     //Converting to ms
@@ -594,11 +597,11 @@ void SidelinkResourceAllocation::computeCSRs(LteSidelinkGrant* grant, LteNodeTyp
     }
 
     tSync = (nextSLSS+0.001-NOW).dbl();  //it takes one TTI for SLSS acknowledgement
-    EV<<"Synchronization latency: "<<tSync<<endl;
+    EV_RES<<"Synchronization latency: "<<tSync<<endl;
     emit(syncLatency,tSync);
 
-    EV<<"selectionWindow start time:  "<<selStartTime<<endl;
-    EV<<"selectionWindow end time:  "<<selEndTime<<endl;
+    EV_RES<<"selectionWindow start time:  "<<selStartTime<<endl;
+    EV_RES<<"selectionWindow end time:  "<<selEndTime<<endl;
 
     emit(configurationLatency,0.004);
 
@@ -607,7 +610,7 @@ void SidelinkResourceAllocation::computeCSRs(LteSidelinkGrant* grant, LteNodeTyp
         candidateSubframes.push_back(k);
 
     }
-    EV<<"Number of candidate subframes: "<< candidateSubframes.size()<<endl;
+    EV_RES<<"Number of candidate subframes: "<< candidateSubframes.size()<<endl;
     int candidateSubframeInitial = 0;
     candidateSubframeInitial =candidateSubframes.size();
 
@@ -625,7 +628,7 @@ void SidelinkResourceAllocation::computeCSRs(LteSidelinkGrant* grant, LteNodeTyp
         int randomIndexInitial = rand() % candidateSubframeInitial;
         simtime_t startFirstTransmissionInitial = candidateSubframes[randomIndexInitial];
 
-        EV<<"First transmission initial: "<<startFirstTransmissionInitial<<endl;
+        EV_RES<<"First transmission initial: "<<startFirstTransmissionInitial<<endl;
 
         std::vector<std::pair<MacNodeId,double>> camueinfo = binder_->getCamUeinfo();
         std::vector<double> eraseSubframe ;
@@ -648,7 +651,7 @@ void SidelinkResourceAllocation::computeCSRs(LteSidelinkGrant* grant, LteNodeTyp
                             eraseSubframeTime = (y+j*Prsvp_TX_prime);
                             if (eraseSubframeTime >= selStartTime.dbl() && eraseSubframeTime <=selEndTime.dbl())
                             {
-                                EV<<"erase subframe: "<<(y+j*Prsvp_TX)<<endl;
+                                EV_RES<<"erase subframe: "<<(y+j*Prsvp_TX)<<endl;
 
                                 if ((y+j*Prsvp_TX)==startFirstTransmissionInitial.dbl())
                                 {
@@ -669,10 +672,10 @@ void SidelinkResourceAllocation::computeCSRs(LteSidelinkGrant* grant, LteNodeTyp
         //Find the subframes to be discarded
         for (auto iter : eraseSubframe)
         {
-            EV<<"iter: "<<iter<<endl;
+            EV_RES<<"iter: "<<iter<<endl;
             std::vector<double>::iterator it = std::find(candidateSubframes.begin(), candidateSubframes.end(), iter);
             int index = std::distance(candidateSubframes.begin(), it);
-            EV<<"Erase index: "<<index<<endl;
+            EV_RES<<"Erase index: "<<index<<endl;
 
 
             if(it!=candidateSubframes.end())
@@ -705,32 +708,32 @@ void SidelinkResourceAllocation::computeCSRs(LteSidelinkGrant* grant, LteNodeTyp
             {
                 pcCountMode4 = pcCountMode4+1;
                 emit(pcMode4,pcCountMode4);
-                EV<<"Duplicates: "<< eraseSubframe[k] << " and "<<eraseSubframe[k+1]<<endl;
+                EV_RES<<"Duplicates: "<< eraseSubframe[k] << " and "<<eraseSubframe[k+1]<<endl;
             }
 
         }
 
         grant->setTotalGrantedBlocks(RBIndicesSCI.size()+RBIndicesData.size());
         setPreviousSubchannelsData(RBIndicesData);
-        EV<<"Set total granted blocks: "<<grant->getTotalGrantedBlocks()<<endl;
-        EV<<"First transmission: "<<startFirstTransmission<<endl;
+        EV_RES<<"Set total granted blocks: "<<grant->getTotalGrantedBlocks()<<endl;
+        EV_RES<<"First transmission: "<<startFirstTransmission<<endl;
         grant->setStartTime(startFirstTransmission);
         FirstTransmission = startFirstTransmission.dbl();
         setFirstTransmissionPrevious(FirstTransmission);
         binder_->updatePeriodicCamTransmissions(nodeId_,startFirstTransmission.dbl());
 
-        EV<<"Resource allocation latency: "<<(startFirstTransmission-selStartTime).dbl()<<endl;
+        EV_RES<<"Resource allocation latency: "<<(startFirstTransmission-selStartTime).dbl()<<endl;
         emit(resourceAllocationLatency,(startFirstTransmission-selStartTime).dbl());
 
         //throw cRuntimeError("computeCSRs");
-        EV<<"Erase subframe size: "<< eraseSubframe.size()<<endl;
-        EV<<"candidateSubframes size initial: "<<candidateSubframeInitial<<endl;
-        EV<<"candidateSubframes size limit: "<<0.8*candidateSubframeInitial<<endl;
+        EV_RES<<"Erase subframe size: "<< eraseSubframe.size()<<endl;
+        EV_RES<<"candidateSubframes size initial: "<<candidateSubframeInitial<<endl;
+        EV_RES<<"candidateSubframes size limit: "<<0.8*candidateSubframeInitial<<endl;
         if(eraseSubframe.size()>(0.8*candidateSubframeInitial))
         {
             //RSRP
 
-            EV<<"Filtering of erased subframes needed: "<<endl;
+            EV_RES<<"Filtering of erased subframes needed: "<<endl;
             //RSSI
             for (int k=0; k<eraseSubframe.size();k++)
             {
@@ -750,7 +753,7 @@ void SidelinkResourceAllocation::computeCSRs(LteSidelinkGrant* grant, LteNodeTyp
     {
         FirstTransmission = getFirstTransmissionPrevious()+0.1;//increment by RRI for subsequent packet transmissions
         setFirstTransmissionPrevious(FirstTransmission);
-        EV<<"First transmission subsequent: "<< FirstTransmission<<endl;
+        EV_RES<<"First transmission subsequent: "<< FirstTransmission<<endl;
         binder_->updatePeriodicCamTransmissions(nodeId_, FirstTransmission);
         grant->setStartTime( FirstTransmission);
 
@@ -769,7 +772,7 @@ void SidelinkResourceAllocation::computeCSRs(LteSidelinkGrant* grant, LteNodeTyp
 std::vector<std::tuple<double, int, double>> SidelinkResourceAllocation::selectBestRSSIs(std::vector<double> subframes, LteSidelinkGrant* &grant, double subFrame)
 {
     subch = new Subchannel(numSubchannels_,subFrame);
-    EV << NOW << " LtePhyVUeMode4::selectBestRSSIs - Selecting best CSRs from possible CSRs..." << endl;
+    EV_RES << NOW << " LtePhyVUeMode4::selectBestRSSIs - Selecting best CSRs from possible CSRs..." << endl;
     int decrease = pStep_;
     if (grant->getPeriod() < 100)
     {
@@ -791,7 +794,7 @@ std::vector<std::tuple<double, int, double>> SidelinkResourceAllocation::selectB
     LtePhyBase* phy=check_and_cast<LtePhyBase*>(getParentModule()->getSubmodule("phy"));
     /*std::vector<std::vector<std::pair<Band,double>>> rssiD2DPeers=phy->getRSSIVector();
 
-    EV<<"RSSI vector size: "<<rssiD2DPeers.size()<<endl;
+    EV_RES<<"RSSI vector size: "<<rssiD2DPeers.size()<<endl;
     double averageRSSI = 0.0;
     for(int k=0; k<rssiD2DPeers.size();k++)
     {
@@ -821,7 +824,7 @@ void SidelinkResourceAllocation::storeAirFrame(LteAirFrame* frame, UserControlIn
     // implements the capture effect
     // store the frame received from the nearest transmitter
 
-    EV<<""<<endl;
+    EV_RES<<""<<endl;
     // Need to be able to figure out which subchannel is associated to the Rbs in this case
     if (lteInfo->getFrameType() == SCIPKT){
         sciFrames_.push_back(frame);
@@ -835,14 +838,14 @@ void SidelinkResourceAllocation::storeAirFrame(LteAirFrame* frame, UserControlIn
 
 void SidelinkResourceAllocation::decodeAirFrame(LteAirFrame* frame, UserControlInfo* lteInfo)
 {
-    EV << NOW << " SidelinkResourceAllocation::decodeAirFrame - Start decoding..." << endl;
+    EV_RES << NOW << " SidelinkResourceAllocation::decodeAirFrame - Start decoding..." << endl;
 
 
 }
 
 std::tuple<int,int> SidelinkResourceAllocation::decodeRivValue(SidelinkControlInformation* sci, UserControlInfo* sciInfo)
 {
-    EV << NOW << " SidelinkResourceAllocation::decodeRivValue - Decoding RIV value of SCI allows correct placement in sensing window..." << endl;
+    EV_RES << NOW << " SidelinkResourceAllocation::decodeRivValue - Decoding RIV value of SCI allows correct placement in sensing window..." << endl;
     int subchannelIndex = 0;
     int lengthInSubchannels = numSubchannels_;
     return std::make_tuple(subchannelIndex, lengthInSubchannels);
@@ -851,15 +854,15 @@ std::tuple<int,int> SidelinkResourceAllocation::decodeRivValue(SidelinkControlIn
 void  SidelinkResourceAllocation::initialiseSensingWindow()
 {
     Enter_Method("initialiseSensingWindow()");
-    EV << NOW << " SidelinkResourceAllocation::initialiseSensingWindow - creating subframes to be added to sensingWindow..." << endl;
+    EV_RES << NOW << " SidelinkResourceAllocation::initialiseSensingWindow - creating subframes to be added to sensingWindow..." << endl;
 
     simtime_t subframeTime = NOW - TTI;
 
-    //EV<<"subframeTime: "<<subframeTime<<endl;
+    //EV_RES<<"subframeTime: "<<subframeTime<<endl;
     // Reserve the full size of the sensing window (might improve efficiency).
     sensingWindow_.reserve(10*pStep_);
 
-    EV<<"Reserve: "<<10*pStep_<< "sensing window size: "<<sensingWindow_.size()<<endl;
+    EV_RES<<"Reserve: "<<10*pStep_<< "sensing window size: "<<sensingWindow_.size()<<endl;
     Band band = 0;
 
     while(sensingWindow_.size() < 10*pStep_)
@@ -897,8 +900,8 @@ void  SidelinkResourceAllocation::initialiseSensingWindow()
         subframeTime += TTI;
     }
 
-    EV<<"Number of resource elements inside sensing window: "<<subframe.size()<<" "<<"Sensing window size: "<<sensingWindow_.size()<<endl;
-    EV<<"Number of subchannels: "<<numSubchannels_<<endl;
+    EV_RES<<"Number of resource elements inside sensing window: "<<subframe.size()<<" "<<"Sensing window size: "<<sensingWindow_.size()<<endl;
+    EV_RES<<"Number of subchannels: "<<numSubchannels_<<endl;
 
 }
 
@@ -906,7 +909,7 @@ simtime_t SidelinkResourceAllocation::sidelinkSynchronization()
 {
     Enter_Method("sidelinkSynchronization()");
     //Synchronization messages are scheduled every 160ms
-    EV<<"Synchronization subframes"<<endl;
+    EV_RES<<"Synchronization subframes"<<endl;
     slsync = new  cMessage("SLSS");
 
     SidelinkSynchronization* slss = new SidelinkSynchronization("SLSS");
@@ -8,6 +8,7 @@
 //
 
 #include "stack/rlc/LteRlcMux.h"
+#include "common/LteProfiler.h"
 
 Define_Module(LteRlcMux);
 
@@ -71,6 +72,7 @@ void LteRlcMux::initialize()
 
 void LteRlcMux::handleMessage(cMessage* msg)
 {
+    LTE_PROFILE_SCOPE(this, "handleMessage");
     cPacket* pkt = check_and_cast<cPacket *>(msg);
     EV << "LteRlcMux : Received packet " << pkt->getName() <<
     " from port " << pkt->getArrivalGate()->getName() << endl;
@@ -14,6 +14,8 @@
 #include "stack/rlc/am/buffer/AmTxQueue.h"
 #include "stack/rlc/am/buffer/AmRxQueue.h"
 #include "stack/mac/packet/LteMacSduRequest.h"
+#include "stack/rlc/packet/LteRlcNewData_m.h"
+#include "common/LteProfiler.h"
 
 Define_Module(LteRlcAm);
 
@@ -233,18 +235,14 @@ void LteRlcAm::indicateNewDataToMac(cPacket* pktAux) {
     auto pkt = check_and_cast<inet::Packet *> (pktAux);
 
    // create a message so as to notify the MAC layer that the queue contains new data
-   // (MAC is only interested in FlowControlInfo tag and size)
+   // (MAC is only interested in the flow and size)
 
-    auto newData = new Packet("AM-NewData");
-    auto rlcSdu = inet::makeShared<LteRlcSdu>();
-    rlcSdu->setLengthMainPacket(pkt->getByteLength());
+    auto newData = new LteRlcNewData("AM-NewData");
+    newData->setFlowInfo(*pkt->getTag<FlowControlInfo>());
+    newData->setSduLength(pkt->getByteLength());
 
-    newData->insertAtFront(rlcSdu);
-
-    auto newDataHdr = inet::makeShared<LteRlcPduNewData>();
-    newData->insertAtFront(newDataHdr);
-
-    newData->copyTags(*pkt);
+    // same length as the RLC SDU and new data headers sent before
+    newData->setByteLength(2);
 
     EV << "LteRlcAm::sendNewDataPkt - Sending message " << newData->getName() << " to port AM_Sap_down$o\n";
     send(newData, down_[OUT_GATE]);
@@ -264,6 +262,7 @@ void LteRlcAm::initialize()
 
 void LteRlcAm::handleMessage(cMessage* msg)
 {
+    LTE_PROFILE_SCOPE(this, "handleMessage");
     cPacket* pkt = check_and_cast<cPacket *>(msg);
     EV << NOW << " LteRlcAm : Received packet " << pkt->getName() << " from port "
        << pkt->getArrivalGate()->getName() << endl;
@@ -13,6 +13,7 @@
 #include "common/LteControlInfo.h"
 #include "stack/mac/layer/LteMacBase.h"
 #include "inet/common/packet/Packet.h"
+#include "common/LteProfiler.h"
 
 Define_Module(AmRxQueue);
 
@@ -81,6 +82,7 @@ void AmRxQueue::initialize()
 
 void AmRxQueue::handleMessage(cMessage* msg)
 {
+    LTE_PROFILE_SCOPE(this, "handleMessage");
     if (!(msg->isSelfMessage()))
         throw cRuntimeError("Unexpected message received from AmRxQueue");
 
@@ -10,6 +10,7 @@
 #include "stack/rlc/am/buffer/AmTxQueue.h"
 #include "stack/rlc/am/LteRlcAm.h"
 #include "stack/mac/layer/LteMacBase.h"
+#include "common/LteProfiler.h"
 
 Define_Module(AmTxQueue);
 
@@ -824,6 +825,7 @@ void AmTxQueue::mrwTimerHandle(const int sn)
 
 void AmTxQueue::handleMessage(cMessage* msg)
 {
+    LTE_PROFILE_SCOPE(this, "handleMessage");
     if (msg->isName("timer"))
     {
         // message received from a timer
@@ -11,6 +11,7 @@
 
 #include "stack/rlc/tm/LteRlcTm.h"
 #include "stack/mac/packet/LteMacSduRequest.h"
+#include "common/LteProfiler.h"
 
 Define_Module(LteRlcTm);
 
@@ -127,6 +128,7 @@ void LteRlcTm::initialize()
 
 void LteRlcTm::handleMessage(cMessage* msg)
 {
+    LTE_PROFILE_SCOPE(this, "handleMessage");
     cPacket* pkt = check_and_cast<cPacket *>(msg);
     EV << "LteRlcTm : Received packet " << pkt->getName() <<
     " from port " << pkt->getArrivalGate()->getName() << endl;
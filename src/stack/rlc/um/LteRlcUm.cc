@@ -11,6 +11,7 @@
 
 #include "stack/rlc/um/LteRlcUm.h"
 #include "stack/mac/packet/LteMacSduRequest.h"
+#include "common/LteProfiler.h"
 
 Define_Module(LteRlcUm);
 
@@ -38,11 +39,7 @@ UmTxEntity* LteRlcUm::getTxBuffer(FlowControlInfo* lteInfo)
     if (it == txEntities_.end())
     {
         // Not found: create
-        std::stringstream buf;
-
-        buf << "UmTxEntity Lcid: " << lcid;
-        cModuleType* moduleType = cModuleType::get("lte.stack.rlc.UmTxEntity");
-        UmTxEntity* txEnt = check_and_cast<UmTxEntity *>(moduleType->createScheduleInit(buf.str().c_str(), getParentModule()));
+        UmTxEntity* txEnt = new UmTxEntity(this);
         txEntities_[cid] = txEnt;    // Add to tx_entities map
 
         if (lteInfo != nullptr)
@@ -51,16 +48,14 @@ UmTxEntity* LteRlcUm::getTxBuffer(FlowControlInfo* lteInfo)
             txEnt->setFlowControlInfo(lteInfo->dup());
         }
 
-        EV << "LteRlcUm : Added new UmTxEntity: " << txEnt->getId() <<
-        " for node: " << nodeId << " for Lcid: " << lcid << "\n";
+        EV << "LteRlcUm : Added new UmTxEntity for node: " << nodeId << " for Lcid: " << lcid << "\n";
 
         return txEnt;
     }
     else
     {
         // Found
-        EV << "LteRlcUm : Using old UmTxBuffer: " << it->second->getId() <<
-        " for node: " << nodeId << " for Lcid: " << lcid << "\n";
+        EV << "LteRlcUm : Using old UmTxBuffer for node: " << nodeId << " for Lcid: " << lcid << "\n";
 
         return it->second;
     }
@@ -83,26 +78,24 @@ UmRxEntity* LteRlcUm::getRxBuffer(FlowControlInfo* lteInfo)
     if (it == rxEntities_.end())
     {
         // Not found: create
-        std::stringstream buf;
-        buf << "UmRxEntity Lcid: " << lcid;
-        cModuleType* moduleType = cModuleType::get("lte.stack.rlc.UmRxEntity");
-        UmRxEntity* rxEnt = check_and_cast<UmRxEntity *>(
-            moduleType->createScheduleInit(buf.str().c_str(), getParentModule()));
+        UmRxEntity* rxEnt = new UmRxEntity(this);
         rxEntities_[cid] = rxEnt;    // Add to rx_entities map
 
         // store control info for this flow
         rxEnt->setFlowControlInfo(lteInfo->dup());
 
-        EV << "LteRlcUm : Added new UmRxEntity: " << rxEnt->getId() <<
-        " for node: " << nodeId << " for Lcid: " << lcid << "\n";
+        // D2D multicast entities are deleted when idle, if configured
+        if (idleRxEntityTimeout_ > 0 && rxEnt->isD2DMultiConnection() && !idleRxEntityTimer_->isScheduled())
+            scheduleAt(NOW + idleRxEntityTimeout_, idleRxEntityTimer_);
+
+        EV << "LteRlcUm : Added new UmRxEntity for node: " << nodeId << " for Lcid: " << lcid << "\n";
 
         return rxEnt;
     }
     else
     {
         // Found
-        EV << "LteRlcUm : Using old UmRxEntity: " << it->second->getId() <<
-        " for node: " << nodeId << " for Lcid: " << lcid << "\n";
+        EV << "LteRlcUm : Using old UmRxEntity for node: " << nodeId << " for Lcid: " << lcid << "\n";
 
         return it->second;
     }
@@ -123,19 +116,30 @@ void LteRlcUm::sendToLowerLayer(cPacket *pktAux)
 {
     Enter_Method_Silent("sendToLowerLayer()");                    // Direct Method Call
     take(pktAux);                                                    // Take ownership
-    auto pkt = check_and_cast<inet::Packet *> (pktAux);
-    pkt->addTagIfAbsent<inet::PacketProtocolTag>()->setProtocol(&LteProtocol::rlc);
+
+    // new data indications carry the flow info, the PDUs have it as a tag
+    Direction dir;
+    LteRlcNewData* newData = dynamic_cast<LteRlcNewData *>(pktAux);
+    if (newData != nullptr)
+    {
+        dir = (Direction) newData->getFlowInfo().getDirection();
+    }
+    else
+    {
+        auto pkt = check_and_cast<inet::Packet *> (pktAux);
+        pkt->addTagIfAbsent<inet::PacketProtocolTag>()->setProtocol(&LteProtocol::rlc);
+        dir = (Direction) pkt->getTag<FlowControlInfo>()->getDirection();
+    }
+
     EV << "LteRlcUm : Sending packet " << pktAux->getName() << " to port UM_Sap_down$o\n";
     send(pktAux, down_[OUT_GATE]);
 
-    auto  lteInfo = pkt->getTag<FlowControlInfo>();
-
-    if (lteInfo->getDirection()==DL)
+    if (dir==DL)
         emit(rlcPacketLossDl, 0.0);
     else
         emit(rlcPacketLossUl, 0.0);
 
-    emit(sentPacketToLowerLayer, pkt);
+    emit(sentPacketToLowerLayer, pktAux);
 }
 
 void LteRlcUm::dropBufferOverflow(cPacket *pktAux)
@@ -156,6 +160,18 @@ void LteRlcUm::dropBufferOverflow(cPacket *pktAux)
    delete pkt;
 }
 
+LteRlcNewData* LteRlcUm::createNewDataIndication(inet::Packet *pkt)
+{
+    auto newData = new LteRlcNewData(pkt->getName());
+    newData->setFlowInfo(*pkt->getTag<FlowControlInfo>());
+    newData->setSduLength(pkt->peekAtFront<LteRlcSdu>()->getLengthMainPacket());
+
+    // same length as the SDU with a new data header
+    newData->setByteLength(pkt->getByteLength() + 1);
+
+    return newData;
+}
+
 void LteRlcUm::handleUpperMessage(cPacket *pktAux)
 {
     emit(receivedPacketFromUpperLayer, pktAux);
@@ -188,14 +204,10 @@ void LteRlcUm::handleUpperMessage(cPacket *pktAux)
             EV << "LteRlcUm::handleUpperMessage - Enque packet " << rlcPkt->getClassName() << " into the Tx Buffer\n";
 
             // create a message so as to notify the MAC layer that the queue contains new data
-            auto newDataPkt = inet::makeShared<LteRlcPduNewData>();
-            // make a copy of the RLC SDU
-            auto pktDup = pkt->dup();
-            pktDup->insertAtFront(newDataPkt);
-            // the MAC will only be interested in the size of this packet
-
-            EV << "LteRlcUm::handleUpperMessage - Sending message " << newDataPkt->getClassName() << " to port UM_Sap_down$o\n";
-            send(pktDup, down_[OUT_GATE]);
+            auto newDataPkt = createNewDataIndication(pkt);
+
+            EV << "LteRlcUm::handleUpperMessage - Sending message " << newDataPkt->getName() << " to port UM_Sap_down$o\n";
+            send(newDataPkt, down_[OUT_GATE]);
         } else {
             // Queue is full - drop SDU
             dropBufferOverflow(pkt);
@@ -257,7 +269,7 @@ void LteRlcUm::deleteQueues(MacNodeId nodeId)
     {
         if (nodeType == UE || (nodeType == ENODEB && MacCidToNodeId(tit->first) == nodeId))
         {
-            tit->second->deleteModule(); // Delete Entity
+            delete tit->second;          // Delete Entity
             txEntities_.erase(tit++);    // Delete Elem
         }
         else
@@ -269,7 +281,7 @@ void LteRlcUm::deleteQueues(MacNodeId nodeId)
     {
         if (nodeType == UE || (nodeType == ENODEB && MacCidToNodeId(rit->first) == nodeId))
         {
-            rit->second->deleteModule(); // Delete Entity
+            delete rit->second;          // Delete Entity
             rxEntities_.erase(rit++);    // Delete Elem
         }
         else
@@ -279,10 +291,60 @@ void LteRlcUm::deleteQueues(MacNodeId nodeId)
     }
 }
 
+void LteRlcUm::deleteIdleRxEntities()
+{
+    bool multicastEntities = false;
+    UmRxEntities::iterator rit = rxEntities_.begin();
+    while (rit != rxEntities_.end())
+    {
+        UmRxEntity* rxEnt = rit->second;
+        if (!rxEnt->isD2DMultiConnection())
+        {
+            ++rit;
+            continue;
+        }
+
+        if (rxEnt->isIdle() && NOW - rxEnt->getLastActivity() >= idleRxEntityTimeout_)
+        {
+            EV << "LteRlcUm::deleteIdleRxEntities - deleting idle UmRxEntity for node: " << MacCidToNodeId(rit->first)
+               << " for Lcid: " << MacCidToLcid(rit->first) << "\n";
+            delete rxEnt;
+            rxEntities_.erase(rit++);
+        }
+        else
+        {
+            multicastEntities = true;
+            ++rit;
+        }
+    }
+
+    if (multicastEntities)
+        scheduleAt(NOW + idleRxEntityTimeout_, idleRxEntityTimer_);
+}
+
 /*
  * Main functions
  */
 
+LteRlcUm::~LteRlcUm()
+{
+    UmTxEntities::iterator tit = txEntities_.begin();
+    for (; tit != txEntities_.end(); ++tit)
+        delete tit->second;
+    txEntities_.clear();
+
+    // the timer modules of the RX entities are deleted together with this module's parent
+    UmRxEntities::iterator rit = rxEntities_.begin();
+    for (; rit != rxEntities_.end(); ++rit)
+    {
+        rit->second->detachTimerModule();
+        delete rit->second;
+    }
+    rxEntities_.clear();
+
+    cancelAndDelete(idleRxEntityTimer_);
+}
+
 void LteRlcUm::initialize(int stage)
 {
     if (stage == inet::INITSTAGE_LOCAL)
@@ -294,6 +356,8 @@ void LteRlcUm::initialize(int stage)
 
         // parameters
         mapAllLcidsToSingleBearer_ = par("mapAllLcidsToSingleBearer");
+        idleRxEntityTimeout_ = par("idleRxEntityTimeout");
+        idleRxEntityTimer_ = new cMessage("idleRxEntityTimer");
 
         // statistics
         receivedPacketFromUpperLayer = registerSignal("receivedPacketFromUpperLayer");
@@ -310,6 +374,13 @@ void LteRlcUm::initialize(int stage)
 
 void LteRlcUm::handleMessage(cMessage* msg)
 {
+    LTE_PROFILE_SCOPE(this, "handleMessage");
+    if (msg == idleRxEntityTimer_)
+    {
+        deleteIdleRxEntities();
+        return;
+    }
+
     cPacket* pkt = check_and_cast<cPacket *>(msg);
     EV << "LteRlcUm : Received packet " << pkt->getName() << " from port " << pkt->getArrivalGate()->getName() << endl;
 
@@ -14,6 +14,7 @@
 #include "common/LteCommon.h"
 #include "common/LteControlInfo.h"
 #include "stack/rlc/packet/LteRlcSdu_m.h"
+#include "stack/rlc/packet/LteRlcNewData_m.h"
 #include "stack/rlc/um/entity/UmTxEntity.h"
 #include "stack/rlc/um/entity/UmRxEntity.h"
 #include "stack/rlc/packet/LteRlcDataPdu.h"
@@ -33,7 +34,7 @@ class UmRxEntity;
  *   This mode is used for data traffic. Packets arriving on
  *   this port have been already assigned a CID.
  *   UM implements fragmentation and reassembly of packets.
- *   To perform this task there is a TxEntity module for
+ *   To perform this task there is a TxEntity object for
  *   every CID = <NODE_ID,LCID>. RLC PDUs are created by the
  *   sender and reassembly is performed at the receiver by
  *   simply returning him the original packet.
@@ -46,9 +47,11 @@ class UmRxEntity;
 class SIMULTE_API LteRlcUm : public omnetpp::cSimpleModule
 {
   public:
-    virtual ~LteRlcUm()
+    LteRlcUm()
     {
+        idleRxEntityTimer_ = nullptr;
     }
+    virtual ~LteRlcUm();
 
     /**
      * sendFragmented() is invoked by the TXBuffer as a direct method
@@ -85,6 +88,16 @@ class SIMULTE_API LteRlcUm : public omnetpp::cSimpleModule
      */
     virtual void sendToLowerLayer(omnetpp::cPacket *pkt);
 
+    /**
+     * createNewDataIndication() builds the message that notifies the MAC
+     * of a new SDU in a TX buffer, carrying its flow and size instead of
+     * a copy of it.
+     *
+     * @param pkt SDU stored in the TX buffer
+     * @return new data indication, with the same length as the SDU plus its header
+     */
+    LteRlcNewData* createNewDataIndication(inet::Packet *pkt);
+
     /**
      * dropBufferOverflow() is invoked by the TXEntity as a direct method
      * call and used to drop fragments if the queue is full.
@@ -128,6 +141,17 @@ class SIMULTE_API LteRlcUm : public omnetpp::cSimpleModule
 
     // parameters
     bool mapAllLcidsToSingleBearer_;
+    omnetpp::simtime_t idleRxEntityTimeout_;
+
+    // triggers the deletion of idle D2D multicast RX entities
+    omnetpp::cMessage* idleRxEntityTimer_;
+
+    /**
+     * deleteIdleRxEntities() deletes the RX entities of D2D multicast
+     * flows that have not received data for idleRxEntityTimeout_
+     * and have nothing to reassemble
+     */
+    void deleteIdleRxEntities();
 
     /**
      * getTxBuffer() is used by the sender to gather the TXBuffer
@@ -193,7 +217,7 @@ class SIMULTE_API LteRlcUm : public omnetpp::cSimpleModule
 
     /**
      * The entities map associate each CID with
-     * a TX/RX Entity , identified by its ID
+     * a TX/RX Entity, owned by this module
      */
     typedef std::map<MacCid, UmTxEntity*> UmTxEntities;
     typedef std::map<MacCid, UmRxEntity*> UmRxEntities;
@@ -24,11 +24,7 @@ UmTxEntity* LteRlcUmD2D::getTxBuffer(FlowControlInfo* lteInfo)
 	if (it == txEntities_.end())
 	{
 		// Not found: create
-		std::stringstream buf;
-
-		buf << "UmTxEntity Lcid: " << lcid;
-		cModuleType* moduleType = cModuleType::get("lte.stack.rlc.UmTxEntity");
-		UmTxEntity* txEnt = check_and_cast<UmTxEntity *>(moduleType->createScheduleInit(buf.str().c_str(), getParentModule()));
+		UmTxEntity* txEnt = new UmTxEntity(this);
 		txEntities_[cid] = txEnt;    // Add to tx_entities map
 
 		if (lteInfo != nullptr)
@@ -37,8 +33,7 @@ UmTxEntity* LteRlcUmD2D::getTxBuffer(FlowControlInfo* lteInfo)
 			txEnt->setFlowControlInfo(lteInfo->dup());
 		}
 
-		EV << "LteRlcUmD2D : Added new UmTxEntity: " << txEnt->getId() <<
-				" for node: " << nodeId << " for Lcid: " << lcid << "\n";
+		EV << "LteRlcUmD2D : Added new UmTxEntity for node: " << nodeId << " for Lcid: " << lcid << "\n";
 
 		// store per-peer map
 		MacNodeId d2dPeer = lteInfo->getD2dRxPeerId();
@@ -53,8 +48,7 @@ UmTxEntity* LteRlcUmD2D::getTxBuffer(FlowControlInfo* lteInfo)
 	else
 	{
 		// Found
-		EV << "LteRlcUmD2D : Using old UmTxBuffer: " << it->second->getId() <<
-				" for node: " << nodeId << " for Lcid: " << lcid << "\n";
+		EV << "LteRlcUmD2D : Using old UmTxBuffer for node: " << nodeId << " for Lcid: " << lcid << "\n";
 
 		return it->second;
 	}
@@ -158,7 +152,7 @@ void LteRlcUmD2D::deleteQueues(MacNodeId nodeId)
 
 		if (nodeType == UE || (nodeType == ENODEB && MacCidToNodeId(tit->first) == nodeId))
 		{
-			tit->second->deleteModule(); // Delete Entity
+			delete tit->second;          // Delete Entity
 			txEntities_.erase(tit++);    // Delete Elem
 		}
 		else
@@ -177,7 +171,7 @@ void LteRlcUmD2D::deleteQueues(MacNodeId nodeId)
 
 		if (nodeType == UE || (nodeType == ENODEB && MacCidToNodeId(rit->first) == nodeId))
 		{
-			rit->second->deleteModule(); // Delete Entity
+			delete rit->second;          // Delete Entity
 			rxEntities_.erase(rit++);    // Delete Elem
 		}
 		else
@@ -12,23 +12,84 @@
 #include "stack/mac/layer/LteMacBase.h"
 #include "stack/mac/layer/LteMacEnb.h"
 
-Define_Module(UmRxEntity);
-
 using namespace inet;
 
+Define_Module(UmRxEntityTimer);
+
 unsigned int UmRxEntity::totalCellPduRcvdBytes_ = 0;
 unsigned int UmRxEntity::totalCellRcvdBytes_ = 0;
 
-UmRxEntity::UmRxEntity() :
-    t_reordering_(this)
+UmRxEntity::UmRxEntity(LteRlcUm* lteRlc) :
+    t_reordering_(lteRlc)
 {
     t_reordering_.setTimerId(REORDERING_T);
+    t_reordering_.setContextPointer(this);
+    timerModule_ = nullptr;
     buffered_.pkt = nullptr;
     buffered_.size = 0;
     lastSnoDelivered_ = 0;
     lastPduReassembled_ = 0;
     nodeB_ = nullptr;
     init_ = false;
+    flowControlInfo_ = nullptr;
+    lteRlc_ = lteRlc;
+    lastActivity_ = NOW;
+
+    binder_ = getBinder();
+    timeout_ = lteRlc_->par("rxTimeout").doubleValue();
+    rxWindowDesc_.clear();
+    rxWindowDesc_.windowSize_ = lteRlc_->par("rxWindowSize");
+    received_.resize(rxWindowDesc_.windowSize_);
+
+    totalRcvdBytes_ = 0;
+    totalPduRcvdBytes_ = 0;
+
+    //statistics
+    LteMacBase* mac = check_and_cast<LteMacBase*>(lteRlc_->getParentModule()->getParentModule()->getSubmodule("mac"));
+
+    nodeB_ = getRlcByMacNodeId(mac->getMacCellId(), UM);
+
+    resetFlag_ = false;
+
+    if (mac->getNodeType() == ENODEB)
+    {
+        rlcCellPacketLoss_ = lteRlc_->registerSignal("rlcCellPacketLossUl");
+        rlcPacketLoss_ = lteRlc_->registerSignal("rlcPacketLossUl");
+        rlcPduPacketLoss_ = lteRlc_->registerSignal("rlcPduPacketLossUl");
+        rlcDelay_ = lteRlc_->registerSignal("rlcDelayUl");
+        rlcThroughput_ = lteRlc_->registerSignal("rlcThroughputUl");
+        rlcPduDelay_ = lteRlc_->registerSignal("rlcPduDelayUl");
+        rlcPduThroughput_ = lteRlc_->registerSignal("rlcPduThroughputUl");
+        rlcCellThroughput_ = lteRlc_->registerSignal("rlcCellThroughputUl");
+        rlcPacketLossTotal_ = lteRlc_->registerSignal("rlcPacketLossTotal");
+    }
+    else // UE
+    {
+        rlcPacketLoss_ = lteRlc_->registerSignal("rlcPacketLossDl");
+        rlcPduPacketLoss_ = lteRlc_->registerSignal("rlcPduPacketLossDl");
+        rlcDelay_ = lteRlc_->registerSignal("rlcDelayDl");
+        rlcThroughput_ = lteRlc_->registerSignal("rlcThroughputDl");
+        rlcPduDelay_ = lteRlc_->registerSignal("rlcPduDelayDl");
+        rlcPduThroughput_ = lteRlc_->registerSignal("rlcPduThroughputDl");
+
+        rlcCellThroughput_ = nodeB_->registerSignal("rlcCellThroughputDl");
+        rlcCellPacketLoss_ = nodeB_->registerSignal("rlcCellPacketLossDl");
+    }
+
+    if (mac->isD2DCapable())
+    {
+        rlcPacketLossD2D_ = lteRlc_->registerSignal("rlcPacketLossD2D");
+        rlcPduPacketLossD2D_ = lteRlc_->registerSignal("rlcPduPacketLossD2D");
+        rlcDelayD2D_ = lteRlc_->registerSignal("rlcDelayD2D");
+        rlcThroughputD2D_ = lteRlc_->registerSignal("rlcThroughputD2D");
+        rlcPduDelayD2D_ = lteRlc_->registerSignal("rlcPduDelayD2D");
+        rlcPduThroughputD2D_ = lteRlc_->registerSignal("rlcPduThroughputD2D");
+    }
+
+    rlcPacketLossTotal_ = lteRlc_->registerSignal("rlcPacketLossTotal");
+
+    // store the node id of the owner module (useful for statistics)
+    ownerNodeId_ = mac->getMacNodeId();
 }
 
 UmRxEntity::~UmRxEntity()
@@ -38,13 +99,19 @@ UmRxEntity::~UmRxEntity()
         	buffered_.pkt = nullptr;
         }
 
+    if (timerModule_ != nullptr)
+    {
+        stopReorderingTimer();
+        timerModule_->deleteModule();
+    }
+
     delete flowControlInfo_;
 }
 
 void UmRxEntity::enque(cPacket* pktAux)
 {
-    Enter_Method("enque()");
     EV << NOW << " UmRxEntity::enque - buffering new PDU" << endl;
+    lastActivity_ = NOW;
 
     auto pktPdu = check_and_cast<Packet *>(pktAux);
     auto pdu = pktPdu->peekAtFront<LteRlcUmDataPdu>();
@@ -148,7 +215,7 @@ void UmRxEntity::enque(cPacket* pktAux)
 
     if (pktPdu->getByteLength() > 1) // It is possible to received a packet with only 1 byte if not enough space
         totalPduRcvdBytes_ += pktPdu->getByteLength();
-    double tputSample = (double)totalPduRcvdBytes_ / (NOW - getSimulation()->getWarmupPeriod());
+    double tputSample = (double)totalPduRcvdBytes_ / (NOW - omnetpp::getSimulation()->getWarmupPeriod());
     cModule* ue = getRlcByMacNodeId(ueId, UM);
     if (lteInfo->getDirection() != D2D && lteInfo->getDirection() != D2D_MULTI)  // UE in IM
     {
@@ -197,7 +264,7 @@ void UmRxEntity::enque(cPacket* pktAux)
         if (rxWindowDesc_.reorderingSno_ <= rxWindowDesc_.firstSnoForReordering_ ||
                 rxWindowDesc_.reorderingSno_ < rxWindowDesc_.firstSno_ || rxWindowDesc_.reorderingSno_ > rxWindowDesc_.highestReceivedSno_ )
         {
-            t_reordering_.stop();
+            stopReorderingTimer();
         }
     }
     // if t_reordering is not running
@@ -205,7 +272,7 @@ void UmRxEntity::enque(cPacket* pktAux)
     {
         if (rxWindowDesc_.highestReceivedSno_ > rxWindowDesc_.firstSnoForReordering_)
         {
-            t_reordering_.start(timeout_);
+            startReorderingTimer();
             rxWindowDesc_.reorderingSno_ = rxWindowDesc_.highestReceivedSno_;
         }
     }
@@ -246,7 +313,6 @@ void UmRxEntity::toPdcp(Packet* pktAux)
 {
 
     auto rlcSdu = pktAux->popAtFront<LteRlcSdu>();
-    LteRlcUm* lteRlc = check_and_cast<LteRlcUm*>(getParentModule()->getSubmodule("um"));
 
     auto lteInfo = pktAux->getTag<FlowControlInfo>();
     unsigned int sno = rlcSdu->getSnoMainPacket();
@@ -279,8 +345,8 @@ void UmRxEntity::toPdcp(Packet* pktAux)
     // emit statistic: throughput
     totalCellRcvdBytes_ += length;
     totalRcvdBytes_ += length;
-    double cellTputSample = (double)totalCellRcvdBytes_ / (NOW - getSimulation()->getWarmupPeriod());
-    double tputSample = (double)totalRcvdBytes_ / (NOW - getSimulation()->getWarmupPeriod());
+    double cellTputSample = (double)totalCellRcvdBytes_ / (NOW - omnetpp::getSimulation()->getWarmupPeriod());
+    double tputSample = (double)totalRcvdBytes_ / (NOW - omnetpp::getSimulation()->getWarmupPeriod());
 
     nodeB_->emit(rlcCellThroughput_, cellTputSample);
     if (lteInfo->getDirection() != D2D && lteInfo->getDirection() != D2D_MULTI)  // UE in IM
@@ -312,7 +378,7 @@ void UmRxEntity::toPdcp(Packet* pktAux)
     EV << NOW << " UmRxEntity::toPdcp Created PDCP PDU with length " <<  pktAux->getByteLength() << " bytes" << endl;
     EV << NOW << " UmRxEntity::toPdcp Send packet to upper layer" << endl;
 
-    lteRlc->sendDefragmented(pktAux);
+    lteRlc_->sendDefragmented(pktAux);
 }
 
 
@@ -708,72 +774,6 @@ void UmRxEntity::reassemble(unsigned int index)
     delete pktPdu;
 }
 
-/*
- * Main Functions
- */
-
-void UmRxEntity::initialize()
-{
-    binder_ = getBinder();
-    timeout_ = par("timeout").doubleValue();
-    rxWindowDesc_.clear();
-    rxWindowDesc_.windowSize_ = par("rxWindowSize");
-    received_.resize(rxWindowDesc_.windowSize_);
-
-    totalRcvdBytes_ = 0;
-    totalPduRcvdBytes_ = 0;
-
-    cModule* parent = check_and_cast<LteRlcUm*>(getParentModule()->getSubmodule("um"));
-    //statistics
-    LteMacBase* mac = check_and_cast<LteMacBase*>(getParentModule()->getParentModule()->getSubmodule("mac"));
-
-    nodeB_ = getRlcByMacNodeId(mac->getMacCellId(), UM);
-
-    resetFlag_ = false;
-
-    if (mac->getNodeType() == ENODEB)
-    {
-        rlcCellPacketLoss_ = parent->registerSignal("rlcCellPacketLossUl");
-        rlcPacketLoss_ = parent->registerSignal("rlcPacketLossUl");
-        rlcPduPacketLoss_ = parent->registerSignal("rlcPduPacketLossUl");
-        rlcDelay_ = parent->registerSignal("rlcDelayUl");
-        rlcThroughput_ = parent->registerSignal("rlcThroughputUl");
-        rlcPduDelay_ = parent->registerSignal("rlcPduDelayUl");
-        rlcPduThroughput_ = parent->registerSignal("rlcPduThroughputUl");
-        rlcCellThroughput_ = parent->registerSignal("rlcCellThroughputUl");
-        rlcPacketLossTotal_ = parent->registerSignal("rlcPacketLossTotal");
-    }
-    else // UE
-    {
-        rlcPacketLoss_ = parent->registerSignal("rlcPacketLossDl");
-        rlcPduPacketLoss_ = parent->registerSignal("rlcPduPacketLossDl");
-        rlcDelay_ = parent->registerSignal("rlcDelayDl");
-        rlcThroughput_ = parent->registerSignal("rlcThroughputDl");
-        rlcPduDelay_ = parent->registerSignal("rlcPduDelayDl");
-        rlcPduThroughput_ = parent->registerSignal("rlcPduThroughputDl");
-
-        rlcCellThroughput_ = nodeB_->registerSignal("rlcCellThroughputDl");
-        rlcCellPacketLoss_ = nodeB_->registerSignal("rlcCellPacketLossDl");
-    }
-
-    if (mac->isD2DCapable())
-    {
-        rlcPacketLossD2D_ = parent->registerSignal("rlcPacketLossD2D");
-        rlcPduPacketLossD2D_ = parent->registerSignal("rlcPduPacketLossD2D");
-        rlcDelayD2D_ = parent->registerSignal("rlcDelayD2D");
-        rlcThroughputD2D_ = parent->registerSignal("rlcThroughputD2D");
-        rlcPduDelayD2D_ = parent->registerSignal("rlcPduDelayD2D");
-        rlcPduThroughputD2D_ = parent->registerSignal("rlcPduThroughputD2D");
-    }
-
-    rlcPacketLossTotal_ = parent->registerSignal("rlcPacketLossTotal");
-
-    // store the node id of the owner module (useful for statistics)
-    ownerNodeId_ = mac->getMacNodeId();
-
-    WATCH(timeout_);
-}
-
 void UmRxEntity::handleMessage(cMessage* msg)
 {
     if (msg->isName("timer"))
@@ -803,7 +803,7 @@ void UmRxEntity::handleMessage(cMessage* msg)
         if (rxWindowDesc_.highestReceivedSno_ > rxWindowDesc_.firstSnoForReordering_)
         {
             rxWindowDesc_.reorderingSno_ = rxWindowDesc_.highestReceivedSno_;
-            t_reordering_.start(timeout_);
+            startReorderingTimer();
         }
 
         delete msg;
@@ -811,6 +811,40 @@ void UmRxEntity::handleMessage(cMessage* msg)
     }
 }
 
+void UmRxEntity::startReorderingTimer()
+{
+    if (timerModule_ == nullptr)
+    {
+        // same name and parent as the former entity modules, so that the timer events are delivered
+        // to the same module path (and fingerprints that include it are unchanged)
+        std::stringstream buf;
+        buf << "UmRxEntity Lcid: " << flowControlInfo_->getLcid();
+        cModuleType* moduleType = cModuleType::get("lte.stack.rlc.UmRxEntityTimer");
+        timerModule_ = check_and_cast<cSimpleModule*>(moduleType->createScheduleInit(buf.str().c_str(), lteRlc_->getParentModule()));
+        t_reordering_.setModule(timerModule_);
+    }
+
+    // the timer message must be owned by the timer module
+    cMethodCallContextSwitcher ctx(timerModule_);
+    ctx.methodCallSilent();
+    t_reordering_.start(timeout_);
+}
+
+void UmRxEntity::stopReorderingTimer()
+{
+    if (!t_reordering_.busy())
+        return;
+
+    cMethodCallContextSwitcher ctx(timerModule_);
+    ctx.methodCallSilent();
+    t_reordering_.stop();
+}
+
+void UmRxEntityTimer::handleMessage(cMessage* msg)
+{
+    static_cast<UmRxEntity*>(msg->getContextPointer())->handleMessage(msg);
+}
+
 void UmRxEntity::rlcHandleD2DModeSwitch(bool oldConnection, bool oldMode, bool clearBuffer)
 {
     if (oldConnection)
@@ -847,8 +881,7 @@ void UmRxEntity::rlcHandleD2DModeSwitch(bool oldConnection, bool oldMode, bool c
             }
 
             // stop the timer
-            if (t_reordering_.busy())
-                t_reordering_.stop();
+            stopReorderingTimer();
         }
     }
     else
@@ -29,11 +29,16 @@ class LteRlcUmDataPdu;
  * RLC SDUs in UM mode at RLC layer of the LTE stack.
  *
  * It implements the procedures described in 3GPP TS 36.322
+ *
+ * Entities are plain objects, created and owned by the LteRlcUm module
+ * (one per CID). The reordering timer is scheduled on an UmRxEntityTimer
+ * module, created when the timer is first started and named as the entity
+ * modules used to be, which dispatches it back to the entity.
  */
-class SIMULTE_API UmRxEntity : public omnetpp::cSimpleModule
+class SIMULTE_API UmRxEntity : public omnetpp::cObject
 {
   public:
-    UmRxEntity();
+    UmRxEntity(LteRlcUm* lteRlc);
     virtual ~UmRxEntity();
 
     /*
@@ -51,13 +56,25 @@ class SIMULTE_API UmRxEntity : public omnetpp::cSimpleModule
     // called when a D2D mode switch is triggered
     void rlcHandleD2DModeSwitch(bool oldConnection, bool oldMode, bool clearBuffer=true);
 
+    // called by the timer module when the reordering timer expires
+    void handleMessage(omnetpp::cMessage* msg);
+
+    // returns true if the entity has neither buffered data nor a running timer
+    bool isIdle() const { return pduBuffer_.size() == 0 && buffered_.pkt == nullptr && !t_reordering_.busy(); }
+
+    // time of the last PDU received
+    omnetpp::simtime_t getLastActivity() const { return lastActivity_; }
+
+    // called when the timer module is being deleted together with the RLC layer
+    void detachTimerModule() { timerModule_ = nullptr; }
+
   protected:
 
-    /**
-     * Initialize watches
-     */
-    virtual void initialize();
-    virtual void handleMessage(omnetpp::cMessage* msg);
+    // starts t_reordering_, creating its module if needed
+    void startReorderingTimer();
+
+    // stops t_reordering_, if running
+    void stopReorderingTimer();
 
     //Statistics
     static unsigned int totalCellPduRcvdBytes_;
@@ -88,6 +105,9 @@ class SIMULTE_API UmRxEntity : public omnetpp::cSimpleModule
 
     LteBinder* binder_;
 
+    // reference to the parent's RLC layer
+    LteRlcUm* lteRlc_;
+
     // reference to eNB for statistic purpose
     omnetpp::cModule* nodeB_;
 
@@ -109,9 +129,15 @@ class SIMULTE_API UmRxEntity : public omnetpp::cSimpleModule
     // Timer to manage reordering of the PDUs
     TTimer t_reordering_;
 
+    // Module on which t_reordering_ is scheduled (created at its first start)
+    omnetpp::cSimpleModule* timerModule_;
+
     // Timeout for above timer
     double timeout_;
 
+    // time of the last PDU received
+    omnetpp::simtime_t lastActivity_;
+
     // For each PDU a received status variable is kept.
     std::vector<bool> received_;
 
@@ -144,5 +170,17 @@ class SIMULTE_API UmRxEntity : public omnetpp::cSimpleModule
     void toPdcp(inet::Packet* rlcSdu);
 };
 
+/**
+ * @class UmRxEntityTimer
+ * @brief Module hosting the reordering timer of an UmRxEntity
+ *
+ * The timer messages carry their entity as context pointer.
+ */
+class SIMULTE_API UmRxEntityTimer : public omnetpp::cSimpleModule
+{
+  protected:
+    virtual void handleMessage(omnetpp::cMessage* msg) override;
+};
+
 #endif
 
@@ -9,8 +9,7 @@
 
 #include "stack/rlc/um/entity/UmTxEntity.h"
 #include "stack/rlc/am/packet/LteRlcAmPdu.h"
-
-Define_Module(UmTxEntity);
+#include "common/LteProfiler.h"
 
 using namespace inet;
 
@@ -18,19 +17,19 @@ using namespace inet;
  * Main functions
  */
 
-void UmTxEntity::initialize()
+UmTxEntity::UmTxEntity(LteRlcUm* lteRlc)
 {
+    flowControlInfo_ = nullptr;
     sno_ = 0;
     firstIsFragment_ = false;
     notifyEmptyBuffer_ = false;
     holdingDownstreamInPackets_ = false;
 
-    // store the node id of the owner module
-    LteMacBase* mac = check_and_cast<LteMacBase*>(getParentModule()->getParentModule()->getSubmodule("mac"));
+    // store the reference to the RLC module and the node id of the owner module
+    lteRlc_ = lteRlc;
+    LteMacBase* mac = check_and_cast<LteMacBase*>(lteRlc_->getParentModule()->getParentModule()->getSubmodule("mac"));
     ownerNodeId_ = mac->getMacNodeId();
 
-    // get the reference to the RLC module
-    lteRlc_ = check_and_cast<LteRlcUm*>(getParentModule()->getSubmodule("um"));
     queueSize_ = lteRlc_->par("queueSize");
     queueLength_ = 0;
 }
@@ -52,6 +51,7 @@ bool UmTxEntity::enque(cPacket* pkt)
 
 void UmTxEntity::rlcPduMake(int pduLength)
 {
+    LTE_PROFILE_SCOPE(lteRlc_, "rlcPduMake");
     EV << NOW << " UmTxEntity::rlcPduMake - PDU with size " << pduLength << " requested from MAC"<< endl;
 
     // create the RLC PDU
@@ -254,12 +254,9 @@ void UmTxEntity::resumeDownstreamInPackets()
         // store the SDU in the TX buffer
         if(enque(pktRlc)){
         	// create a message so as to notify the MAC layer that the queue contains new data
-        	auto newDataPkt = inet::makeShared<LteRlcPduNewData>();
-        	// make a copy of the RLC SDU
-        	auto pktRlcdup = pktRlc->dup();
-        	pktRlcdup->insertAtFront(newDataPkt);
+        	auto newDataPkt = lteRlc_->createNewDataIndication(pktRlc);
             // send the new data indication to the MAC
-        	lteRlc_->sendToLowerLayer(pktRlcdup);
+        	lteRlc_->sendToLowerLayer(newDataPkt);
         } else {
         	// Queue is full - drop SDU
             EV << "UmTxEntity::resumeDownstreamInPackets - cannot buffer SDU (queue is full), dropping" << std::endl;
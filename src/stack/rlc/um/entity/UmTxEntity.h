@@ -38,8 +38,11 @@ class LteRlcUm;
  *   to the lower layer
  *
  * The size of PDUs is signalled by the lower layer
+ *
+ * Entities are plain objects, created and owned by the LteRlcUm module
+ * (one per CID).
  */
-class SIMULTE_API UmTxEntity : public omnetpp::cSimpleModule
+class SIMULTE_API UmTxEntity : public omnetpp::cObject
 {
     struct FragmentInfo {
         inet::Packet * pkt= nullptr;
@@ -52,11 +55,7 @@ class SIMULTE_API UmTxEntity : public omnetpp::cSimpleModule
     std::deque<inet::Packet *> *fragments = nullptr;
 
   public:
-    UmTxEntity()
-    {
-        flowControlInfo_ = nullptr;
-        lteRlc_ = nullptr;
-    }
+    UmTxEntity(LteRlcUm* lteRlc);
     virtual ~UmTxEntity()
     {
         delete flowControlInfo_;
@@ -158,12 +157,6 @@ class SIMULTE_API UmTxEntity : public omnetpp::cSimpleModule
      */
     unsigned int queueLength_;
 
-    /**
-     * Initialize fragmentSize and
-     * watches
-     */
-    virtual void initialize() override;
-
   private:
 
     // Node id of the owner module
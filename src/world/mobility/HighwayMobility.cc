@@ -0,0 +1,64 @@
+//
+//                           SimuLTE
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". This license can be also found at http://www.ltesimulator.com/
+// The above file and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#include "world/mobility/HighwayMobility.h"
+
+Define_Module(HighwayMobility);
+
+using namespace omnetpp;
+
+void HighwayMobility::initialize(int stage)
+{
+    MovingMobilityBase::initialize(stage);
+
+    if (stage == inet::INITSTAGE_LOCAL)
+    {
+        highwayX_ = par("highwayX");
+        highwayLength_ = par("highwayLength");
+        speed_ = par("speed");
+
+        int numLanes = par("numLanes");
+        int numVehicles = par("numVehicles");
+        int index = par("vehicleIndex");
+        if (highwayLength_ <= 0 || numLanes <= 0 || numVehicles <= 0)
+            throw cRuntimeError("HighwayMobility::initialize - highwayLength, numLanes and numVehicles must be positive");
+        if (index < 0 || index >= numVehicles)
+            throw cRuntimeError("HighwayMobility::initialize - vehicle index %d out of range [0,%d)", index, numVehicles);
+
+        // lanes are filled round robin, consecutive lanes are staggered by a fraction of the spacing
+        int lane = index % numLanes;
+        int slot = index / numLanes;
+        int slotsPerLane = (numVehicles + numLanes - 1) / numLanes;
+        double spacing = highwayLength_ / slotsPerLane;
+        offset_ = (slot + (double)lane / numLanes) * spacing;
+
+        direction_ = (lane < (numLanes + 1) / 2) ? 1 : -1;
+        laneY_ = par("highwayY").doubleValue() + lane * par("laneWidth").doubleValue();
+
+        stationary = (speed_ == 0);
+        lastVelocity = inet::Coord(direction_ * speed_, 0, 0);
+    }
+}
+
+double HighwayMobility::getHighwayPosition() const
+{
+    double pos = fmod(offset_ + direction_ * speed_ * simTime().dbl(), highwayLength_);
+    return (pos < 0) ? pos + highwayLength_ : pos;
+}
+
+void HighwayMobility::setInitialPosition()
+{
+    lastPosition = inet::Coord(highwayX_ + getHighwayPosition(), laneY_, 0);
+}
+
+void HighwayMobility::move()
+{
+    // the position is a function of time only, no need to integrate the velocity
+    lastPosition.x = highwayX_ + getHighwayPosition();
+}
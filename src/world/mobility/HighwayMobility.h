@@ -0,0 +1,51 @@
+//
+//                           SimuLTE
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". This license can be also found at http://www.ltesimulator.com/
+// The above file and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#ifndef _LTE_HIGHWAYMOBILITY_H_
+#define _LTE_HIGHWAYMOBILITY_H_
+
+#include "inet/mobility/base/MovingMobilityBase.h"
+#include "common/LteCommon.h"
+
+/**
+ * Mobility of a vehicle on a synthetic straight multi-lane highway.
+ *
+ * The highway runs along the x axis, from highwayX to highwayX + highwayLength.
+ * The first half of the lanes is eastbound, the second half westbound. Vehicle
+ * i is placed in lane i % numLanes and the vehicles of each lane are evenly
+ * spaced, so that numVehicles vehicles cover the whole highway. Each vehicle
+ * keeps its lane and a constant speed, and re-enters the highway from the
+ * opposite end when it reaches the end of it, so that the density is constant.
+ */
+class SIMULTE_API HighwayMobility : public inet::MovingMobilityBase
+{
+  protected:
+    double highwayX_;
+    double highwayLength_;
+    double speed_;
+    // +1 eastbound, -1 westbound
+    int direction_;
+    // position along the highway at time 0
+    double offset_;
+    double laneY_;
+
+    virtual void initialize(int stage) override;
+    virtual void setInitialPosition() override;
+    virtual void move() override;
+
+    // position along the highway at the current time, in [0, highwayLength)
+    double getHighwayPosition() const;
+
+  public:
+    HighwayMobility() {}
+
+    virtual double getMaxSpeed() const override { return speed_; }
+};
+
+#endif
@@ -0,0 +1,158 @@
+//
+//                           SimuLTE
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". This license can be also found at http://www.ltesimulator.com/
+// The above file and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#include "world/mobility/MobilityTrace.h"
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace omnetpp;
+
+MobilityTrace::MobilityTrace() :
+    data_(nullptr), size_(0), mapped_(false), header_(nullptr), time_(nullptr), rowBegin_(nullptr),
+    vehicle_(nullptr), x_(nullptr), y_(nullptr), speed_(nullptr), heading_(nullptr)
+{
+}
+
+MobilityTrace::~MobilityTrace()
+{
+    close();
+}
+
+void MobilityTrace::open(const std::string& fileName)
+{
+    close();
+
+#ifndef _WIN32
+    int fd = ::open(fileName.c_str(), O_RDONLY);
+    if (fd >= 0)
+    {
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size > 0)
+        {
+            void* addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr != MAP_FAILED)
+            {
+                data_ = (const char*)addr;
+                size_ = st.st_size;
+                mapped_ = true;
+            }
+        }
+        ::close(fd);
+    }
+#endif
+
+    if (data_ == nullptr)
+    {
+        // fall back to reading the whole file
+        std::ifstream in(fileName.c_str(), std::ios::binary);
+        if (!in)
+            throw cRuntimeError("MobilityTrace::open - cannot open file \"%s\"", fileName.c_str());
+        buffer_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        if (buffer_.empty())
+            throw cRuntimeError("MobilityTrace::open - file \"%s\" is empty", fileName.c_str());
+        data_ = &buffer_[0];
+        size_ = buffer_.size();
+    }
+
+    if (size_ < sizeof(MobilityTraceHeader) || memcmp(data_, MOBILITY_TRACE_MAGIC, 8) != 0)
+    {
+        close();
+        throw cRuntimeError("MobilityTrace::open - \"%s\" is not a mobility trace", fileName.c_str());
+    }
+    header_ = (const MobilityTraceHeader*)data_;
+
+    uint64_t steps = header_->numSteps;
+    uint64_t rows = header_->numRows;
+    uint64_t expected = sizeof(MobilityTraceHeader) + steps * sizeof(double) + (steps + 1) * sizeof(uint32_t)
+        + rows * (sizeof(uint32_t) + 4 * sizeof(float)) + header_->namesSize;
+    if (expected != size_)
+    {
+        close();
+        throw cRuntimeError("MobilityTrace::open - \"%s\" is truncated or corrupted (%lu bytes, %lu expected)",
+            fileName.c_str(), (unsigned long)size_, (unsigned long)expected);
+    }
+
+    const char* p = data_ + sizeof(MobilityTraceHeader);
+    time_ = (const double*)p;
+    p += steps * sizeof(double);
+    rowBegin_ = (const uint32_t*)p;
+    p += (steps + 1) * sizeof(uint32_t);
+    vehicle_ = (const uint32_t*)p;
+    p += rows * sizeof(uint32_t);
+    x_ = (const float*)p;
+    p += rows * sizeof(float);
+    y_ = (const float*)p;
+    p += rows * sizeof(float);
+    speed_ = (const float*)p;
+    p += rows * sizeof(float);
+    heading_ = (const float*)p;
+    p += rows * sizeof(float);
+
+    // index the name table
+    const char* end = p + header_->namesSize;
+    names_.reserve(header_->numVehicles);
+    while (p < end && names_.size() < header_->numVehicles)
+    {
+        const char* name = p;
+        while (p < end && *p != '\0')
+            ++p;
+        if (p == end)
+            break;
+        names_.push_back(name);
+        ++p;
+    }
+
+    // check the indices, so that the replay does not need to
+    std::string error;
+    if (names_.size() != header_->numVehicles)
+        error = "bad vehicle name table";
+    else if (rowBegin_[0] != 0 || rowBegin_[steps] != rows)
+        error = "bad step table";
+    for (unsigned int i = 0; error.empty() && i < steps; i++)
+    {
+        if (rowBegin_[i] > rowBegin_[i + 1] || (i > 0 && time_[i] <= time_[i - 1]))
+            error = "bad step table";
+    }
+    for (unsigned int i = 0; error.empty() && i < rows; i++)
+    {
+        if (vehicle_[i] >= header_->numVehicles)
+            error = "bad vehicle index";
+    }
+    if (!error.empty())
+    {
+        close();
+        throw cRuntimeError("MobilityTrace::open - \"%s\": %s", fileName.c_str(), error.c_str());
+    }
+}
+
+void MobilityTrace::close()
+{
+#ifndef _WIN32
+    if (mapped_)
+        munmap((void*)data_, size_);
+#endif
+    data_ = nullptr;
+    size_ = 0;
+    mapped_ = false;
+    std::vector<char>().swap(buffer_);
+    header_ = nullptr;
+    time_ = nullptr;
+    rowBegin_ = nullptr;
+    vehicle_ = nullptr;
+    x_ = y_ = speed_ = heading_ = nullptr;
+    names_.clear();
+}
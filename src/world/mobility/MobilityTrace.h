@@ -0,0 +1,106 @@
+//
+//                           SimuLTE
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". This license can be also found at http://www.ltesimulator.com/
+// The above file and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#ifndef _LTE_MOBILITYTRACE_H_
+#define _LTE_MOBILITYTRACE_H_
+
+#include <omnetpp.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include "common/LteCommon.h"
+
+#define MOBILITY_TRACE_MAGIC      "LTEMOB01"
+
+/**
+ * Fixed-size header of a binary mobility trace
+ */
+struct MobilityTraceHeader
+{
+    char magic[8];          //!< MOBILITY_TRACE_MAGIC
+    uint32_t numSteps;      //!< number of time steps
+    uint32_t numVehicles;   //!< number of distinct vehicles
+    uint32_t numRows;       //!< number of (step, vehicle) samples
+    uint32_t reserved;
+    uint64_t namesSize;     //!< size in bytes of the vehicle name table
+};
+
+/**
+ * Read-only view of a binary mobility trace, i.e. the position of every
+ * vehicle at every time step of a road traffic simulation.
+ *
+ * The file is written by src/world/mobility/fcd2trace.py from a SUMO FCD
+ * output and is mapped in memory (or read at once where mmap is not
+ * available). Samples are stored by columns and grouped by time step, so
+ * replaying a step is a linear scan of a contiguous range of rows.
+ *
+ * File layout (little endian, as produced by the host):
+ *   MobilityTraceHeader
+ *   double   time[numSteps]          time of each step (s)
+ *   uint32   rowBegin[numSteps + 1]  rows of step i are [rowBegin[i], rowBegin[i+1])
+ *   uint32   vehicle[numRows]        index of the vehicle in the name table
+ *   float    x[numRows], y[numRows]  position (m), OMNeT++ coordinates
+ *   float    speed[numRows]          speed (m/s)
+ *   float    heading[numRows]        heading (rad), 0 = east, counterclockwise
+ *   char     names[namesSize]        NUL-terminated vehicle identifiers
+ */
+class SIMULTE_API MobilityTrace
+{
+  private:
+    // whole file content
+    const char* data_;
+    size_t size_;
+    bool mapped_;
+    std::vector<char> buffer_;
+
+    const MobilityTraceHeader* header_;
+    const double* time_;
+    const uint32_t* rowBegin_;
+    const uint32_t* vehicle_;
+    const float* x_;
+    const float* y_;
+    const float* speed_;
+    const float* heading_;
+    std::vector<const char*> names_;
+
+    // disallow copy
+    MobilityTrace(const MobilityTrace&);
+    MobilityTrace& operator=(const MobilityTrace&);
+
+  public:
+    MobilityTrace();
+    ~MobilityTrace();
+
+    /**
+     * Opens and validates a trace file, closing the current one if any.
+     * Throws cRuntimeError if the file cannot be read or is malformed.
+     */
+    void open(const std::string& fileName);
+    void close();
+
+    bool isOpen() const { return data_ != nullptr; }
+
+    unsigned int getNumSteps() const { return header_->numSteps; }
+    unsigned int getNumVehicles() const { return header_->numVehicles; }
+    unsigned int getNumRows() const { return header_->numRows; }
+
+    double getStepTime(unsigned int step) const { return time_[step]; }
+    unsigned int getStepBegin(unsigned int step) const { return rowBegin_[step]; }
+    unsigned int getStepEnd(unsigned int step) const { return rowBegin_[step + 1]; }
+
+    unsigned int getVehicle(unsigned int row) const { return vehicle_[row]; }
+    double getX(unsigned int row) const { return x_[row]; }
+    double getY(unsigned int row) const { return y_[row]; }
+    double getSpeed(unsigned int row) const { return speed_[row]; }
+    double getHeading(unsigned int row) const { return heading_[row]; }
+
+    const char* getVehicleName(unsigned int vehicle) const { return names_[vehicle]; }
+};
+
+#endif
@@ -0,0 +1,46 @@
+//
+//                           SimuLTE
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". This license can be also found at http://www.ltesimulator.com/
+// The above file and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#include "world/mobility/TraceMobility.h"
+
+Define_Module(TraceMobility);
+
+using namespace omnetpp;
+
+void TraceMobility::initialize(int stage)
+{
+    MobilityBase::initialize(stage);
+    if (stage == inet::INITSTAGE_LOCAL)
+        lastAngularVelocity = inet::Quaternion::IDENTITY;
+}
+
+void TraceMobility::handleSelfMessage(cMessage* msg)
+{
+    throw cRuntimeError("TraceMobility::handleSelfMessage - unexpected message \"%s\"", msg->getName());
+}
+
+void TraceMobility::setState(const inet::Coord& position, double speed, double heading)
+{
+    lastPosition = position;
+    lastVelocity = inet::Coord(cos(heading), -sin(heading)) * speed;
+    lastOrientation = inet::Quaternion(inet::EulerAngles(inet::rad(-heading), inet::rad(0.0), inet::rad(0.0)));
+}
+
+void TraceMobility::preInitialize(const inet::Coord& position, double speed, double heading)
+{
+    Enter_Method_Silent();
+    setState(position, speed, heading);
+}
+
+void TraceMobility::nextPosition(const inet::Coord& position, double speed, double heading)
+{
+    Enter_Method_Silent();
+    setState(position, speed, heading);
+    emitMobilityStateChangedSignal();
+}
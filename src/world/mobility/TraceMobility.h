@@ -0,0 +1,56 @@
+//
+//                           SimuLTE
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". This license can be also found at http://www.ltesimulator.com/
+// The above file and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#ifndef _LTE_TRACEMOBILITY_H_
+#define _LTE_TRACEMOBILITY_H_
+
+#include "inet/mobility/base/MobilityBase.h"
+#include "common/LteCommon.h"
+
+/**
+ * Mobility of a vehicle replayed from a mobility trace.
+ *
+ * The module does not move by itself: the position, speed and heading are
+ * set by the TraceMobilityManager at every step of the trace and are kept
+ * constant between steps, as VeinsInetMobility does with TraCI updates.
+ * The heading is in radians, 0 = east, counterclockwise as seen on the map.
+ */
+class SIMULTE_API TraceMobility : public inet::MobilityBase
+{
+  protected:
+    inet::Coord lastVelocity;
+    inet::Quaternion lastAngularVelocity;
+
+    virtual void initialize(int stage) override;
+    virtual void handleSelfMessage(omnetpp::cMessage* msg) override;
+
+    // the initial state is the one given by preInitialize()
+    virtual void setInitialPosition() override {}
+    virtual void initializeOrientation() override {}
+
+    void setState(const inet::Coord& position, double speed, double heading);
+
+  public:
+    TraceMobility() {}
+
+    //! Sets the initial state, called by the manager before the module is initialized
+    virtual void preInitialize(const inet::Coord& position, double speed, double heading);
+    //! Sets the state at the current step of the trace
+    virtual void nextPosition(const inet::Coord& position, double speed, double heading);
+
+    virtual const inet::Coord& getCurrentPosition() override { return lastPosition; }
+    virtual const inet::Coord& getCurrentVelocity() override { return lastVelocity; }
+    virtual const inet::Coord& getCurrentAcceleration() override { return inet::Coord::ZERO; }
+
+    virtual const inet::Quaternion& getCurrentAngularPosition() override { return lastOrientation; }
+    virtual const inet::Quaternion& getCurrentAngularVelocity() override { return lastAngularVelocity; }
+    virtual const inet::Quaternion& getCurrentAngularAcceleration() override { return inet::Quaternion::IDENTITY; }
+};
+
+#endif
@@ -0,0 +1,161 @@
+//
+//                           SimuLTE
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". This license can be also found at http://www.ltesimulator.com/
+// The above file and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#include "world/mobility/TraceMobilityManager.h"
+#include "world/mobility/TraceMobility.h"
+#include <cstring>
+
+Define_Module(TraceMobilityManager);
+
+using namespace omnetpp;
+
+TraceMobilityManager::TraceMobilityManager()
+{
+    moduleType_ = nullptr;
+    step_ = 0;
+    stepTimer_ = nullptr;
+    nextModuleIndex_ = 0;
+}
+
+TraceMobilityManager::~TraceMobilityManager()
+{
+    cancelAndDelete(stepTimer_);
+}
+
+void TraceMobilityManager::initialize()
+{
+    moduleType_ = cModuleType::get(par("moduleType").stringValue());
+    moduleName_ = par("moduleName").stdstringValue();
+    moduleDisplayString_ = par("moduleDisplayString").stdstringValue();
+    timeOffset_ = par("timeOffset");
+
+    trace_.open(par("traceFile").stdstringValue());
+    EV << "TraceMobilityManager::initialize - trace " << par("traceFile").stdstringValue() << ": "
+       << trace_.getNumSteps() << " steps, " << trace_.getNumVehicles() << " vehicles" << endl;
+
+    unsigned int numVehicles = trace_.getNumVehicles();
+    hosts_.assign(numVehicles, nullptr);
+    mobility_.assign(numVehicles, nullptr);
+    lastSeen_.assign(numVehicles, -1);
+
+    stepTimer_ = new cMessage("traceStep");
+    if (trace_.getNumSteps() > 0)
+    {
+        simtime_t first = trace_.getStepTime(0) + timeOffset_;
+        scheduleAt(first > simTime() ? first : simTime(), stepTimer_);
+    }
+}
+
+void TraceMobilityManager::handleMessage(cMessage* msg)
+{
+    if (msg != stepTimer_)
+        throw cRuntimeError("TraceMobilityManager::handleMessage - unexpected message \"%s\"", msg->getName());
+
+    replayStep(step_);
+
+    if (++step_ < trace_.getNumSteps())
+    {
+        simtime_t next = trace_.getStepTime(step_) + timeOffset_;
+        scheduleAt(next > simTime() ? next : simTime(), stepTimer_);
+    }
+    else
+    {
+        // end of the trace: remove the remaining vehicles, as SUMO does when the simulation ends
+        for (unsigned int i = 0; i < active_.size(); i++)
+            deleteHost(active_[i]);
+        active_.clear();
+    }
+}
+
+void TraceMobilityManager::replayStep(unsigned int step)
+{
+    unsigned int begin = trace_.getStepBegin(step);
+    unsigned int end = trace_.getStepEnd(step);
+
+    // mark the vehicles of this step
+    for (unsigned int row = begin; row < end; row++)
+    {
+        unsigned int vehicle = trace_.getVehicle(row);
+        if (lastSeen_[vehicle] == (int)step)
+            throw cRuntimeError("TraceMobilityManager::replayStep - vehicle %s appears twice at time %g",
+                trace_.getVehicleName(vehicle), trace_.getStepTime(step));
+        lastSeen_[vehicle] = step;
+    }
+
+    // delete the vehicles that left the trace, keeping the creation order of the others
+    unsigned int n = 0;
+    for (unsigned int i = 0; i < active_.size(); i++)
+    {
+        unsigned int vehicle = active_[i];
+        if (lastSeen_[vehicle] == (int)step)
+            active_[n++] = vehicle;
+        else
+            deleteHost(vehicle);
+    }
+    active_.resize(n);
+
+    // move the remaining vehicles and create the new ones
+    for (unsigned int row = begin; row < end; row++)
+    {
+        unsigned int vehicle = trace_.getVehicle(row);
+        if (hosts_[vehicle] == nullptr)
+            addHost(vehicle, row);
+        else
+            mobility_[vehicle]->nextPosition(inet::Coord(trace_.getX(row), trace_.getY(row)), trace_.getSpeed(row), trace_.getHeading(row));
+    }
+}
+
+void TraceMobilityManager::addHost(unsigned int vehicle, unsigned int row)
+{
+    int index = nextModuleIndex_++;
+    EV << "TraceMobilityManager::addHost - creating " << moduleName_ << "[" << index << "] for vehicle "
+       << trace_.getVehicleName(vehicle) << endl;
+
+    cModule* mod = moduleType_->create(moduleName_.c_str(), getParentModule(), index + 1, index);
+    mod->finalizeParameters();
+    if (!moduleDisplayString_.empty())
+        mod->getDisplayString().parse(moduleDisplayString_.c_str());
+    mod->buildInside();
+    mod->scheduleStart(simTime());
+
+    TraceMobility* mobility = nullptr;
+    for (cModule::SubmoduleIterator it(mod); !it.end() && mobility == nullptr; ++it)
+        mobility = dynamic_cast<TraceMobility*>(*it);
+    if (mobility == nullptr)
+        throw cRuntimeError("TraceMobilityManager::addHost - module %s has no TraceMobility submodule", mod->getFullPath().c_str());
+
+    mobility->preInitialize(inet::Coord(trace_.getX(row), trace_.getY(row)), trace_.getSpeed(row), trace_.getHeading(row));
+    mod->callInitialize();
+
+    hosts_[vehicle] = mod;
+    mobility_[vehicle] = mobility;
+    active_.push_back(vehicle);
+}
+
+void TraceMobilityManager::deleteHost(unsigned int vehicle)
+{
+    cModule* mod = hosts_[vehicle];
+    EV << "TraceMobilityManager::deleteHost - deleting " << mod->getFullName() << " (vehicle "
+       << trace_.getVehicleName(vehicle) << ")" << endl;
+
+    hosts_[vehicle] = nullptr;
+    mobility_[vehicle] = nullptr;
+    mod->callFinish();
+    mod->deleteModule();
+}
+
+cModule* TraceMobilityManager::getHost(const char* name) const
+{
+    for (unsigned int i = 0; i < active_.size(); i++)
+    {
+        if (strcmp(trace_.getVehicleName(active_[i]), name) == 0)
+            return hosts_[active_[i]];
+    }
+    return nullptr;
+}
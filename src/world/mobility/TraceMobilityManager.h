@@ -0,0 +1,71 @@
+//
+//                           SimuLTE
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". This license can be also found at http://www.ltesimulator.com/
+// The above file and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#ifndef _LTE_TRACEMOBILITYMANAGER_H_
+#define _LTE_TRACEMOBILITYMANAGER_H_
+
+#include <omnetpp.h>
+#include "common/LteCommon.h"
+#include "world/mobility/MobilityTrace.h"
+
+class TraceMobility;
+
+/**
+ * Replays a mobility trace (see MobilityTrace) in place of a TraCI connection.
+ *
+ * At every step of the trace, vehicles entering the trace are created as
+ * submodules of the parent module, vehicles that left it are deleted and the
+ * others are moved, in the same way the veins scenario manager does when it
+ * receives the subscription results of a step from SUMO. Vehicles must use
+ * TraceMobility as mobility module.
+ */
+class SIMULTE_API TraceMobilityManager : public omnetpp::cSimpleModule
+{
+  protected:
+    MobilityTrace trace_;
+
+    omnetpp::cModuleType* moduleType_;
+    std::string moduleName_;
+    std::string moduleDisplayString_;
+    omnetpp::simtime_t timeOffset_;
+
+    // next step to replay
+    unsigned int step_;
+    omnetpp::cMessage* stepTimer_;
+
+    // module of each vehicle of the trace, nullptr if it is not in the simulation
+    std::vector<omnetpp::cModule*> hosts_;
+    // mobility module of each vehicle of the trace
+    std::vector<TraceMobility*> mobility_;
+    // last step each vehicle of the trace was seen
+    std::vector<int> lastSeen_;
+    // vehicles currently in the simulation, in order of creation
+    std::vector<unsigned int> active_;
+
+    // vector index of the next created module
+    int nextModuleIndex_;
+
+    virtual void initialize();
+    virtual void handleMessage(omnetpp::cMessage* msg);
+
+    void replayStep(unsigned int step);
+    void addHost(unsigned int vehicle, unsigned int row);
+    void deleteHost(unsigned int vehicle);
+
+  public:
+    TraceMobilityManager();
+    virtual ~TraceMobilityManager();
+
+    //! Number of vehicles currently in the simulation
+    unsigned int getNumHosts() const { return active_.size(); }
+    //! Module of the vehicle with the given trace identifier, nullptr if it is not in the simulation
+    omnetpp::cModule* getHost(const char* name) const;
+};
+
+#endif
@@ -0,0 +1,110 @@
+#!/usr/bin/env python3
+#
+#                           SimuLTE
+#
+# This file is part of a software released under the license included in file
+# "license.pdf". This license can be also found at http://www.ltesimulator.com/
+# The above file and the present reference are part of the software itself,
+# and cannot be removed from it.
+#
+# Converts a SUMO FCD output (sumo --fcd-output) into the binary mobility
+# trace replayed by TraceMobilityManager (see MobilityTrace.h).
+#
+# usage: fcd2trace.py [-o OUT] [-n NET] [--margin M] [--begin T] [--end T] fcd.xml
+#
+# Positions are converted to OMNeT++ coordinates as veins does: the y axis is
+# flipped and the network boundary is moved to (margin, margin). The boundary
+# is read from the SUMO network (-n), or else taken from the trace itself.
+# Angles are converted to headings in radians (0 = east, counterclockwise).
+#
+
+import argparse
+import math
+import struct
+import sys
+import xml.etree.ElementTree as ET
+from array import array
+
+MAGIC = b"LTEMOB01"
+
+
+def read_boundary(net):
+    """Return (xmin, ymin, xmax, ymax) of the location element of a SUMO network."""
+    for _, elem in ET.iterparse(net):
+        if elem.tag == "location":
+            return tuple(float(v) for v in elem.get("convBoundary").split(","))
+    raise ValueError("%s: no location element" % net)
+
+
+def read_fcd(path, begin, end):
+    """Return (times, rowBegin, vehicleIds, vehicle, x, y, speed, angle) of an FCD file."""
+    times = array("d")
+    row_begin = array("I", [0])
+    ids = {}
+    vehicle = array("I")
+    x = array("d")
+    y = array("d")
+    speed = array("f")
+    angle = array("f")
+    for _, elem in ET.iterparse(path):
+        if elem.tag != "timestep":
+            continue
+        t = float(elem.get("time"))
+        if t >= begin and (end is None or t <= end):
+            if times and t <= times[-1]:
+                raise ValueError("%s: time steps are not increasing at %g" % (path, t))
+            times.append(t)
+            for v in elem.iter("vehicle"):
+                vehicle.append(ids.setdefault(v.get("id"), len(ids)))
+                x.append(float(v.get("x")))
+                y.append(float(v.get("y")))
+                speed.append(float(v.get("speed", "0")))
+                angle.append(float(v.get("angle", "0")))
+            row_begin.append(len(vehicle))
+        elem.clear()
+    names = sorted(ids, key=ids.get)
+    return times, row_begin, names, vehicle, x, y, speed, angle
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert SUMO FCD output to a binary mobility trace")
+    parser.add_argument("input")
+    parser.add_argument("-o", "--output", help="output file (default: input with .trace extension)")
+    parser.add_argument("-n", "--net", help="SUMO network, used for the coordinate conversion")
+    parser.add_argument("--margin", type=float, default=25.0, help="margin around the network (m), as in veins")
+    parser.add_argument("--begin", type=float, default=0.0, help="skip the steps before this time (s)")
+    parser.add_argument("--end", type=float, help="skip the steps after this time (s)")
+    args = parser.parse_args()
+
+    times, row_begin, names, vehicle, x, y, speed, angle = read_fcd(args.input, args.begin, args.end)
+
+    if args.net:
+        xmin, ymin, xmax, ymax = read_boundary(args.net)
+    elif x:
+        xmin, ymin, xmax, ymax = min(x), min(y), max(x), max(y)
+    else:
+        xmin = ymin = xmax = ymax = 0.0
+
+    ox = array("f", (v - xmin + args.margin for v in x))
+    oy = array("f", (ymax - v + args.margin for v in y))
+    heading = array("f", (math.radians(90.0 - a) for a in angle))
+
+    names_blob = b"".join(n.encode() + b"\0" for n in names)
+    arrays = [times, row_begin, vehicle, ox, oy, speed, heading]
+    if sys.byteorder != "little":
+        for a in arrays:
+            a.byteswap()
+
+    out = args.output or args.input.rsplit(".xml", 1)[0] + ".trace"
+    with open(out, "wb") as f:
+        f.write(MAGIC)
+        f.write(struct.pack("<IIIIQ", len(times), len(names), len(vehicle), 0, len(names_blob)))
+        for a in arrays:
+            a.tofile(f)
+        f.write(names_blob)
+
+    print("%s: %d steps, %d vehicles, %d samples" % (out, len(times), len(names), len(vehicle)))
+
+
+if __name__ == "__main__":
+    main()
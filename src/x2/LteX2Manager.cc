@@ -15,6 +15,7 @@
 #include <inet/networklayer/ipv4/Ipv4InterfaceData.h>
 
 #include "x2/LteX2Manager.h"
+#include "common/LteProfiler.h"
 
 Define_Module(LteX2Manager);
 
@@ -73,6 +74,7 @@ void LteX2Manager::initialize(int stage)
 
 void LteX2Manager::handleMessage(cMessage *msg)
 {
+    LTE_PROFILE_SCOPE(this, "handleMessage");
     Packet* pkt = check_and_cast<Packet*>(msg);
     cGate* incoming = pkt->getArrivalGate();
 
@@ -119,13 +121,17 @@ void LteX2Manager::fromStack(Packet* pkt)
     // (GTPUserX2 module will tunnel this datagram towards the target eNB)
     // otherwise it is a X2 control message and sent to the x2 peer
 
-    DestinationIdList destList = x2Info->getDestIdList();
-    DestinationIdList::iterator it = destList.begin();
+    // only the last destination gets the original packet. The other ones get a
+    // copy, whose X2 message shares the list of IEs with the original one
+    LteX2MessageType msgType = x2msg->getType();
+    const DestinationIdList& destList = x2Info->getDestIdList();
+    DestinationIdList::const_iterator it = destList.begin();
 
     for (; it != destList.end(); ++it)
     {
         X2NodeId targetEnb = *it;
-        auto pktDuplicate = pkt->dup();
+        bool last = (std::next(it) == destList.end());
+        auto pktDuplicate = last ? pkt : pkt->dup();
         auto updatedX2Msg = pktDuplicate->removeAtFront<LteX2Message>();
         updatedX2Msg->markMutableIfExclusivelyOwned();
         updatedX2Msg->setSourceId(nodeId_);
@@ -133,7 +139,7 @@ void LteX2Manager::fromStack(Packet* pkt)
         pktDuplicate->insertAtFront(updatedX2Msg);
 
         cGate* outputGate;
-        if(x2msg->getType() == X2_HANDOVER_DATA_MSG){
+        if(msgType == X2_HANDOVER_DATA_MSG){
             // send to the gate connected to the GTPUser module
             outputGate = gate("x2Gtp$o");
         } else {
@@ -143,8 +149,8 @@ void LteX2Manager::fromStack(Packet* pkt)
         }
         send(pktDuplicate, outputGate);
     }
-    //delete x2Info;
-    delete pkt;
+    if (destList.empty())
+        delete pkt;
 }
 
 void LteX2Manager::fromX2(Packet* pkt)
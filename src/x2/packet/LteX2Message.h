@@ -10,6 +10,7 @@
 #ifndef _LTE_LTEX2MESSAGE_H_
 #define _LTE_LTEX2MESSAGE_H_
 
+#include <memory>
 #include "x2/packet/LteX2Message_m.h"
 #include "common/LteCommon.h"
 #include "x2/packet/X2InformationElement.h"
@@ -28,6 +29,10 @@ enum LteX2MessageType
  * in msg declaration: adds the Information Elements list
  *
  * Create new X2 Messages by deriving this class
+ *
+ * The IE list is shared by the copies of a message (e.g. the ones sent
+ * to each destination of a multicast X2 message) and copied only
+ * when one of them is modified by pushIe() or popIe()
  */
 class SIMULTE_API LteX2Message : public LteX2Message_Base
 {
@@ -36,8 +41,8 @@ class SIMULTE_API LteX2Message : public LteX2Message_Base
     /// type of the X2 message
     LteX2MessageType type_;
 
-    /// List of X2 IEs
-    X2InformationElementsList ieList_;
+    /// List of X2 IEs, shared with the copies of this message
+    std::shared_ptr<X2InformationElementsList> ieList_;
 
     /// Size of the X2 message
     int64_t msgLength_;
@@ -50,14 +55,13 @@ class SIMULTE_API LteX2Message : public LteX2Message_Base
     LteX2Message() : LteX2Message_Base()
     {
         type_ = X2_UNKNOWN_MSG;
-        ieList_.clear();
+        ieList_ = newIeList();
         msgLength_ = 0;
     }
 
     /*
      * Copy constructors
-     * FIXME Copy constructors do not preserve ownership
-     * Here I should iterate on the list and set all ownerships
+     * The IE list is shared with the original message
      */
 
 
@@ -68,12 +72,9 @@ class SIMULTE_API LteX2Message : public LteX2Message_Base
         LteX2Message_Base::operator=(other);
         type_ = other.type_;
 
-        // perform deep-copy of element list
+        // the element list is copied on write
         msgLength_ = other.msgLength_;
-        ieList_.clear();
-        for (auto it = other.ieList_.begin(); it != other.ieList_.end(); ++it){
-            ieList_.push_back((*it)->dup());
-        }
+        ieList_ = other.ieList_;
 
         return *this;
     }
@@ -90,10 +91,7 @@ class SIMULTE_API LteX2Message : public LteX2Message_Base
 
     virtual ~LteX2Message()
     {
-        while (!ieList_.empty()){
-            delete ieList_.front();
-            ieList_.pop_front();
-        }
+        // the IEs are deleted with the last copy of the list
     }
 
     // getter/setter methods for the type field
@@ -103,8 +101,8 @@ class SIMULTE_API LteX2Message : public LteX2Message_Base
     /**
      * Getter to access the InformationElement list (e.g. for serialization)
      */
-    virtual X2InformationElementsList getIeList() const {
-        return ieList_;
+    virtual const X2InformationElementsList& getIeList() const {
+        return *ieList_;
     }
 
     /**
@@ -115,7 +113,8 @@ class SIMULTE_API LteX2Message : public LteX2Message_Base
      */
     virtual void pushIe(X2InformationElement* ie)
     {
-        ieList_.push_back(ie);
+        makeIeListExclusive();
+        ieList_->push_back(ie);
         msgLength_ += ie->getLength();
         // increase the chunk length by length of IE + 1 Byte (required to store the IE type)
         setChunkLength(getChunkLength()+inet::b(8*(ie->getLength()+sizeof(uint8_t))));
@@ -130,8 +129,9 @@ class SIMULTE_API LteX2Message : public LteX2Message_Base
      */
     virtual X2InformationElement* popIe()
     {
-        X2InformationElement* ie = ieList_.front();
-        ieList_.pop_front();
+        makeIeListExclusive();
+        X2InformationElement* ie = ieList_->front();
+        ieList_->pop_front();
         msgLength_ -= ie->getLength();
         // chunk is immutable during serialization! 
         // (chunk length can therefore not be adapted - we only adapt the separate msg_Length_)
@@ -146,7 +146,7 @@ class SIMULTE_API LteX2Message : public LteX2Message_Base
      */
     virtual bool hasIe() const
     {
-        return (!ieList_.empty());
+        return (!ieList_->empty());
     }
 
     int64_t getByteLength() const
@@ -158,6 +158,36 @@ class SIMULTE_API LteX2Message : public LteX2Message_Base
     {
         return (getByteLength() * 8);
     }
+
+  protected:
+
+    /**
+     * newIeList() creates an empty IE list, which deletes
+     * its IEs when the last message referring to it is deleted
+     */
+    static std::shared_ptr<X2InformationElementsList> newIeList()
+    {
+        return std::shared_ptr<X2InformationElementsList>(new X2InformationElementsList(),
+            [](X2InformationElementsList* list) {
+                for (auto it = list->begin(); it != list->end(); ++it)
+                    delete *it;
+                delete list;
+            });
+    }
+
+    /**
+     * makeIeListExclusive() performs the deep-copy of the IE list
+     * before it is modified, if it is shared with other messages
+     */
+    void makeIeListExclusive()
+    {
+        if (ieList_.use_count() <= 1)
+            return;
+        std::shared_ptr<X2InformationElementsList> list = newIeList();
+        for (auto it = ieList_->begin(); it != ieList_->end(); ++it)
+            list->push_back((*it)->dup());
+        ieList_ = list;
+    }
 };
 
 Register_Class(LteX2Message);
@@ -50,9 +50,9 @@ void LteX2MsgSerializer::serialize(MemoryOutputStream& stream, const Ptr<const C
     // note: length does not need to be serialized - is calculated during deserialization
 
     // serialization of list containing the information elements
-    X2InformationElementsList ieList = msg->getIeList();
+    const X2InformationElementsList& ieList = msg->getIeList();
     stream.writeUint16Be(ieList.size());
-    for(X2InformationElementsList::iterator it = ieList.begin(); it !=ieList.end(); it++){
+    for(X2InformationElementsList::const_iterator it = ieList.begin(); it !=ieList.end(); it++){
         X2InformationElement* ie = *it;
         stream.writeByte(ie->getType());
 